@@ -390,6 +390,8 @@ void App::applyCommandLineOptions(const CommandLineParser::Options& options, fra
     notationConfiguration()->setTemplateModeEnabled(options.notation.templateModeEnabled);
     notationConfiguration()->setTestModeEnabled(options.notation.testModeEnabled);
 
+    diagnosticsConfiguration()->setLayoutProfileOutputPath(options.diagnostics.layoutProfilePath);
+
     if (runMode == framework::IApplication::RunMode::ConsoleApp) {
         project::MigrationOptions migration;
         migration.appVersion = mu::engraving::Constants::MSC_VERSION;
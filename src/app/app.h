@@ -30,6 +30,7 @@
 #include "global/iapplication.h"
 #include "converter/iconvertercontroller.h"
 #include "diagnostics/idiagnosticdrawprovider.h"
+#include "diagnostics/idiagnosticsconfiguration.h"
 #include "autobot/iautobot.h"
 #include "audio/iregisteraudiopluginsscenario.h"
 #include "multiinstances/imultiinstancesprovider.h"
@@ -53,6 +54,7 @@ class App
     INJECT(framework::IApplication, muapplication)
     INJECT(converter::IConverterController, converter)
     INJECT(diagnostics::IDiagnosticDrawProvider, diagnosticDrawProvider)
+    INJECT(diagnostics::IDiagnosticsConfiguration, diagnosticsConfiguration)
     INJECT(autobot::IAutobot, autobot)
     INJECT(audio::IRegisterAudioPluginsScenario, registerAudioPluginsScenario)
     INJECT(mi::IMultiInstancesProvider, multiInstancesProvider)
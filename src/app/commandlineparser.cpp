@@ -132,6 +132,8 @@ void CommandLineParser::init()
     m_parser.addOption(QCommandLineOption("diagnostic-com-drawdata", "Compare engraving draw data"));
     m_parser.addOption(QCommandLineOption("diagnostic-drawdata-to-png", "Convert draw data to png", "file"));
     m_parser.addOption(QCommandLineOption("diagnostic-drawdiff-to-png", "Convert draw diff to png"));
+    m_parser.addOption(QCommandLineOption("layout-profile", "Profile the layout and write the timings to the given json file on exit",
+                                          "file"));
 
     // Autobot
     m_parser.addOption(QCommandLineOption("test-case", "Run test case by name or file", "nameOrFile"));
@@ -438,6 +440,10 @@ void CommandLineParser::parse(int argc, char** argv)
         m_diagnostic.input = scorefiles;
     }
 
+    if (m_parser.isSet("layout-profile")) {
+        m_options.diagnostics.layoutProfilePath = fromUserInputPath(m_parser.value("layout-profile"));
+    }
+
     // Autobot
     if (m_parser.isSet("test-case")) {
         m_runMode = IApplication::RunMode::ConsoleApp;
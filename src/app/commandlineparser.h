@@ -80,6 +80,10 @@ public:
             std::optional<bool> experimental;
         } guitarPro;
 
+        struct {
+            std::optional<io::path_t> layoutProfilePath;
+        } diagnostics;
+
         struct {
             std::optional<bool> revertToFactorySettings;
             std::optional<mu::logger::Level> loggerLevel;
@@ -347,6 +347,9 @@ MenuItem* AppMenuModel::makeDiagnosticMenu()
     MenuItemList systemItems {
         makeMenuItem("diagnostic-show-paths"),
         makeMenuItem("diagnostic-show-profiler"),
+        makeSeparator(),
+        makeMenuItem("diagnostic-toggle-layout-profiler"),
+        makeMenuItem("diagnostic-save-layout-profile"),
     };
 
     MenuItemList items {
@@ -770,9 +770,7 @@ void BackendApi::renderExcerptsContents(IMasterNotationPtr masterNotation)
     //!       Let's layout all the scores of the excerpts
     for (IExcerptNotationPtr excerpt : masterNotation->excerpts()) {
         Score* score = excerpt->notation()->elements()->msScore();
-        if (!score->autoLayoutEnabled()) {
-            score->doLayout();
-        }
+        score->layoutIfNeeded();
     }
 }
 
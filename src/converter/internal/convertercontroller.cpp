@@ -188,28 +188,30 @@ mu::Ret ConverterController::convertPageByPage(INotationWriterPtr writer, INotat
 {
     TRACEFUNC;
 
-    for (size_t i = 0; i < notation->elements()->pages().size(); i++) {
+    //! NOTE The writer may render the pages concurrently, they are passed here in order
+    auto writePage = [&out](size_t pageIndex, const QByteArray& data) -> Ret {
         const QString filePath
-            = io::path_t(io::dirpath(out) + "/" + io::completeBasename(out) + "-%1." + io::suffix(out)).toQString().arg(i + 1);
+            = io::path_t(io::dirpath(out) + "/" + io::completeBasename(out) + "-%1." + io::suffix(out)).toQString().arg(pageIndex + 1);
 
         QFile file(filePath);
         if (!file.open(QFile::WriteOnly)) {
             return make_ret(Err::OutFileFailedOpen);
         }
 
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-        };
-
-        file.setProperty("path", out.toQString());
-
-        Ret ret = writer->write(notation, file, options);
-        if (!ret) {
-            LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        if (file.write(data) != data.size()) {
+            LOGE() << "failed write, path: " << filePath;
             return make_ret(Err::OutFileFailedWrite);
         }
 
         file.close();
+
+        return make_ret(Ret::Code::Ok);
+    };
+
+    Ret ret = writer->writePages(notation, writePage);
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return ret.code() == static_cast<int>(Err::OutFileFailedOpen) ? ret : make_ret(Err::OutFileFailedWrite);
     }
 
     return make_ret(Ret::Code::Ok);
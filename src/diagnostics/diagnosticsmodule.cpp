@@ -32,6 +32,7 @@
 #include "internal/diagnosticsactions.h"
 #include "internal/diagnosticsactionscontroller.h"
 #include "internal/diagnosticspathsregister.h"
+#include "internal/diagnosticfileswriter.h"
 #include "internal/engravingelementsprovider.h"
 #include "internal/savediagnosticfilesscenario.h"
 
@@ -69,6 +70,7 @@ void DiagnosticsModule::registerExports()
 {
     m_configuration = std::make_shared<DiagnosticsConfiguration>();
     m_actionsController = std::make_shared<DiagnosticsActionsController>();
+    m_actions = std::make_shared<DiagnosticsActions>();
 
     ioc()->registerExport<IDiagnosticsPathsRegister>(moduleName(), new DiagnosticsPathsRegister());
     ioc()->registerExport<IEngravingElementsProvider>(moduleName(), new EngravingElementsProvider());
@@ -90,7 +92,7 @@ void DiagnosticsModule::resolveImports()
 
     auto ar = ioc()->resolve<ui::IUiActionsRegister>(moduleName());
     if (ar) {
-        ar->reg(std::make_shared<DiagnosticsActions>());
+        ar->reg(m_actions);
     }
 }
 
@@ -121,6 +123,7 @@ void DiagnosticsModule::onInit(const framework::IApplication::RunMode& mode)
 
     m_configuration->init();
     m_actionsController->init();
+    m_actions->init();
 
     auto globalConf = modularity::ioc()->resolve<framework::IGlobalConfiguration>(moduleName());
     IF_ASSERT_FAILED(globalConf) {
@@ -160,3 +163,16 @@ void DiagnosticsModule::onInit(const framework::IApplication::RunMode& mode)
     LOGW() << "crash handling disabled";
 #endif // MUE_BUILD_CRASHPAD_CLIENT
 }
+
+void DiagnosticsModule::onDeinit()
+{
+    io::path_t layoutProfilePath = m_configuration->layoutProfileOutputPath();
+    if (layoutProfilePath.empty()) {
+        return;
+    }
+
+    Ret ret = DiagnosticFilesWriter::writeLayoutProfile(layoutProfilePath);
+    if (!ret) {
+        LOGE() << "failed write layout profile: " << ret.toString();
+    }
+}
@@ -32,6 +32,7 @@
 namespace mu::diagnostics {
 class DiagnosticsConfiguration;
 class DiagnosticsActionsController;
+class DiagnosticsActions;
 class DiagnosticsModule : public modularity::IModuleSetup
 {
     INJECT(io::IFileSystem, fileSystem)
@@ -42,10 +43,12 @@ public:
     void resolveImports() override;
     void registerUiTypes() override;
     void onInit(const framework::IApplication::RunMode& mode) override;
+    void onDeinit() override;
 
 private:
     std::shared_ptr<DiagnosticsConfiguration> m_configuration;
     std::shared_ptr<DiagnosticsActionsController> m_actionsController;
+    std::shared_ptr<DiagnosticsActions> m_actions;
 };
 }
 
@@ -22,9 +22,12 @@
 #ifndef MU_DIAGNOSTICS_IDIAGNOSTICSCONFIGURATION_H
 #define MU_DIAGNOSTICS_IDIAGNOSTICSCONFIGURATION_H
 
+#include <optional>
+
 #include "modularity/imoduleinterface.h"
 
 #include "io/path.h"
+#include "async/notification.h"
 
 namespace mu::diagnostics {
 class IDiagnosticsConfiguration : MODULE_EXPORT_INTERFACE
@@ -39,6 +42,14 @@ public:
     virtual void setShouldWarnBeforeSavingDiagnosticFiles(bool val) = 0;
 
     virtual io::path_t diagnosticFilesDefaultSavingPath() const = 0;
+
+    virtual bool isLayoutProfilerEnabled() const = 0;
+    virtual void setIsLayoutProfilerEnabled(bool val) = 0;
+    virtual async::Notification isLayoutProfilerEnabledChanged() const = 0;
+
+    //! NOTE Set from the command line, the layout profile is written there on exit
+    virtual io::path_t layoutProfileOutputPath() const = 0;
+    virtual void setLayoutProfileOutputPath(const std::optional<io::path_t>& path) = 0;
 };
 }
 
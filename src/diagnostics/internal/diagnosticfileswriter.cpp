@@ -23,6 +23,7 @@
 #include "diagnosticfileswriter.h"
 
 #include "serialization/zipwriter.h"
+#include "io/file.h"
 #include "containers.h"
 
 #include "log.h"
@@ -73,6 +74,13 @@ mu::Ret DiagnosticFilesWriter::writeDiagnosticFiles(const path_t& destinationPat
     return make_ok();
 }
 
+mu::Ret DiagnosticFilesWriter::writeLayoutProfile(const path_t& destinationPath)
+{
+    TRACEFUNC;
+
+    return File::writeFile(destinationPath, layoutProfiler()->toJson());
+}
+
 mu::RetVal<mu::io::paths_t> DiagnosticFilesWriter::scanDir(const std::string& dirName)
 {
     RetVal<io::paths_t> paths = fileSystem()->scanFiles(globalConfiguration()->userAppDataPath() + "/" + dirName,
@@ -25,6 +25,7 @@
 #include "modularity/ioc.h"
 #include "io/ifilesystem.h"
 #include "global/iglobalconfiguration.h"
+#include "engraving/rendering/ilayoutprofiler.h"
 
 #include "types/ret.h"
 #include "io/path.h"
@@ -38,9 +39,11 @@ class DiagnosticFilesWriter
 {
     INJECT_STATIC(io::IFileSystem, fileSystem)
     INJECT_STATIC(framework::IGlobalConfiguration, globalConfiguration)
+    INJECT_STATIC(engraving::rendering::ILayoutProfiler, layoutProfiler)
 
 public:
     static Ret writeDiagnosticFiles(const io::path_t& destinationZipPath);
+    static Ret writeLayoutProfile(const io::path_t& destinationPath);
 
 private:
     static RetVal<io::paths_t> scanDir(const std::string& dirName);
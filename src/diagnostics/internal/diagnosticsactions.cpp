@@ -28,6 +28,8 @@ using namespace mu::ui;
 using namespace mu::actions;
 using namespace mu::diagnostics;
 
+static const ActionCode TOGGLE_LAYOUT_PROFILER_CODE("diagnostic-toggle-layout-profiler");
+
 const UiActionList DiagnosticsActions::m_actions = {
     UiAction("diagnostic-save-diagnostic-files",
              mu::context::UiCtxAny,
@@ -44,6 +46,17 @@ const UiActionList DiagnosticsActions::m_actions = {
              mu::context::CTX_ANY,
              TranslatableString("action", "Show pr&ofiler…")
              ),
+    UiAction(TOGGLE_LAYOUT_PROFILER_CODE,
+             mu::context::UiCtxAny,
+             mu::context::CTX_ANY,
+             TranslatableString("action", "&Layout profiler"),
+             Checkable::Yes
+             ),
+    UiAction("diagnostic-save-layout-profile",
+             mu::context::UiCtxAny,
+             mu::context::CTX_ANY,
+             TranslatableString("action", "Save la&yout profile…")
+             ),
     UiAction("diagnostic-show-navigation-tree",
              mu::context::UiCtxAny,
              mu::context::CTX_ANY,
@@ -66,6 +79,13 @@ const UiActionList DiagnosticsActions::m_actions = {
              )
 };
 
+void DiagnosticsActions::init()
+{
+    configuration()->isLayoutProfilerEnabledChanged().onNotify(this, [this]() {
+        m_actionCheckedChanged.send({ TOGGLE_LAYOUT_PROFILER_CODE });
+    });
+}
+
 const UiActionList& DiagnosticsActions::actionsList() const
 {
     return m_actions;
@@ -82,13 +102,16 @@ mu::async::Channel<ActionCodeList> DiagnosticsActions::actionEnabledChanged() co
     return ch;
 }
 
-bool DiagnosticsActions::actionChecked(const UiAction&) const
+bool DiagnosticsActions::actionChecked(const UiAction& act) const
 {
+    if (act.code == TOGGLE_LAYOUT_PROFILER_CODE) {
+        return configuration()->isLayoutProfilerEnabled();
+    }
+
     return false;
 }
 
 mu::async::Channel<ActionCodeList> DiagnosticsActions::actionCheckedChanged() const
 {
-    static async::Channel<ActionCodeList> ch;
-    return ch;
+    return m_actionCheckedChanged;
 }
@@ -23,13 +23,21 @@
 #define MU_DIAGNOSTICS_DIAGNOSTICSACTIONS_H
 
 #include "ui/iuiactionsmodule.h"
+#include "async/asyncable.h"
+
+#include "modularity/ioc.h"
+#include "idiagnosticsconfiguration.h"
 
 namespace mu::diagnostics {
-class DiagnosticsActions : public ui::IUiActionsModule
+class DiagnosticsActions : public ui::IUiActionsModule, public async::Asyncable
 {
+    INJECT(IDiagnosticsConfiguration, configuration)
+
 public:
     DiagnosticsActions() = default;
 
+    void init();
+
     const ui::UiActionList& actionsList() const override;
     bool actionEnabled(const ui::UiAction& act) const override;
     async::Channel<actions::ActionCodeList> actionEnabledChanged() const override;
@@ -39,6 +47,8 @@ public:
 
 private:
     static const ui::UiActionList m_actions;
+
+    async::Channel<actions::ActionCodeList> m_actionCheckedChanged;
 };
 }
 
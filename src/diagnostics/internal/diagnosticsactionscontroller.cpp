@@ -25,6 +25,9 @@
 
 #include "view/diagnosticaccessiblemodel.h"
 
+#include "diagnosticfileswriter.h"
+#include "translation.h"
+
 #include "log.h"
 
 using namespace mu::diagnostics;
@@ -46,6 +49,8 @@ void DiagnosticsActionsController::init()
     dispatcher()->reg(this, "diagnostic-accessible-tree-dump", []() { DiagnosticAccessibleModel::dumpTree(); });
     dispatcher()->reg(this, "diagnostic-show-engraving-elements", [this]() { openUri(ENGRAVING_ELEMENTS_URI, false); });
     dispatcher()->reg(this, "diagnostic-save-diagnostic-files", this, &DiagnosticsActionsController::saveDiagnosticFiles);
+    dispatcher()->reg(this, "diagnostic-toggle-layout-profiler", this, &DiagnosticsActionsController::toggleLayoutProfiler);
+    dispatcher()->reg(this, "diagnostic-save-layout-profile", this, &DiagnosticsActionsController::saveLayoutProfile);
 }
 
 void DiagnosticsActionsController::openUri(const mu::UriQuery& uri, bool isSingle)
@@ -64,3 +69,25 @@ void DiagnosticsActionsController::saveDiagnosticFiles()
         LOGE() << ret.toString();
     }
 }
+
+void DiagnosticsActionsController::toggleLayoutProfiler()
+{
+    configuration()->setIsLayoutProfilerEnabled(!configuration()->isLayoutProfilerEnabled());
+}
+
+void DiagnosticsActionsController::saveLayoutProfile()
+{
+    io::path_t path = interactive()->selectSavingFile(
+        qtrc("diagnostics", "Save layout profile"),
+        configuration()->diagnosticFilesDefaultSavingPath() + "/layout-profile.json",
+        { "(*.json)" });
+
+    if (path.empty()) {
+        return;
+    }
+
+    Ret ret = DiagnosticFilesWriter::writeLayoutProfile(path);
+    if (!ret) {
+        LOGE() << ret.toString();
+    }
+}
@@ -59,3 +59,38 @@ mu::io::path_t DiagnosticsConfiguration::diagnosticFilesDefaultSavingPath() cons
 {
     return globalConfiguration()->homePath();
 }
+
+bool DiagnosticsConfiguration::isLayoutProfilerEnabled() const
+{
+    return layoutProfiler()->isEnabled();
+}
+
+void DiagnosticsConfiguration::setIsLayoutProfilerEnabled(bool val)
+{
+    if (isLayoutProfilerEnabled() == val) {
+        return;
+    }
+
+    //! NOTE Not a setting, profiling slows down layout and is only wanted for the current session
+    layoutProfiler()->setEnabled(val);
+    m_isLayoutProfilerEnabledChanged.notify();
+}
+
+mu::async::Notification DiagnosticsConfiguration::isLayoutProfilerEnabledChanged() const
+{
+    return m_isLayoutProfilerEnabledChanged;
+}
+
+mu::io::path_t DiagnosticsConfiguration::layoutProfileOutputPath() const
+{
+    return m_layoutProfileOutputPath;
+}
+
+void DiagnosticsConfiguration::setLayoutProfileOutputPath(const std::optional<io::path_t>& path)
+{
+    m_layoutProfileOutputPath = path ? path.value() : io::path_t();
+
+    if (!m_layoutProfileOutputPath.empty()) {
+        setIsLayoutProfilerEnabled(true);
+    }
+}
@@ -26,11 +26,13 @@
 
 #include "modularity/ioc.h"
 #include "iglobalconfiguration.h"
+#include "engraving/rendering/ilayoutprofiler.h"
 
 namespace mu::diagnostics {
 class DiagnosticsConfiguration : public IDiagnosticsConfiguration
 {
     INJECT(framework::IGlobalConfiguration, globalConfiguration)
+    INJECT(engraving::rendering::ILayoutProfiler, layoutProfiler)
 
 public:
     DiagnosticsConfiguration() = default;
@@ -44,6 +46,17 @@ public:
     void setShouldWarnBeforeSavingDiagnosticFiles(bool val) override;
 
     io::path_t diagnosticFilesDefaultSavingPath() const override;
+
+    bool isLayoutProfilerEnabled() const override;
+    void setIsLayoutProfilerEnabled(bool val) override;
+    async::Notification isLayoutProfilerEnabledChanged() const override;
+
+    io::path_t layoutProfileOutputPath() const override;
+    void setLayoutProfileOutputPath(const std::optional<io::path_t>& path) override;
+
+private:
+    async::Notification m_isLayoutProfilerEnabledChanged;
+    io::path_t m_layoutProfileOutputPath;
 };
 }
 
@@ -0,0 +1,337 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "engravingbenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+
+#include "global/io/buffer.h"
+#include "global/io/dir.h"
+#include "global/serialization/json.h"
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/painter.h"
+#include "draw/types/drawdata.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/infrastructure/localfileinfoprovider.h"
+#include "engraving/infrastructure/mscio.h"
+#include "engraving/rw/mscloader.h"
+#include "engraving/rw/rwregister.h"
+#include "engraving/dom/masterscore.h"
+#include "engraving/dom/measure.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace mu::engraving;
+using namespace mu::engraving::benchmarks;
+
+using Clock = std::chrono::steady_clock;
+
+static const std::vector<std::string> FILES_FILTER = { "*.mscz", "*.mscx" };
+
+static const std::vector<std::pair<LayoutMode, std::string> > LAYOUT_MODES = {
+    { LayoutMode::PAGE, "layoutPage" },
+    { LayoutMode::LINE, "layoutContinuous" },
+    { LayoutMode::SYSTEM, "layoutSystem" },
+};
+
+static double msecSince(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void addTiming(EngravingBenchmark::ScoreResult& result, const std::string& stage, double msec)
+{
+    for (EngravingBenchmark::Stage& s : result.stages) {
+        if (s.name == stage) {
+            s.msecs.push_back(msec);
+            return;
+        }
+    }
+
+    result.stages.push_back(EngravingBenchmark::Stage { stage, { msec } });
+}
+
+static void timed(EngravingBenchmark::ScoreResult& result, const std::string& stage, const std::function<void()>& func)
+{
+    Clock::time_point start = Clock::now();
+    func();
+    addTiming(result, stage, msecSince(start));
+}
+
+static double median(std::vector<double> values)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return (values.size() % 2) ? values.at(mid) : (values.at(mid - 1) + values.at(mid)) / 2.0;
+}
+
+void EngravingBenchmark::setRepeatCount(int count)
+{
+    m_repeatCount = std::max(count, 1);
+}
+
+Ret EngravingBenchmark::runDir(const io::path_t& scoreDir)
+{
+    RetVal<io::paths_t> scores = io::Dir::scanFiles(scoreDir, FILES_FILTER);
+    if (!scores.ret) {
+        return scores.ret;
+    }
+
+    for (size_t i = 0; i < scores.val.size(); ++i) {
+        const io::path_t& scoreFile = scores.val.at(i);
+        std::string scorePath = scoreFile.toStdString();
+        if (scorePath.find("disabled") != std::string::npos || scorePath.find("DISABLED") != std::string::npos) {
+            LOGW() << "disabled: " << scoreFile;
+            continue;
+        }
+
+        LOGI() << "runFile: " << (i + 1) << "/" << scores.val.size() << " " << scoreFile;
+        runFile(scoreFile);
+    }
+
+    return make_ok();
+}
+
+Ret EngravingBenchmark::runFile(const io::path_t& scoreFile)
+{
+    ScoreResult result;
+    result.file = scoreFile;
+    result.ok = true;
+
+    for (int i = 0; i < m_repeatCount; ++i) {
+        if (!runOnce(scoreFile, result)) {
+            LOGE() << "failed run score: " << scoreFile;
+            result.ok = false;
+            break;
+        }
+    }
+
+    m_results.push_back(std::move(result));
+
+    return m_results.back().ok ? make_ok() : make_ret(Ret::Code::UnknownError);
+}
+
+const std::vector<EngravingBenchmark::ScoreResult>& EngravingBenchmark::results() const
+{
+    return m_results;
+}
+
+bool EngravingBenchmark::runOnce(const io::path_t& scoreFile, ScoreResult& result) const
+{
+    Clock::time_point start = Clock::now();
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+    if (!loadScore(score, scoreFile)) {
+        delete score;
+        return false;
+    }
+    addTiming(result, "load", msecSince(start));
+
+    for (const auto& mode : LAYOUT_MODES) {
+        timed(result, mode.second, [this, score, &mode]() { layoutInMode(score, mode.first); });
+    }
+
+    //! NOTE Edits, painting and saving are done in page view, as in a conversion
+    layoutInMode(score, LayoutMode::PAGE);
+
+    runEdits(score, result);
+
+    timed(result, "drawData", [this, score]() { genDrawData(score); });
+
+    bool saved = false;
+    timed(result, "save", [this, score, &saved]() { saved = saveScore(score); });
+
+    delete score;
+
+    return saved;
+}
+
+bool EngravingBenchmark::loadScore(MasterScore* score, const io::path_t& path) const
+{
+    score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(path));
+
+    std::string suffix = io::suffix(path);
+    if (!isMuseScoreFile(suffix)) {
+        return false;
+    }
+
+    MscReader::Params params;
+    params.filePath = path;
+    params.mode = mscIoModeBySuffix(suffix);
+
+    MscReader reader(params);
+    if (!reader.open()) {
+        return false;
+    }
+
+    MscLoader scoreReader;
+    SettingsCompat settingsCompat;
+    Ret ret = scoreReader.loadMscz(score, reader, settingsCompat, true);
+    if (!ret) {
+        LOGE() << "failed read file: " << path;
+        return false;
+    }
+
+    return true;
+}
+
+void EngravingBenchmark::layoutInMode(MasterScore* score, LayoutMode mode) const
+{
+    score->setLayoutMode(mode);
+    score->doLayout();
+}
+
+//---------------------------------------------------------
+//   runEdits
+//    a fixed script of edits, each timed with the
+//    incremental layout it causes; undone at the end, so
+//    that every repetition edits the same score
+//---------------------------------------------------------
+
+void EngravingBenchmark::runEdits(MasterScore* score, ScoreResult& result) const
+{
+    std::vector<Measure*> measures;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        measures.push_back(m);
+    }
+
+    if (measures.empty()) {
+        return;
+    }
+
+    Measure* first = measures.front();
+    Measure* middle = measures.at(measures.size() / 2);
+
+    timed(result, "editLineBreak", [score, middle]() {
+        score->startCmd();
+        middle->undoSetLineBreak(!middle->lineBreak());
+        score->endCmd();
+    });
+
+    timed(result, "editStretch", [score, first]() {
+        score->startCmd();
+        first->undoChangeProperty(Pid::USER_STRETCH, first->userStretch() * 1.5);
+        score->endCmd();
+    });
+
+    timed(result, "editConcertPitch", [score]() {
+        score->startCmd();
+        score->cmdConcertPitchChanged(!score->style().styleB(Sid::concertPitch));
+        score->endCmd();
+    });
+
+    timed(result, "undo", [score]() {
+        for (int i = 0; i < 3; ++i) {
+            score->undoRedo(true, nullptr);
+        }
+    });
+}
+
+void EngravingBenchmark::genDrawData(MasterScore* score) const
+{
+    std::shared_ptr<BufferedPaintProvider> pd = std::make_shared<BufferedPaintProvider>();
+
+    Painter painter(pd, "DrawData");
+    rendering::IScoreRenderer::PaintOptions option;
+    option.isMultiPage = true;
+    option.deviceDpi = DrawData::CANVAS_DPI;
+    option.printPageBackground = true;
+    option.isSetViewport = true;
+    option.isPrinting = true;
+
+    scoreRenderer()->paintScore(&painter, score, option);
+}
+
+bool EngravingBenchmark::saveScore(MasterScore* score) const
+{
+    io::Buffer buffer;
+    buffer.open(io::IODevice::WriteOnly);
+
+    return rw::RWRegister::writer()->writeScore(score, &buffer, false);
+}
+
+ByteArray EngravingBenchmark::toJson() const
+{
+    std::vector<std::pair<std::string, double> > totals;
+
+    JsonArray scoresArr;
+    for (const ScoreResult& result : m_results) {
+        JsonObject scoreObj;
+        scoreObj.set("file", result.file.toStdString());
+        scoreObj.set("ok", result.ok);
+
+        JsonArray stagesArr;
+        for (const Stage& stage : result.stages) {
+            double med = median(stage.msecs);
+
+            JsonArray runsArr;
+            for (double ms : stage.msecs) {
+                runsArr.append(ms);
+            }
+
+            JsonObject stageObj;
+            stageObj.set("name", stage.name);
+            stageObj.set("minMs", *std::min_element(stage.msecs.begin(), stage.msecs.end()));
+            stageObj.set("medianMs", med);
+            stageObj.set("meanMs", std::accumulate(stage.msecs.begin(), stage.msecs.end(), 0.0) / stage.msecs.size());
+            stageObj.set("maxMs", *std::max_element(stage.msecs.begin(), stage.msecs.end()));
+            stageObj.set("runs", runsArr);
+            stagesArr.append(stageObj);
+
+            if (!result.ok) {
+                continue;
+            }
+
+            auto it = std::find_if(totals.begin(), totals.end(), [&stage](const auto& t) { return t.first == stage.name; });
+            if (it == totals.end()) {
+                totals.push_back({ stage.name, med });
+            } else {
+                it->second += med;
+            }
+        }
+        scoreObj.set("stages", stagesArr);
+
+        scoresArr.append(scoreObj);
+    }
+
+    //! NOTE Sums of the medians over the scores that ran through, the numbers to compare between commits
+    JsonObject totalsObj;
+    for (const auto& t : totals) {
+        totalsObj.set(t.first, t.second);
+    }
+
+    JsonObject root;
+    root.set("repeat", m_repeatCount);
+    root.set("totalMs", totalsObj);
+    root.set("scores", scoresArr);
+
+    return JsonDocument(root).toJson();
+}
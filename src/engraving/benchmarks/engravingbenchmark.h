@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ENGRAVINGBENCHMARK_H
+#define MU_ENGRAVING_ENGRAVINGBENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "global/types/ret.h"
+#include "global/types/bytearray.h"
+#include "global/io/path.h"
+
+#include "modularity/ioc.h"
+#include "engraving/rendering/iscorerenderer.h"
+#include "engraving/rendering/layoutoptions.h"
+
+namespace mu::engraving {
+class MasterScore;
+}
+
+namespace mu::engraving::benchmarks {
+//---------------------------------------------------------
+//   EngravingBenchmark
+//    Runs every score several times through load, full
+//    layout in each view mode, a fixed set of edits with
+//    their incremental layouts, draw data generation and
+//    save, and reports the timings of each stage.
+//    Loading and painting are done the way DrawDataGenerator
+//    does it, so the numbers match a headless conversion.
+//---------------------------------------------------------
+
+class EngravingBenchmark
+{
+    INJECT(engraving::rendering::IScoreRenderer, scoreRenderer)
+
+public:
+    EngravingBenchmark() = default;
+
+    struct Stage {
+        std::string name;
+        std::vector<double> msecs;      // one per repetition
+    };
+
+    struct ScoreResult {
+        io::path_t file;
+        bool ok = false;
+        std::vector<Stage> stages;
+    };
+
+    void setRepeatCount(int count);
+
+    Ret runDir(const io::path_t& scoreDir);
+    Ret runFile(const io::path_t& scoreFile);
+
+    const std::vector<ScoreResult>& results() const;
+
+    ByteArray toJson() const;
+
+private:
+    bool runOnce(const io::path_t& scoreFile, ScoreResult& result) const;
+
+    bool loadScore(MasterScore* score, const io::path_t& path) const;
+    void layoutInMode(MasterScore* score, LayoutMode mode) const;
+    void runEdits(MasterScore* score, ScoreResult& result) const;
+    void genDrawData(MasterScore* score) const;
+    bool saveScore(MasterScore* score) const;
+
+    int m_repeatCount = 5;
+    std::vector<ScoreResult> m_results;
+};
+}
+
+#endif // MU_ENGRAVING_ENGRAVINGBENCHMARK_H
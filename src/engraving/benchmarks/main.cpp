@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QGuiApplication>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "global/runtime.h"
+#include "global/io/file.h"
+#include "global/io/dir.h"
+#include "testing/environment.h"
+
+#include "engraving/engravingmodule.h"
+#include "fonts/fontsmodule.h"
+#include "draw/drawmodule.h"
+
+#include "engraving/dom/instrtemplate.h"
+#include "engraving/dom/mscore.h"
+
+#include "engravingbenchmark.h"
+
+#include "log.h"
+
+//! NOTE Usage: engraving_benchmarks [--repeat N] [--output results.json] [score files or dirs...]
+//! Without scores, runs over vtest/scores and test/ of the source tree
+
+static mu::testing::SuiteEnvironment engraving_benchmarks_se(
+{
+    new mu::draw::DrawModule(),
+    new mu::fonts::FontsModule(),
+    new mu::engraving::EngravingModule()
+},
+    nullptr,
+    []() {
+    mu::engraving::MScore::noGui = true;
+    mu::engraving::loadInstrumentTemplates(":/data/instruments.xml");
+}
+    );
+
+int main(int argc, char** argv)
+{
+    QGuiApplication app(argc, argv);
+
+    mu::runtime::mainThreadId(); //! NOTE Needs only call
+    mu::runtime::setThreadName("main");
+
+    int repeat = 5;
+    mu::io::path_t output = "engraving_benchmarks.json";
+    std::vector<mu::io::path_t> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::atoi(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        const mu::io::path_t root(ENGRAVING_BENCHMARKS_ROOT_DIR);
+        inputs = { root + "/vtest/scores", root + "/test" };
+    }
+
+    mu::testing::Environment::setup();
+
+    mu::engraving::benchmarks::EngravingBenchmark benchmark;
+    benchmark.setRepeatCount(repeat);
+
+    for (const mu::io::path_t& input : inputs) {
+        if (mu::io::Dir(input).exists()) {
+            benchmark.runDir(input);
+        } else {
+            benchmark.runFile(input);
+        }
+    }
+
+    mu::Ret ret = mu::io::File::writeFile(output, benchmark.toJson());
+    if (!ret) {
+        LOGE() << "failed write results: " << output << ", err: " << ret.toString();
+        return 1;
+    }
+
+    LOGI() << "results written to: " << output;
+
+    return 0;
+}
@@ -19,8 +19,9 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
-
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "bsp.h"
 #include "engravingitem.h"
@@ -29,156 +30,262 @@ using namespace mu;
 
 namespace mu::engraving {
 //---------------------------------------------------------
-//   InsertItemBspTreeVisitor
+//   intmaxlog
 //---------------------------------------------------------
 
-class InsertItemBspTreeVisitor : public BspTreeVisitor
+static inline int intmaxlog(int n)
 {
-    OBJECT_ALLOCATOR(engraving, InsertItemBspTreeVisitor)
-public:
-    EngravingItem* item;
+    return n > 0 ? std::max(int(::ceil(::log(double(n)) / ::log(double(2)))), 5) : 0;
+}
 
-    inline void visit(std::list<EngravingItem*>* items) { items->push_front(item); }
-};
+static constexpr double INF = std::numeric_limits<double>::infinity();
 
 //---------------------------------------------------------
-//   RemoveItemBspTreeVisitor
+//   initialize
 //---------------------------------------------------------
 
-class RemoveItemBspTreeVisitor : public BspTreeVisitor
+void BspTree::initialize(const RectF& rec, int n)
 {
-    OBJECT_ALLOCATOR(engraving, RemoveItemBspTreeVisitor)
-public:
-    EngravingItem* item;
+    clear();
 
-    inline void visit(std::list<EngravingItem*>* items) { items->remove(item); }
-};
+    m_depth = intmaxlog(n);
+    m_rect  = rec;
+
+    m_nodes.resize((1 << (m_depth + 1)) - 1);
+    m_leaves.resize(1LL << m_depth);
+    initialize(rec, m_depth, 0);
+}
 
 //---------------------------------------------------------
-//   FindItemBspTreeVisitor
+//   isInitialized
+//    whether the tree has the partitioning initialize()
+//    would give it for these parameters
 //---------------------------------------------------------
 
-class FindItemBspTreeVisitor : public BspTreeVisitor
+bool BspTree::isInitialized(const RectF& rec, int n) const
 {
-    OBJECT_ALLOCATOR(engraving, FindItemBspTreeVisitor)
-public:
-    std::list<EngravingItem*> foundItems;
-
-    void visit(std::list<EngravingItem*>* items)
-    {
-        for (auto it = items->begin(); it != items->end(); ++it) {
-            EngravingItem* item = *it;
-            if (!item->itemDiscovered) {
-                item->itemDiscovered = true;
-                foundItems.push_front(item);
-            }
-        }
+    return !m_nodes.empty() && m_rect == rec && m_depth == static_cast<unsigned int>(intmaxlog(n));
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void BspTree::clear()
+{
+    m_leafCount = 0;
+    m_nodes.clear();
+    m_leaves.clear();
+
+    m_rects.clear();
+    m_items.clear();
+    m_generations.clear();
+    m_freeSlots.clear();
+    m_slots.clear();
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void BspTree::insert(EngravingItem* element)
+{
+    auto it = m_slots.find(element);
+    if (it != m_slots.end()) {
+        move(element);
+        return;
     }
-};
+
+    uint32_t slot;
+    if (m_freeSlots.empty()) {
+        slot = static_cast<uint32_t>(m_items.size());
+        m_rects.push_back(element->pageBoundingRect());
+        m_items.push_back(element);
+        m_generations.push_back(m_generation);
+    } else {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_rects[slot] = element->pageBoundingRect();
+        m_items[slot] = element;
+        m_generations[slot] = m_generation;
+    }
+
+    m_slots.emplace(element, slot);
+    insertSlot(slot);
+}
 
 //---------------------------------------------------------
-//   BspTree
+//   remove
 //---------------------------------------------------------
 
-BspTree::BspTree()
-    : leafCnt(0)
+void BspTree::remove(EngravingItem* element)
 {
-    depth = 0;
+    auto it = m_slots.find(element);
+    if (it == m_slots.end()) {
+        return;
+    }
+
+    uint32_t slot = it->second;
+    m_slots.erase(it);
+
+    removeSlot(slot);
+    m_items[slot] = nullptr;
+    m_freeSlots.push_back(slot);
 }
 
 //---------------------------------------------------------
-//   intmaxlog
+//   move
+//    the bounding rect of the item has changed
 //---------------------------------------------------------
 
-static inline int intmaxlog(int n)
+void BspTree::move(EngravingItem* element)
 {
-    return n > 0 ? std::max(int(::ceil(::log(double(n)) / ::log(double(2)))), 5) : 0;
+    auto it = m_slots.find(element);
+    if (it == m_slots.end()) {
+        insert(element);
+        return;
+    }
+
+    uint32_t slot = it->second;
+    m_generations[slot] = m_generation;
+
+    RectF r = element->pageBoundingRect();
+    if (r == m_rects[slot]) {
+        return;
+    }
+
+    removeSlot(slot);
+    m_rects[slot] = r;
+    insertSlot(slot);
 }
 
 //---------------------------------------------------------
-//   initialize
+//   contains
 //---------------------------------------------------------
 
-void BspTree::initialize(const RectF& rec, int n)
+bool BspTree::contains(const EngravingItem* element) const
 {
-    depth      = intmaxlog(n);
-    this->rect = rec;
-    leafCnt    = 0;
-
-    nodes.resize((1 << (depth + 1)) - 1);
-    leaves.resize(1LL << depth);
-    std::fill(leaves.begin(), leaves.end(), std::list<EngravingItem*>());
-    initialize(rec, depth, 0);
+    return m_slots.find(element) != m_slots.end();
 }
 
 //---------------------------------------------------------
-//   clear
+//   beginUpdate
 //---------------------------------------------------------
 
-void BspTree::clear()
+void BspTree::beginUpdate()
 {
-    leafCnt = 0;
-    nodes.clear();
-    leaves.clear();
+    ++m_generation;
 }
 
 //---------------------------------------------------------
-//   insert
+//   update
 //---------------------------------------------------------
 
-void BspTree::insert(EngravingItem* element)
+void BspTree::update(EngravingItem* element)
 {
-    InsertItemBspTreeVisitor insertVisitor;
-    insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    move(element);
 }
 
 //---------------------------------------------------------
-//   remove
+//   endUpdate
+//    removes the items that were not updated, they may
+//    be deleted already and must not be dereferenced
 //---------------------------------------------------------
 
-void BspTree::remove(EngravingItem* element)
+void BspTree::endUpdate()
+{
+    for (size_t slot = 0; slot < m_items.size(); ++slot) {
+        if (m_items[slot] && m_generations[slot] != m_generation) {
+            remove(m_items[slot]);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   insertSlot
+//---------------------------------------------------------
+
+void BspTree::insertSlot(size_t slot)
+{
+    auto insertVisitor = [this, slot](int leafIndex, const LeafBounds&) {
+        m_leaves[leafIndex].push_back(static_cast<uint32_t>(slot));
+    };
+    climbTree(m_rects[slot], LeafBounds { -INF, -INF, INF, INF }, 0, insertVisitor);
+}
+
+//---------------------------------------------------------
+//   removeSlot
+//---------------------------------------------------------
+
+void BspTree::removeSlot(size_t slot)
 {
-    RemoveItemBspTreeVisitor removeVisitor;
-    removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    auto removeVisitor = [this, slot](int leafIndex, const LeafBounds&) {
+        std::vector<uint32_t>& leaf = m_leaves[leafIndex];
+        auto it = std::find(leaf.begin(), leaf.end(), static_cast<uint32_t>(slot));
+        if (it != leaf.end()) {
+            *it = leaf.back();
+            leaf.pop_back();
+        }
+    };
+    climbTree(m_rects[slot], LeafBounds { -INF, -INF, INF, INF }, 0, removeVisitor);
 }
 
 //---------------------------------------------------------
 //   items
+//    An item lying in several leaves is reported only by
+//    the leaf which contains the top left corner of its
+//    intersection with rec, so no bookkeeping is needed
+//    to find duplicates.
 //---------------------------------------------------------
 
-std::vector<EngravingItem*> BspTree::items(const RectF& rec)
+void BspTree::items(const RectF& rec, std::vector<EngravingItem*>& result) const
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, rec);
-    std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->pageBoundingRect().intersects(rec)) {
-            l.push_back(e);
+    auto findVisitor = [this, &rec, &result](int leafIndex, const LeafBounds& bounds) {
+        for (uint32_t slot : m_leaves[leafIndex]) {
+            const RectF& r = m_rects[slot];
+            if (!r.intersects(rec)) {
+                continue;
+            }
+            double x = std::max(r.left(), rec.left());
+            double y = std::max(r.top(), rec.top());
+            if (x >= bounds.left && x < bounds.right && y >= bounds.top && y < bounds.bottom) {
+                result.push_back(m_items[slot]);
+            }
         }
-    }
-    return l;
+    };
+    climbTree(rec, LeafBounds { -INF, -INF, INF, INF }, 0, findVisitor);
+}
+
+std::vector<EngravingItem*> BspTree::items(const RectF& rec) const
+{
+    std::vector<EngravingItem*> result;
+    items(rec, result);
+    return result;
 }
 
 //---------------------------------------------------------
 //   items
 //---------------------------------------------------------
 
-std::vector<EngravingItem*> BspTree::items(const PointF& pos)
+void BspTree::items(const PointF& pos, std::vector<EngravingItem*>& result) const
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, pos);
-
-    std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->contains(pos)) {
-            l.push_back(e);
+    // a point lies in exactly one leaf
+    auto findVisitor = [this, &pos, &result](int leafIndex, const LeafBounds&) {
+        for (uint32_t slot : m_leaves[leafIndex]) {
+            EngravingItem* e = m_items[slot];
+            if (e->contains(pos)) {
+                result.push_back(e);
+            }
         }
-    }
-    return l;
+    };
+    climbTree(RectF(pos, pos), LeafBounds { -INF, -INF, INF, INF }, 0, findVisitor);
+}
+
+std::vector<EngravingItem*> BspTree::items(const PointF& pos) const
+{
+    std::vector<EngravingItem*> result;
+    items(pos, result);
+    return result;
 }
 
 #ifndef NDEBUG
@@ -188,25 +295,20 @@ std::vector<EngravingItem*> BspTree::items(const PointF& pos)
 
 String BspTree::debug(int index) const
 {
-    const Node* node = &nodes.at(index);
+    const Node* node = &m_nodes.at(index);
 
     String tmp;
     if (node->type == Node::Type::LEAF) {
         RectF rec = rectForIndex(index);
-        if (!leaves[node->leafIndex].empty()) {
+        if (!m_leaves[node->leafIndex].empty()) {
             tmp += String(u"[%1, %2, %3, %4] contains %5 items\n")
                    .arg(rec.left()).arg(rec.top())
                    .arg(rec.width()).arg(rec.height())
-                   .arg(leaves[node->leafIndex].size());
+                   .arg(m_leaves[node->leafIndex].size());
         }
     } else {
-        if (node->type == Node::Type::HORIZONTAL) {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
-        } else {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
-        }
+        tmp += debug(firstChildIndex(index));
+        tmp += debug(firstChildIndex(index) + 1);
     }
     return tmp;
 }
@@ -219,7 +321,7 @@ String BspTree::debug(int index) const
 
 void BspTree::initialize(const RectF& rec, int dep, int index)
 {
-    Node* node = &nodes[index];
+    Node* node = &m_nodes[index];
     if (index == 0) {
         node->type = Node::Type::HORIZONTAL;
         node->offset = rec.center().x();
@@ -246,11 +348,11 @@ void BspTree::initialize(const RectF& rec, int dep, int index)
 
         int childIndex = firstChildIndex(index);
 
-        Node* child   = &nodes[childIndex];
+        Node* child   = &m_nodes[childIndex];
         child->offset = offset1;
         child->type   = type;
 
-        child = &nodes[childIndex + 1];
+        child = &m_nodes[childIndex + 1];
         child->offset = offset2;
         child->type   = type;
 
@@ -258,80 +360,60 @@ void BspTree::initialize(const RectF& rec, int dep, int index)
         initialize(rect2, dep - 1, childIndex + 1);
     } else {
         node->type      = Node::Type::LEAF;
-        node->leafIndex = leafCnt++;
+        node->leafIndex = m_leafCount++;
     }
 }
 
 //---------------------------------------------------------
 //   climbTree
+//    calls func for every leaf touched by rec, bounds
+//    are the half-open coordinate ranges of the leaf
 //---------------------------------------------------------
 
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index)
+template<typename Func>
+void BspTree::climbTree(const mu::RectF& rec, const LeafBounds& bounds, int index, Func& func) const
 {
-    if (nodes.empty()) {
+    if (m_nodes.empty()) {
         return;
     }
 
-    Node* node = &nodes[index];
+    const Node* node = &m_nodes[index];
     int childIndex = firstChildIndex(index);
 
     switch (node->type) {
     case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (pos.x() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (pos.y() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
+        func(node->leafIndex, bounds);
         break;
-    }
-}
-
-//---------------------------------------------------------
-//   climbTree
-//---------------------------------------------------------
-
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::RectF& rec, int index)
-{
-    if (nodes.empty()) {
-        return;
-    }
-
-    Node* node = &nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
+    case Node::Type::VERTICAL: {
+        LeafBounds first = bounds;
+        first.right = node->offset;
+        LeafBounds second = bounds;
+        second.left = node->offset;
         if (rec.left() < node->offset) {
-            climbTree(visitor, rec, childIndex);
+            climbTree(rec, first, childIndex, func);
             if (rec.right() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
+                climbTree(rec, second, childIndex + 1, func);
             }
         } else {
-            climbTree(visitor, rec, childIndex + 1);
+            climbTree(rec, second, childIndex + 1, func);
         }
         break;
-    case Node::Type::HORIZONTAL:
+    }
+    case Node::Type::HORIZONTAL: {
+        LeafBounds first = bounds;
+        first.bottom = node->offset;
+        LeafBounds second = bounds;
+        second.top = node->offset;
         if (rec.top() < node->offset) {
-            climbTree(visitor, rec, childIndex);
+            climbTree(rec, first, childIndex, func);
             if (rec.bottom() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
+                climbTree(rec, second, childIndex + 1, func);
             }
         } else {
-            climbTree(visitor, rec, childIndex + 1);
+            climbTree(rec, second, childIndex + 1, func);
         }
+        break;
+    }
     }
 }
 
@@ -342,12 +424,12 @@ void BspTree::climbTree(BspTreeVisitor* visitor, const mu::RectF& rec, int index
 mu::RectF BspTree::rectForIndex(int index) const
 {
     if (index <= 0) {
-        return rect;
+        return m_rect;
     }
 
     int parentIdx = parentIndex(index);
     RectF rec   = rectForIndex(parentIdx);
-    const Node* parent = &nodes.at(parentIdx);
+    const Node* parent = &m_nodes.at(parentIdx);
 
     if (parent->type == Node::Type::HORIZONTAL) {
         if (index & 1) {
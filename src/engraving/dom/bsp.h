@@ -23,23 +23,23 @@
 #ifndef __BSP_H__
 #define __BSP_H__
 
-#include <list>
+#include <unordered_map>
+#include <vector>
 
-#include "global/allocator.h"
 #include "types/string.h"
 #include "draw/types/geometry.h"
 
 namespace mu::engraving {
-class BspTreeVisitor;
-class InsertItemBspTreeVisitor;
-class RemoveItemBspTreeVisitor;
-class FindItemBspTreeVisitor;
-
 class EngravingItem;
 
 //---------------------------------------------------------
 //   BspTree
 //    binary space partitioning
+//
+//    Items are kept in a packed table together with the
+//    page bounding rect they were inserted with, leaves
+//    only hold indices into that table. An item is moved
+//    between leaves only if its bounding rect changed.
 //---------------------------------------------------------
 
 class BspTree
@@ -55,34 +55,31 @@ public:
         };
         Type type;
     };
-private:
-    unsigned int depth;
-    void initialize(const mu::RectF& rect, int depth, int index);
-    void climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index = 0);
-    void climbTree(BspTreeVisitor* visitor, const mu::RectF& rect, int index = 0);
-
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::RectF& rect, int index);
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::PointF& pos, int index);
-    mu::RectF rectForIndex(int index) const;
 
-    std::vector<Node> nodes;
-    std::vector<std::list<EngravingItem*> > leaves;
-    int leafCnt;
-    mu::RectF rect;
+    BspTree() = default;
 
-public:
-    BspTree();
-
-    void initialize(const mu::RectF& rect, int depth);
+    void initialize(const mu::RectF& rect, int n);
+    bool isInitialized(const mu::RectF& rect, int n) const;
     void clear();
 
     void insert(EngravingItem* item);
     void remove(EngravingItem* item);
-
-    std::vector<EngravingItem*> items(const mu::RectF& rect);
-    std::vector<EngravingItem*> items(const mu::PointF& pos);
-
-    int leafCount() const { return leafCnt; }
+    void move(EngravingItem* item);
+    bool contains(const EngravingItem* item) const;
+    size_t size() const { return m_slots.size(); }
+
+    //! NOTE Incremental rebuild: the items passed to update() are inserted
+    //! or moved, the items that were not passed are removed by endUpdate()
+    void beginUpdate();
+    void update(EngravingItem* item);
+    void endUpdate();
+
+    void items(const mu::RectF& rect, std::vector<EngravingItem*>& result) const;
+    void items(const mu::PointF& pos, std::vector<EngravingItem*>& result) const;
+    std::vector<EngravingItem*> items(const mu::RectF& rect) const;
+    std::vector<EngravingItem*> items(const mu::PointF& pos) const;
+
+    int leafCount() const { return m_leafCount; }
     inline int firstChildIndex(int index) const { return index * 2 + 1; }
 
     inline int parentIndex(int index) const
@@ -93,18 +90,35 @@ public:
 #ifndef NDEBUG
     String debug(int index) const;
 #endif
-};
 
-//---------------------------------------------------------
-//   BspTreeVisitor
-//---------------------------------------------------------
+private:
+    struct LeafBounds {
+        double left;
+        double top;
+        double right;
+        double bottom;
+    };
 
-class BspTreeVisitor
-{
-    OBJECT_ALLOCATOR(engraving, BspTreeVisitor)
-public:
-    virtual ~BspTreeVisitor() {}
-    virtual void visit(std::list<EngravingItem*>* items) = 0;
+    void initialize(const mu::RectF& rect, int depth, int index);
+    void insertSlot(size_t slot);
+    void removeSlot(size_t slot);
+    template<typename Func>
+    void climbTree(const mu::RectF& rect, const LeafBounds& bounds, int index, Func& func) const;
+    mu::RectF rectForIndex(int index) const;
+
+    unsigned int m_depth = 0;
+    std::vector<Node> m_nodes;
+    std::vector<std::vector<uint32_t> > m_leaves;
+    int m_leafCount = 0;
+    mu::RectF m_rect;
+
+    // item table, indexed by slot
+    std::vector<mu::RectF> m_rects;
+    std::vector<EngravingItem*> m_items;
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<const EngravingItem*, uint32_t> m_slots;
+    uint32_t m_generation = 0;
 };
 } // namespace mu::engraving
 #endif
@@ -28,6 +28,7 @@
 #include "engravingitem.h"
 
 #include <cmath>
+#include <unordered_map>
 
 #include "containers.h"
 #include "io/buffer.h"
@@ -110,26 +111,85 @@ EngravingItem::~EngravingItem()
 {
     Score::onElementDestruction(this);
 
+#ifndef ENGRAVING_NO_ACCESSIBILITY
+    releaseAccessible();
+#endif
+
     delete m_layoutData;
 }
 
 #ifndef ENGRAVING_NO_ACCESSIBILITY
+//! NOTE Accessible objects are created on demand (when an element gets focus), so only a few
+//! elements ever have one; they are kept here rather than in every element
+using AccessibleItems = std::unordered_map<EngravingItem*, AccessibleItemPtr>;
+
+static AccessibleItems& accessibleItems()
+{
+    static AccessibleItems items;
+    return items;
+}
+
+//! NOTE When exceeded, the accessible objects of elements that are not focused anymore are released
+static constexpr size_t MAX_ACCESSIBLE_ITEMS = 4096;
+
 void EngravingItem::setupAccessible()
 {
-    if (m_accessible) {
+    if (m_hasAccessible) {
         return;
     }
 
-    static std::list<ElementType> accessibleDisabled = {
-        ElementType::LEDGER_LINE
-    };
+    if (type() == ElementType::LEDGER_LINE) {
+        return;
+    }
 
     if (score() && !score()->isPaletteScore()) {
-        if (std::find(accessibleDisabled.begin(), accessibleDisabled.end(), type()) == accessibleDisabled.end()) {
-            m_accessible = createAccessible();
-            m_accessible->setup();
+        AccessibleItemPtr accessible = createAccessible();
+        accessibleItems().emplace(this, accessible);
+        m_hasAccessible = true;
+        accessible->setup();
+    }
+}
+
+void EngravingItem::releaseAccessible()
+{
+    if (!m_hasAccessible) {
+        return;
+    }
+
+    m_hasAccessible = false;
+
+    //! NOTE The accessible object unregisters itself when destroyed, do it after it's removed from the map
+    AccessibleItems& items = accessibleItems();
+    auto it = items.find(this);
+    if (it != items.end()) {
+        AccessibleItemPtr accessible = std::move(it->second);
+        items.erase(it);
+    }
+}
+
+void EngravingItem::releaseUnusedAccessibles(const EngravingItemList& used)
+{
+    AccessibleItems& items = accessibleItems();
+    if (items.size() <= MAX_ACCESSIBLE_ITEMS) {
+        return;
+    }
+
+    std::vector<AccessibleItemPtr> released;
+    for (auto it = items.begin(); it != items.end();) {
+        EngravingItem* item = it->first;
+        bool keep = item->isType(ElementType::ROOT_ITEM) || item->isType(ElementType::DUMMY)
+                    || std::find(used.begin(), used.end(), item) != used.end();
+        if (keep) {
+            ++it;
+            continue;
         }
+
+        item->m_hasAccessible = false;
+        released.push_back(std::move(it->second));
+        it = items.erase(it);
     }
+
+    LOGD() << "released accessible objects: " << released.size();
 }
 
 #endif
@@ -186,9 +246,9 @@ void EngravingItem::notifyAboutNameChanged()
         return;
     }
 
-    if (m_accessible) {
+    if (m_hasAccessible) {
         doInitAccessible();
-        m_accessible->accessibleRoot()->notifyAboutFocusedElementNameChanged();
+        accessible()->accessibleRoot()->notifyAboutFocusedElementNameChanged();
     }
 }
 
@@ -1803,7 +1863,13 @@ EngravingItem* EngravingItem::prevSegmentElement()
 #ifndef ENGRAVING_NO_ACCESSIBILITY
 AccessibleItemPtr EngravingItem::accessible() const
 {
-    return m_accessible;
+    if (!m_hasAccessible) {
+        return nullptr;
+    }
+
+    const AccessibleItems& items = accessibleItems();
+    auto it = items.find(const_cast<EngravingItem*>(this));
+    return it != items.end() ? it->second : nullptr;
 }
 
 #endif
@@ -2316,6 +2382,9 @@ void EngravingItem::doInitAccessible()
     }
 
     setupAccessible();
+
+    parents.push_back(this);
+    releaseUnusedAccessibles(parents);
 }
 
 #endif // ENGRAVING_NO_ACCESSIBILITY
@@ -460,6 +460,7 @@ public:
 
 #ifndef ENGRAVING_NO_ACCESSIBILITY
     virtual void setupAccessible();
+    void releaseAccessible();
     AccessibleItemPtr accessible() const;
     void initAccessibleIfNeed();
 #endif
@@ -648,7 +649,9 @@ private:
 
 #ifndef ENGRAVING_NO_ACCESSIBILITY
     void doInitAccessible();
-    AccessibleItemPtr m_accessible;
+    static void releaseUnusedAccessibles(const EngravingItemList& used);
+
+    bool m_hasAccessible = false;       // the accessible object is kept aside, see accessibleItems()
 #endif
 
     bool m_accessibleEnabled = false;
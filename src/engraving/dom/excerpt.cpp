@@ -309,6 +309,8 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
     MasterScore* masterScore = excerpt->masterScore();
     Score* score = excerpt->excerptScore();
 
+    ObjectArena::Scope arenaScope(masterScore->arena());
+
     std::vector<Part*>& parts = excerpt->parts();
     std::vector<staff_idx_t> srcStaves;
 
@@ -520,7 +522,12 @@ void MasterScore::initAndAddExcerpt(Excerpt* excerpt, bool fakeUndo)
 void MasterScore::initExcerpt(Excerpt* excerpt)
 {
     if (excerpt->inited()) {
-        excerpt->excerptScore()->doLayout();
+        Score* score = excerpt->excerptScore();
+        if (score->isOpen()) {
+            score->doLayout();
+        } else {
+            score->setNeedsLayout();
+        }
         return;
     }
 
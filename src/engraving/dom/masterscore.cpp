@@ -60,6 +60,7 @@ MasterScore::MasterScore(std::weak_ptr<engraving::EngravingProject> project)
     : Score()
 {
     m_project = project;
+    m_arena = std::make_unique<ObjectArena>("MasterScore");
     _undoStack   = new UndoStack();
     _tempomap    = new TempoMap;
     _sigmap      = new TimeSigMap();
@@ -262,6 +263,9 @@ MasterScore* MasterScore::clone()
 
     ByteArray scoreData = buffer.data();
     MasterScore* score = new MasterScore(style(), m_project);
+    score->arena()->setName(m_arena->name());
+
+    ObjectArena::Scope arenaScope(score->arena());
 
     XmlReader r(scoreData);
     MscLoader().readMasterScore(score, r, true);
@@ -135,6 +135,9 @@ public:
 
     std::weak_ptr<EngravingProject> project() const { return m_project; }
 
+    //! NOTE Objects created while loading or cloning the score are allocated from it
+    ObjectArena* arena() const { return m_arena.get(); }
+
     bool isMaster() const override { return true; }
 
     GetEID* getEID() { return &m_getEID; }
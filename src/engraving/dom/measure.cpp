@@ -624,18 +624,7 @@ ChordRest* Measure::findChordRest(Fraction t, track_idx_t track)
 
 Segment* Measure::tick2segment(const Fraction& _t, SegmentType st)
 {
-    Fraction t = _t - tick();
-    for (Segment& s : m_segments) {
-        if (s.rtick() == t) {
-            if (s.segmentType() & st) {
-                return &s;
-            }
-        }
-        if (s.rtick() > t) {
-            break;
-        }
-    }
-    return 0;
+    return m_segments.find(st, _t - tick());
 }
 
 //---------------------------------------------------------
@@ -646,25 +635,7 @@ Segment* Measure::tick2segment(const Fraction& _t, SegmentType st)
 
 Segment* Measure::findSegmentR(SegmentType st, const Fraction& t) const
 {
-    Segment* s;
-    if (t > (ticks() * Fraction(1, 2))) {
-        // search backwards
-        for (s = last(); s && s->rtick() > t; s = s->prev()) {
-        }
-        while (s && s->prev() && s->prev()->rtick() == t) {
-            s = s->prev();
-        }
-    } else {
-        // search forwards
-        for (s = first(); s && s->rtick() < t; s = s->next()) {
-        }
-    }
-    for (; s && s->rtick() == t; s = s->next()) {
-        if (s->segmentType() & st) {
-            return s;
-        }
-    }
-    return 0;
+    return m_segments.find(st, t);
 }
 
 //---------------------------------------------------------
@@ -689,12 +660,9 @@ Segment* Measure::undoGetSegmentR(SegmentType type, const Fraction& t)
 
 Segment* Measure::findFirstR(SegmentType st, const Fraction& t) const
 {
-    Segment* s;
-    // search forwards
-    for (s = first(); s && s->rtick() <= t; s = s->next()) {
-        if (s->segmentType() == st) {
-            return s;
-        }
+    Segment* s = m_segments.first(st);
+    if (s && s->segmentType() == st && s->rtick() <= t) {
+        return s;
     }
     return 0;
 }
@@ -810,7 +778,7 @@ void Measure::add(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = toMeasure(e);
+        setMMRest(toMeasure(e));
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -929,7 +897,7 @@ void Measure::remove(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = 0;
+        setMMRest(nullptr);
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -2766,6 +2734,16 @@ Measure* Measure::mmRestLast() const
     return score()->lastMeasure();
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    m_mmRest = m;
+    score()->measures()->invalidateTickIndex();
+}
+
 //---------------------------------------------------------
 //   coveringMMRestOrThis
 //    if multi-measure rests are enabled,
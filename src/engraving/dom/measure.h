@@ -307,7 +307,7 @@ public:
     bool isMMRest() const { return m_mmRestCount > 0; }
     Measure* mmRest() const { return m_mmRest; }
     const Measure* coveringMMRestOrThis() const;
-    void setMMRest(Measure* m) { m_mmRest = m; }
+    void setMMRest(Measure* m);
     int mmRestCount() const { return m_mmRestCount; }            // number of measures m_mmRest spans
     void setMMRestCount(int n) { m_mmRestCount = n; }
     Measure* mmRestFirst() const;
@@ -357,6 +357,137 @@ public:
 
     bool canAddStringTunings(staff_idx_t staffIdx) const;
 
+    struct LayoutData : public EngravingItem::LayoutData {
+        //! NOTE The spacing computed by MeasureLayout::computeWidth, with the key
+        //! of everything it was computed from. Cleared with the rest of the layout data,
+        //! so it only lives while the measure is out of the range being laid out.
+        //! The key holds the inputs themselves and is compared field by field;
+        //! it refers to the segments through the generation of the segment list only,
+        //! which changes when a segment is added or removed and so drops the memo.
+        struct ShapeElementKey {
+            ElementType type = ElementType::INVALID;
+            double x = 0.0;
+            double y = 0.0;
+            double width = 0.0;
+            double height = 0.0;
+
+            bool operator==(const ShapeElementKey& k) const
+            {
+                return type == k.type && x == k.x && y == k.y && width == k.width && height == k.height;
+            }
+        };
+        using ShapeKey = std::vector<ShapeElementKey>;
+
+        struct ChordRestKey {
+            ElementType type = ElementType::INVALID;
+            track_idx_t track = 0;
+            Fraction ticks;
+            bool hasBeam = false;
+            bool up = false;
+            bool visible = false;
+            bool staffVisible = false;
+            std::vector<double> danglingLinesX;   // chord and note positions, first measure of a system only
+
+            bool operator==(const ChordRestKey& k) const
+            {
+                return type == k.type && track == k.track && ticks == k.ticks && hasBeam == k.hasBeam && up == k.up
+                       && visible == k.visible && staffVisible == k.staffVisible && danglingLinesX == k.danglingLinesX;
+            }
+        };
+
+        struct SegmentKey {
+            SegmentType type = SegmentType::Invalid;
+            Fraction rtick;
+            Fraction ticks;
+            bool enabled = false;
+            bool visible = false;
+            bool allElementsInvisible = false;
+            bool header = false;
+            double extraLeadingSpace = 0.0;
+            std::vector<ShapeKey> shapes;
+            std::vector<ChordRestKey> chordRests;
+
+            bool operator==(const SegmentKey& k) const
+            {
+                return type == k.type && rtick == k.rtick && ticks == k.ticks && enabled == k.enabled && visible == k.visible
+                       && allElementsInvisible == k.allElementsInvisible && header == k.header
+                       && extraLeadingSpace == k.extraLeadingSpace && shapes == k.shapes && chordRests == k.chordRests;
+            }
+        };
+
+        struct SpacingKey {
+            uint64_t segmentsGeneration = 0;
+            bool isFirstInSystem = false;
+            double systemWidth = 0.0;
+            double systemLeftMargin = 0.0;
+            double spatium = 0.0;
+            double mag = 0.0;
+            double userStretch = 0.0;
+            Fraction ticks;
+            Fraction timesig;
+            int mmRestCount = 0;
+
+            Fraction minTicks;
+            Fraction maxTicks;
+            double stretchCoeff = 0.0;
+            bool overrideMinMeasureWidth = false;
+            double squeezeFactor = 0.0;
+
+            double noteHeadWidth = 0.0;
+            std::vector<PropertyValue> style;
+
+            // the end of the previous measure in the system
+            bool hasPrevEnd = false;
+            bool prevRepeatEnd = false;
+            SegmentType prevEndType = SegmentType::Invalid;
+            double prevEndSpace = 0.0;
+            std::vector<ShapeKey> prevEndShapes;
+
+            std::vector<SegmentKey> segments;
+
+            bool operator==(const SpacingKey& k) const
+            {
+                return segmentsGeneration == k.segmentsGeneration && isFirstInSystem == k.isFirstInSystem
+                       && systemWidth == k.systemWidth && systemLeftMargin == k.systemLeftMargin && spatium == k.spatium
+                       && mag == k.mag && userStretch == k.userStretch && ticks == k.ticks && timesig == k.timesig
+                       && mmRestCount == k.mmRestCount && minTicks == k.minTicks && maxTicks == k.maxTicks
+                       && stretchCoeff == k.stretchCoeff && overrideMinMeasureWidth == k.overrideMinMeasureWidth
+                       && squeezeFactor == k.squeezeFactor && noteHeadWidth == k.noteHeadWidth && style == k.style
+                       && hasPrevEnd == k.hasPrevEnd && prevRepeatEnd == k.prevRepeatEnd && prevEndType == k.prevEndType
+                       && prevEndSpace == k.prevEndSpace && prevEndShapes == k.prevEndShapes && segments == k.segments;
+            }
+
+            bool operator!=(const SpacingKey& k) const { return !operator==(k); }
+        };
+
+        struct SegmentSpacing {
+            Segment* segment = nullptr;
+            double x = 0.0;
+            double width = 0.0;
+            double widthOffset = 0.0;
+            double stretch = 1.0;
+            CrossBeamType crossBeamType;
+        };
+
+        struct Spacing {
+            SpacingKey key;
+            std::vector<SegmentSpacing> segments;
+            double width = 0.0;
+            double squeezableSpace = 0.0;
+            double layoutStretch = 1.0;
+            bool widthLocked = false;
+        };
+
+        std::optional<Spacing> spacing;
+
+        void reset() override
+        {
+            EngravingItem::LayoutData::reset();
+            spacing.reset();
+        }
+    };
+    DECLARE_LAYOUTDATA_METHODS(Measure)
+
 private:
 
     friend class Factory;
@@ -22,6 +22,8 @@
 
 #include "measurebase.h"
 
+#include <algorithm>
+
 #include "factory.h"
 #include "layoutbreak.h"
 #include "measure.h"
@@ -334,6 +336,9 @@ Fraction MeasureBase::tick() const
 
 void MeasureBase::setTick(const Fraction& f)
 {
+    if (m_tick != f && score()) {
+        score()->measures()->invalidateTickIndex();
+    }
     m_tick = f;
 }
 
@@ -659,6 +664,73 @@ LayoutBreak* MeasureBase::sectionBreakElement() const
     return nullptr;
 }
 
+//---------------------------------------------------------
+//   MeasureTickIndex::ensureBuilt
+//---------------------------------------------------------
+
+bool MeasureTickIndex::isBuiltFor(bool withMMRests) const
+{
+    return m_valid.load(std::memory_order_acquire) && m_withMMRests.load(std::memory_order_relaxed) == withMMRests;
+}
+
+void MeasureTickIndex::ensureBuilt(Measure* first, bool useMMrest, bool withMMRests)
+{
+    if (isBuiltFor(withMMRests)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (isBuiltFor(withMMRests)) {
+        return;
+    }
+
+    // nobody reads the tables while they are rebuilt, see isBuiltFor
+    m_valid.store(false, std::memory_order_relaxed);
+    rebuild(first, useMMrest, withMMRests);
+}
+
+//---------------------------------------------------------
+//   MeasureTickIndex::rebuild
+//---------------------------------------------------------
+
+void MeasureTickIndex::rebuild(Measure* first, bool useMMrest, bool withMMRests)
+{
+    m_measures.clear();
+    m_ticks.clear();
+    m_sorted = true;
+
+    for (Measure* m = first; m; m = useMMrest ? m->nextMeasureMM() : m->nextMeasure()) {
+        Fraction tick = m->tick();
+        if (!m_ticks.empty() && tick < m_ticks.back()) {
+            m_sorted = false;
+        }
+        m_measures.push_back(m);
+        m_ticks.push_back(tick);
+    }
+
+    m_withMMRests.store(withMMRests, std::memory_order_relaxed);
+    m_valid.store(true, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+//   MeasureTickIndex::measureAt
+//    return the last measure starting at or before tick;
+//    ticks past the last measure only match its end tick
+//---------------------------------------------------------
+
+Measure* MeasureTickIndex::measureAt(const Fraction& tick) const
+{
+    auto it = std::upper_bound(m_ticks.cbegin(), m_ticks.cend(), tick);
+    if (it == m_ticks.cbegin()) {
+        return nullptr;
+    }
+    if (it != m_ticks.cend()) {
+        return m_measures[static_cast<size_t>(std::distance(m_ticks.cbegin(), it)) - 1];
+    }
+    Measure* lm = m_measures.back();
+    return tick <= lm->endTick() ? lm : nullptr;
+}
+
 //---------------------------------------------------------
 //   MeasureBaseList
 //---------------------------------------------------------
@@ -676,6 +748,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    invalidateTickIndex();
     ++m_size;
     if (m_last) {
         m_last->setNext(e);
@@ -695,6 +768,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    invalidateTickIndex();
     ++m_size;
     if (m_first) {
         m_first->setPrev(e);
@@ -724,6 +798,7 @@ void MeasureBaseList::add(MeasureBase* e)
         push_front(e);
         return;
     }
+    invalidateTickIndex();
     ++m_size;
     e->setPrev(el->prev());
     el->prev()->setNext(e);
@@ -736,6 +811,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    invalidateTickIndex();
     --m_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -755,6 +831,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     ++m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++m_size;
@@ -779,6 +856,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     --m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --m_size;
@@ -803,6 +881,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    invalidateTickIndex();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
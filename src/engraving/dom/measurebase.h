@@ -28,6 +28,9 @@
  Definition of MeasureBase class.
 */
 
+#include <atomic>
+#include <mutex>
+
 #include "engravingitem.h"
 
 namespace mu::engraving {
@@ -200,6 +203,46 @@ private:
     double m_oldWidth = 0.0;              // Used to restore layout during recalculations in Score::collectSystem()
 };
 
+//---------------------------------------------------------
+//   MeasureTickIndex
+//    measures of a score ordered by start tick, so that
+//    tick lookups are a binary search instead of a walk
+//    over the measure list.
+//    Lookups may come from several layout threads at once,
+//    the first of them rebuilds an invalidated index under
+//    the lock, the others wait for it. Invalidation only
+//    happens while the measure list is edited, that is
+//    never concurrently with lookups.
+//---------------------------------------------------------
+
+class MeasureTickIndex
+{
+public:
+    bool isValid() const { return m_valid.load(std::memory_order_acquire); }
+    void invalidate() { m_valid.store(false, std::memory_order_release); }
+
+    //! NOTE Thread safe
+    void ensureBuilt(Measure* first, bool useMMrest, bool withMMRests);
+
+    // the index can only answer lookups while measure ticks are in order
+    bool isSorted() const { return m_sorted; }
+    bool withMMRests() const { return m_withMMRests.load(std::memory_order_relaxed); }
+
+    Measure* measureAt(const Fraction& tick) const;
+    size_t size() const { return m_measures.size(); }
+
+private:
+    bool isBuiltFor(bool withMMRests) const;
+    void rebuild(Measure* first, bool useMMrest, bool withMMRests);
+
+    std::vector<Measure*> m_measures;
+    std::vector<Fraction> m_ticks;
+    bool m_sorted = false;
+    std::atomic<bool> m_valid = false;
+    std::atomic<bool> m_withMMRests = false;
+    std::mutex m_mutex;
+};
+
 //---------------------------------------------------------
 //   MeasureBaseList
 //---------------------------------------------------------
@@ -210,7 +253,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return m_first; }
     MeasureBase* last()  const { return m_last; }
-    void clear() { m_first = m_last = 0; m_size = 0; }
+    void clear() { m_first = m_last = 0; m_size = 0; invalidateTickIndex(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -219,6 +262,9 @@ public:
     int size() const { return m_size; }
     bool empty() const { return m_size == 0; }
 
+    MeasureTickIndex& tickIndex(bool useMMrest) const { return useMMrest ? m_tickIndexMM : m_tickIndex; }
+    void invalidateTickIndex() const { m_tickIndex.invalidate(); m_tickIndexMM.invalidate(); }
+
 private:
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
@@ -226,6 +272,9 @@ private:
     int m_size = 0;
     MeasureBase* m_first = nullptr;
     MeasureBase* m_last = nullptr;
+
+    mutable MeasureTickIndex m_tickIndex;
+    mutable MeasureTickIndex m_tickIndexMM;
 };
 } // namespace mu::engraving
 #endif
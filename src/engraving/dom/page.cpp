@@ -22,6 +22,8 @@
 
 #include "page.h"
 
+#include <atomic>
+
 #ifndef ENGRAVING_NO_ACCESSIBILITY
 #include "accessibility/accessibleitem.h"
 #endif
@@ -54,24 +56,54 @@ Page::Page(RootItem* parent)
     bspTreeValid = false;
 }
 
+//---------------------------------------------------------
+//   markLayoutChanged
+//---------------------------------------------------------
+
+void Page::markLayoutChanged()
+{
+    static std::atomic<uint64_t> generation = 0;
+    m_layoutGeneration = ++generation;
+}
+
 //---------------------------------------------------------
 //   items
 //---------------------------------------------------------
 
 std::vector<EngravingItem*> Page::items(const RectF& rect)
+{
+    std::vector<EngravingItem*> result;
+    items(rect, result);
+    return result;
+}
+
+std::vector<EngravingItem*> Page::items(const mu::PointF& point)
+{
+    std::vector<EngravingItem*> result;
+    items(point, result);
+    return result;
+}
+
+//---------------------------------------------------------
+//   items
+//    appends to result, so that callers querying
+//    repeatedly can reuse the buffer
+//---------------------------------------------------------
+
+void Page::items(const RectF& rect, std::vector<EngravingItem*>& result)
 {
     if (!bspTreeValid) {
         doRebuildBspTree();
     }
-    return bspTree.items(rect);
+    bspTree.items(rect, result);
 }
 
-std::vector<EngravingItem*> Page::items(const mu::PointF& point)
+void Page::items(const mu::PointF& point, std::vector<EngravingItem*>& result)
 {
     if (!bspTreeValid) {
         doRebuildBspTree();
     }
-    return bspTree.items(point);
+    bspTree.items(point, result);
 }
 
 //---------------------------------------------------------
@@ -248,12 +280,12 @@ void Page::scanElements(void* data, void (* func)(void*, EngravingItem*), bool a
 }
 
 //---------------------------------------------------------
-//   bspInsert
+//   bspUpdate
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, EngravingItem* e)
+static void bspUpdate(void* bspTree, EngravingItem* e)
 {
-    ((BspTree*)bspTree)->insert(e);
+    ((BspTree*)bspTree)->update(e);
 }
 
 static void countElements(void* data, EngravingItem* /*e*/)
@@ -263,6 +295,10 @@ static void countElements(void* data, EngravingItem* /*e*/)
 
 //---------------------------------------------------------
 //   doRebuildBspTree
+//    Only the items added, removed or moved since the last
+//    rebuild are touched, the tree is initialized anew only
+//    when the page size or the number of items changes
+//    its partitioning.
 //---------------------------------------------------------
 
 void Page::doRebuildBspTree()
@@ -286,8 +322,12 @@ void Page::doRebuildBspTree()
         r = abbox();
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
+    if (!bspTree.isInitialized(r, n)) {
+        bspTree.initialize(r, n);
+    }
+    bspTree.beginUpdate();
+    scanElements(&bspTree, &bspUpdate, false);
+    bspTree.endUpdate();
     bspTreeValid = true;
 }
 
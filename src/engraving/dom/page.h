@@ -23,8 +23,12 @@
 #ifndef __PAGE_H__
 #define __PAGE_H__
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "draw/types/drawdata.h"
+
 #include "engravingitem.h"
 #include "bsp.h"
 
@@ -48,12 +52,36 @@ class Page final : public EngravingItem
     OBJECT_ALLOCATOR(engraving, Page)
     DECLARE_CLASSOF(ElementType::PAGE)
 
+public:
+    //! NOTE The items of the page in paint order, recorded once after the page
+    //! was laid out and then replayed by every paint, see rendering::dev::Paint
+    struct DisplayItem {
+        EngravingItem* item = nullptr;
+        RectF rect;                     // page bounding rect, as in the bsp tree
+        draw::Color color;              // the state the item was recorded in
+        bool selected = false;
+        draw::DrawDataPtr data;         // null if the item is painted directly every time
+        size_t memoryUsage = 0;         // estimated size of the data, in bytes
+    };
+
+    struct DisplayList {
+        size_t paintKey = 0;            // the score and configuration state it was recorded in
+        std::vector<DisplayItem> items;
+        size_t memoryUsage = 0;         // estimated size of the recorded data, in bytes
+        uint64_t lastPainted = 0;       // the number of the last paint replaying it
+    };
+
+private:
     std::vector<System*> _systems;
     page_idx_t _no;                        // page number
 
     BspTree bspTree;
     bool bspTreeValid;
 
+    uint64_t m_layoutGeneration = 0;
+
+    std::shared_ptr<DisplayList> m_displayList;
+
     void doRebuildBspTree();
 
     friend class Factory;
@@ -88,7 +116,19 @@ public:
 
     std::vector<EngravingItem*> items(const mu::RectF& r);
     std::vector<EngravingItem*> items(const mu::PointF& p);
-    void invalidateBspTree() { bspTreeValid = false; }
+    void items(const mu::RectF& r, std::vector<EngravingItem*>& result);
+    void items(const mu::PointF& p, std::vector<EngravingItem*>& result);
+    void invalidateBspTree() { bspTreeValid = false; m_displayList.reset(); }
+
+    //! NOTE Dropped together with the bsp tree, that is whenever the items of the page change
+    DisplayList* displayList() const { return m_displayList.get(); }
+    void setDisplayList(std::shared_ptr<DisplayList> list) { m_displayList = std::move(list); }
+
+    //! NOTE Changes every time the page is laid out again, unique among all pages,
+    //! so that views can tell which pages they have to repaint
+    uint64_t layoutGeneration() const { return m_layoutGeneration; }
+    void markLayoutChanged();
+
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     mu::RectF tbbox() const;                             // tight bounding box, excluding white space
@@ -4393,18 +4393,19 @@ ChordRest* Score::findCR(Fraction tick, track_idx_t track) const
     if (m->isMMRest()) {
         tick = m->tick();
     }
-    Segment* s = m->first(SegmentType::ChordRest);
-    for (Segment* ns = s;; ns = ns->next(SegmentType::ChordRest)) {
-        if (!ns || ns->tick() > tick) {
-            break;
-        }
+    // search backwards from the last chord/rest segment not after tick
+    Segment* s = nullptr;
+    for (Segment* ns = m->segments().findLast(SegmentType::ChordRest, tick - m->tick()); ns;
+         ns = ns->prev(SegmentType::ChordRest)) {
         EngravingItem* el = ns->element(track);
-        if (el && el->isRest() && toRest(el)->isGap()) {
-            continue;
-        } else if (el) {
+        if (el && !(el->isRest() && toRest(el)->isGap())) {
             s = ns;
+            break;
         }
     }
+    if (!s) {
+        s = m->first(SegmentType::ChordRest);
+    }
 
     if (!s) {
         return nullptr;
@@ -4442,23 +4443,28 @@ ChordRest* Score::findCRinStaff(const Fraction& tick, staff_idx_t staffIdx) cons
     track_idx_t etrack      = strack + VOICES;
     track_idx_t actualTrack = strack;
 
+    // Find the cr on this staff ending last but not after tick, preferring
+    // later segments and higher tracks on ties. Searching backwards allows
+    // to stop as soon as a cr ending exactly at tick is found.
     Fraction lastTick = Fraction(-1, 1);
-    for (Segment* ns = s;; ns = ns->next(SegmentType::ChordRest)) {
-        if (ns == 0 || ns->tick() > ptick) {
-            break;
-        }
-        // found a segment; now find longest cr on this staff that does not overlap tick
+    for (Segment* ns = m->segments().findLast(SegmentType::ChordRest, ptick - m->tick()); ns;
+         ns = ns->prev(SegmentType::ChordRest)) {
+        bool found = false;
         for (track_idx_t t = strack; t < etrack; ++t) {
             ChordRest* cr = toChordRest(ns->element(t));
             if (cr) {
                 Fraction endTick = cr->tick() + cr->actualTicks();
-                if (endTick >= lastTick && endTick <= tick) {
+                if (endTick <= tick && (endTick > lastTick || (found && endTick == lastTick))) {
                     s = ns;
                     actualTrack = t;
                     lastTick = endTick;
+                    found = true;
                 }
             }
         }
+        if (lastTick == tick) {
+            break;
+        }
     }
     if (s) {
         return toChordRest(s->element(actualTrack));
@@ -5566,6 +5572,22 @@ void Score::doLayout()
     doLayoutRange(Fraction(0, 1), Fraction(-1, 1));
 }
 
+//---------------------------------------------------------
+//   lastLaidOutMeasure
+//    the last measure on a page, measures after it have not
+//    been laid out yet if a progressive layout is pending
+//---------------------------------------------------------
+
+static const MeasureBase* lastLaidOutMeasure(const Score* score)
+{
+    for (auto it = score->pages().crbegin(); it != score->pages().crend(); ++it) {
+        if (!(*it)->systems().empty() && !(*it)->systems().back()->measures().empty()) {
+            return (*it)->systems().back()->measures().back();
+        }
+    }
+    return nullptr;
+}
+
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
     TRACEFUNC;
@@ -5583,7 +5605,42 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         this->updateVelo();
     }
 
-    renderer()->layoutScore(this, st, et);
+    const MeasureBase* lastMb = masterScore()->last();
+    const bool wholeScore = st <= Fraction(0, 1) && (et < Fraction(0, 1) || !lastMb || et >= lastMb->endTick());
+    if (wholeScore && m_progressiveLayoutPages) {
+        m_layoutOptions.pageLimit = m_progressiveLayoutPages;
+    }
+
+    const MeasureBase* laidOut = layoutPending() ? lastLaidOutMeasure(this) : nullptr;
+    if (laidOut && st > laidOut->endTick()) {
+        // a range after the laid out pages can't be laid out on its own,
+        // the layout continues from the laid out pages until it covers the range;
+        // the rest of the score stays pending
+        while (laidOut && (et < Fraction(0, 1) || laidOut->endTick() < et)) {
+            const size_t laidOutPages = npages();
+            m_layoutOptions.pageLimit = laidOutPages + 1;
+            renderer()->layoutScore(this, laidOut->endTick(), Fraction(-1, 1));
+            if (!layoutPending() || npages() <= laidOutPages) {
+                break;
+            }
+            laidOut = lastLaidOutMeasure(this);
+        }
+    } else {
+        // an edit of the laid out pages keeps to them,
+        // the view lays out the rest again from the new state
+        if (laidOut && !wholeScore) {
+            m_layoutOptions.pageLimit = std::max(npages(), size_t(1));
+        }
+        renderer()->layoutScore(this, st, et);
+    }
+
+    if (m_layoutOptions.pageLimit && !layoutPending()) {
+        m_layoutOptions.pageLimit = 0;
+    }
+
+    if (wholeScore) {
+        m_needsLayout = false;
+    }
 
     if (m_resetAutoplace) {
         m_resetAutoplace = false;
@@ -5596,6 +5653,77 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 }
 
+//---------------------------------------------------------
+//   layoutIfNeeded
+//    lay out a score that changed while it was not open
+//---------------------------------------------------------
+
+void Score::layoutIfNeeded()
+{
+    if (m_needsLayout) {
+        doLayout();
+    }
+}
+
+//---------------------------------------------------------
+//   setProgressiveLayout
+//    0 turns progressive layout off
+//---------------------------------------------------------
+
+void Score::setProgressiveLayout(size_t firstPages)
+{
+    m_progressiveLayoutPages = firstPages;
+}
+
+//---------------------------------------------------------
+//   layoutPending
+//    true if the last complete layout stopped at its page
+//    limit before the end of the score
+//---------------------------------------------------------
+
+bool Score::layoutPending() const
+{
+    if (!m_layoutOptions.pageLimit) {
+        return false;
+    }
+
+    const MeasureBase* mb = lastLaidOutMeasure(this);
+    if (!mb) {
+        return first() != nullptr;
+    }
+    return (m_layoutOptions.isShowVBox ? mb->next() : mb->nextMeasure()) != nullptr;
+}
+
+//---------------------------------------------------------
+//   continueLayout
+//    lay out up to the given number of pages more,
+//    0 lays out the rest of the score
+//---------------------------------------------------------
+
+void Score::continueLayout(size_t pages)
+{
+    if (!layoutPending()) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    const MeasureBase* laidOut = lastLaidOutMeasure(this);
+    m_layoutOptions.pageLimit = pages ? npages() + pages : 0;
+    doLayoutRange(laidOut ? laidOut->endTick() : Fraction(0, 1), Fraction(-1, 1));
+}
+
+//---------------------------------------------------------
+//   finishLayout
+//    bring the layout of the whole score up to date
+//---------------------------------------------------------
+
+void Score::finishLayout()
+{
+    layoutIfNeeded();
+    continueLayout(0);
+}
+
 void Score::createPaddingTable()
 {
     m_paddingTable.createTable(style());
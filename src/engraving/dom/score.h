@@ -563,6 +563,7 @@ public:
     Measure* tick2measure(const Fraction& tick) const;
     Measure* tick2measureMM(const Fraction& tick) const;
     MeasureBase* tick2measureBase(const Fraction& tick) const;
+    const MeasureTickIndex& tickIndex(bool useMMrest) const;
     Segment* tick2segment(const Fraction& tick, bool first, SegmentType st, bool useMMrest = false) const;
     Segment* tick2segment(const Fraction& tick) const;
     Segment* tick2segment(const Fraction& tick, bool first) const;
@@ -769,6 +770,22 @@ public:
     void doLayout();
     void doLayoutRange(const Fraction& st, const Fraction& et);
 
+    // scores that are not open are not laid out on changes, only marked;
+    // they are laid out when their geometry is needed
+    bool needsLayout() const { return m_needsLayout; }
+    void setNeedsLayout() { m_needsLayout = true; }
+    void layoutIfNeeded();
+
+    //! NOTE Progressive layout is a view-only mode, off by default: a complete layout
+    //! only lays out the first pages, the view lays out the rest by continueLayout() calls.
+    //! Edits while it is pending lay out the laid out pages only, or up to the edited range
+    //! if it is after them, and leave the rest pending (see doLayoutRange).
+    //! Other consumers of the whole layout (print, export, save) call finishLayout()
+    void setProgressiveLayout(size_t firstPages);
+    bool layoutPending() const;
+    void continueLayout(size_t pages);
+    void finishLayout();
+
     SynthesizerState& synthesizerState() { return m_synthesizerState; }
     void setSynthesizerState(const SynthesizerState& s);
 
@@ -805,6 +822,7 @@ public:
     const LayoutOptions& layoutOptions() const { return m_layoutOptions; }
     void setLayoutMode(LayoutMode lm) { m_layoutOptions.mode = lm; }
     void setShowVBox(bool v) { m_layoutOptions.isShowVBox = v; }
+    void setParallelLayout(bool v) { m_layoutOptions.isParallel = v; }
     double noteHeadWidth() const { return m_layoutOptions.noteHeadWidth; }
     void setNoteHeadWidth(double n) { m_layoutOptions.noteHeadWidth = n; }
 
@@ -952,6 +970,9 @@ public:
     friend class Chord;
 
 protected:
+    //! NOTE Owned by the master score; declared first to be released after everything the score deletes
+    std::unique_ptr<ObjectArena> m_arena;
+
     int m_fileDivision = 0;   // division of current loading *.msc file
     SynthesizerState m_synthesizerState;
 
@@ -1080,6 +1101,8 @@ private:
 
     RootItem* m_rootItem = nullptr;
     LayoutOptions m_layoutOptions;
+    size_t m_progressiveLayoutPages = 0;
+    bool m_needsLayout = true;
 
     mu::async::Channel<EngravingItem*> m_elementDestroyed;
 
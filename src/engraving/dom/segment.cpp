@@ -195,7 +195,14 @@ void Segment::setParent(Measure* parent)
 void Segment::setSegmentType(SegmentType t)
 {
     assert(_segmentType != SegmentType::Clef || t != SegmentType::ChordRest);
-    _segmentType = t;
+    if (m_list) {
+        SegmentList* list = m_list;
+        list->removeFromIndex(this);
+        _segmentType = t;
+        list->addToIndex(this);
+    } else {
+        _segmentType = t;
+    }
 }
 
 //---------------------------------------------------------
@@ -341,6 +348,12 @@ Segment* Segment::next1MMenabled() const
 
 Segment* Segment::next(SegmentType types) const
 {
+    if (!_next || (_next->segmentType() & types)) {
+        return _next;
+    }
+    if (m_list) {
+        return m_list->next(this, types);
+    }
     for (Segment* s = next(); s; s = s->next()) {
         if (s->segmentType() & types) {
             return s;
@@ -372,6 +385,12 @@ Segment* Segment::nextInStaff(staff_idx_t staffIdx, SegmentType type) const
 
 Segment* Segment::prev(SegmentType types) const
 {
+    if (!_prev || (_prev->segmentType() & types)) {
+        return _prev;
+    }
+    if (m_list) {
+        return m_list->prev(this, types);
+    }
     for (Segment* s = prev(); s; s = s->prev()) {
         if (s->segmentType() & types) {
             return s;
@@ -2423,20 +2442,21 @@ double Segment::elementsTopOffsetFromSkyline(staff_idx_t staffIndex) const
         return 0;
     }
 
-    SkylineLine north = staffSystem->skyline().north();
+    const SkylineLine& north = staffSystem->skyline().north();
     int topOffset = INT_MAX;
-    for (SkylineSegment segment: north) {
-        Segment* seg = prev1enabled();
-        if (!seg) {
-            continue;
-        }
-        bool ok = seg->pagePos().x() <= segment.x && segment.x <= pagePos().x();
-        if (!ok) {
-            continue;
-        }
+    const Segment* seg = prev1enabled();
+    if (seg) {
+        const double from = seg->pagePos().x();
+        const double to = pagePos().x();
+        for (const SkylineSegment& segment : north) {
+            bool ok = from <= segment.x && segment.x <= to;
+            if (!ok) {
+                continue;
+            }
 
-        if (segment.y < topOffset) {
-            topOffset = segment.y;
+            if (segment.y < topOffset) {
+                topOffset = segment.y;
+            }
         }
     }
 
@@ -2456,20 +2476,21 @@ double Segment::elementsBottomOffsetFromSkyline(staff_idx_t staffIndex) const
         return 0;
     }
 
-    SkylineLine south = staffSystem->skyline().south();
+    const SkylineLine& south = staffSystem->skyline().south();
     int bottomOffset = INT_MIN;
-    for (SkylineSegment segment: south) {
-        Segment* seg = prev1enabled();
-        if (!seg) {
-            continue;
-        }
-        bool ok = seg->pagePos().x() <= segment.x && segment.x <= pagePos().x();
-        if (!ok) {
-            continue;
-        }
+    const Segment* seg = prev1enabled();
+    if (seg) {
+        const double from = seg->pagePos().x();
+        const double to = pagePos().x();
+        for (const SkylineSegment& segment : south) {
+            bool ok = from <= segment.x && segment.x <= to;
+            if (!ok) {
+                continue;
+            }
 
-        if (segment.y > bottomOffset) {
-            bottomOffset = segment.y;
+            if (segment.y > bottomOffset) {
+                bottomOffset = segment.y;
+            }
         }
     }
 
@@ -31,6 +31,7 @@ namespace mu::engraving {
 class Factory;
 class Measure;
 class Segment;
+class SegmentList;
 class ChordRest;
 class Spanner;
 class System;
@@ -94,6 +95,8 @@ class Segment final : public EngravingItem
 
     Segment* _next = nullptr;                       // linked list of segments inside a measure
     Segment* _prev = nullptr;
+    SegmentList* m_list = nullptr;                  // list this segment is linked into
+    size_t m_listPos = 0;                           // increasing along m_list, used by its type index
 
     std::vector<EngravingItem*> _annotations;
     std::vector<EngravingItem*> _elist;         // EngravingItem storage, size = staves * VOICES.
@@ -104,6 +107,7 @@ class Segment final : public EngravingItem
     CrossBeamType _crossBeamType; // Will affect segment-to-segment horizontal spacing
 
     friend class Factory;
+    friend class SegmentList;
     Segment(Measure* m = 0);
     Segment(Measure*, SegmentType, const Fraction&);
     Segment(const Segment&);
@@ -307,6 +311,7 @@ public:
     Fraction shortestChordRest() const;
     void computeCrossBeamType(Segment* nextSeg);
     CrossBeamType crossBeamType() const { return _crossBeamType; }
+    void setCrossBeamType(const CrossBeamType& type) { _crossBeamType = type; }
 
     bool hasAccidentals() const;
 
@@ -21,6 +21,10 @@
  */
 
 #include "segmentlist.h"
+
+#include <algorithm>
+#include <atomic>
+
 #include "segment.h"
 #include "score.h"
 
@@ -29,6 +33,141 @@
 using namespace mu;
 
 namespace mu::engraving {
+//---------------------------------------------------------
+//   SegmentList
+//---------------------------------------------------------
+
+SegmentList::SegmentList(SegmentList&& l)
+{
+    clear();
+    *this = std::move(l);
+}
+
+SegmentList& SegmentList::operator=(SegmentList&& l)
+{
+    if (this == &l) {
+        return *this;
+    }
+    _first = l._first;
+    _last = l._last;
+    _size = l._size;
+    _typed = std::move(l._typed);
+    for (Segment* s = _first; s; s = s->next()) {
+        s->m_list = this;
+    }
+    _generation = nextGeneration();
+    l.clear();
+    return *this;
+}
+
+//---------------------------------------------------------
+//   clear
+//    Forget all segments; they are not touched as they may
+//    have been deleted already.
+//---------------------------------------------------------
+
+void SegmentList::clear()
+{
+    _first = _last = 0;
+    _size = 0;
+    for (std::vector<Segment*>& b : _typed) {
+        b.clear();
+    }
+    _generation = nextGeneration();
+}
+
+//---------------------------------------------------------
+//   nextGeneration
+//---------------------------------------------------------
+
+uint64_t SegmentList::nextGeneration()
+{
+    static std::atomic<uint64_t> generation = 0;
+    return ++generation;
+}
+
+//---------------------------------------------------------
+//   bucket
+//    Index of the bucket of a single segment type,
+//    TYPE_BUCKETS for SegmentType::Invalid
+//---------------------------------------------------------
+
+size_t SegmentList::bucket(SegmentType t)
+{
+    unsigned bits = static_cast<unsigned>(t);
+    size_t idx = 0;
+    while (bits && !(bits & 1)) {
+        bits >>= 1;
+        ++idx;
+    }
+    assert(bits <= 1 && idx <= TYPE_BUCKETS);
+    return bits ? idx : TYPE_BUCKETS;
+}
+
+//---------------------------------------------------------
+//   addToIndex
+//    Segment positions must be set up already.
+//---------------------------------------------------------
+
+void SegmentList::addToIndex(Segment* s)
+{
+    s->m_list = this;
+    _generation = nextGeneration();
+    size_t b = bucket(s->segmentType());
+    if (b == TYPE_BUCKETS) {
+        return;
+    }
+    std::vector<Segment*>& segs = _typed[b];
+    if (segs.empty() || segs.back()->m_listPos < s->m_listPos) {
+        segs.push_back(s);
+        return;
+    }
+    auto it = std::lower_bound(segs.begin(), segs.end(), s, [](const Segment* a, const Segment* b) {
+        return a->m_listPos < b->m_listPos;
+    });
+    segs.insert(it, s);
+}
+
+//---------------------------------------------------------
+//   removeFromIndex
+//---------------------------------------------------------
+
+void SegmentList::removeFromIndex(Segment* s)
+{
+    s->m_list = nullptr;
+    _generation = nextGeneration();
+    size_t b = bucket(s->segmentType());
+    if (b == TYPE_BUCKETS) {
+        return;
+    }
+    std::vector<Segment*>& segs = _typed[b];
+    auto it = std::lower_bound(segs.begin(), segs.end(), s, [](const Segment* a, const Segment* b) {
+        return a->m_listPos < b->m_listPos;
+    });
+    if (it != segs.end() && *it == s) {
+        segs.erase(it);
+    } else {
+        ASSERT_X("SegmentList::removeFromIndex: segment not indexed");
+    }
+}
+
+//---------------------------------------------------------
+//   renumberFrom
+//    Give s the position after its predecessor and shift the
+//    following segments until the positions are increasing
+//    again. Positions may have gaps (left by removals), so
+//    this usually stops early.
+//---------------------------------------------------------
+
+void SegmentList::renumberFrom(Segment* s)
+{
+    size_t pos = s->prev() ? s->prev()->m_listPos + 1 : 0;
+    s->m_listPos = pos;
+    for (Segment* n = s->next(); n && n->m_listPos <= pos; n = n->next()) {
+        n->m_listPos = ++pos;
+    }
+}
+
 //---------------------------------------------------------
 //   clone
 //---------------------------------------------------------
@@ -104,6 +243,24 @@ void SegmentList::check()
     if (l && l->next()) {
         ASSERT_X("SegmentList::check: last has next");
     }
+    size_t indexed = 0;
+    for (Segment* s = _first; s; s = s->next()) {
+        if (s->m_list != this) {
+            ASSERT_X("SegmentList::check: segment not bound to list");
+        }
+        if (s->next() && s->next()->m_listPos <= s->m_listPos) {
+            ASSERT_X("SegmentList::check: bad segment position");
+        }
+        if (s->segmentType() != SegmentType::Invalid) {
+            ++indexed;
+        }
+    }
+    for (const std::vector<Segment*>& segs : _typed) {
+        indexed -= segs.size();
+    }
+    if (indexed != 0) {
+        ASSERT_X("SegmentList::check: bad type index");
+    }
     if (n != _size) {
         ASSERT_X(String(u"SegmentList::check: counted %1 but _size is %d2").arg(n, _size));
         _size = n;
@@ -129,6 +286,8 @@ void SegmentList::insert(Segment* e, Segment* el)
         e->setPrev(el->prev());
         el->prev()->setNext(e);
         el->setPrev(e);
+        renumberFrom(e);
+        addToIndex(e);
     }
     check();
 }
@@ -170,6 +329,7 @@ void SegmentList::remove(Segment* e)
         e->prev()->setNext(e->next());
         e->next()->setPrev(e->prev());
     }
+    removeFromIndex(e);
 }
 
 //---------------------------------------------------------
@@ -186,7 +346,9 @@ void SegmentList::push_back(Segment* e)
         _first = e;
     }
     e->setPrev(_last);
+    e->m_listPos = _last ? _last->m_listPos + 1 : 0;
     _last = e;
+    addToIndex(e);
     check();
 }
 
@@ -205,6 +367,12 @@ void SegmentList::push_front(Segment* e)
     }
     e->setNext(_first);
     _first = e;
+    if (e->next() && e->next()->m_listPos > 0) {
+        e->m_listPos = e->next()->m_listPos - 1;
+    } else {
+        renumberFrom(e);
+    }
+    addToIndex(e);
     check();
 }
 
@@ -223,12 +391,127 @@ Segment* SegmentList::firstCRSegment() const
 
 Segment* SegmentList::first(SegmentType types) const
 {
-    for (Segment* s = _first; s; s = s->next()) {
-        if (s->segmentType() & types) {
-            return s;
+    if (_first && (_first->segmentType() & types)) {
+        return _first;
+    }
+    Segment* first = nullptr;
+    for (size_t b = 0; b < TYPE_BUCKETS; ++b) {
+        const std::vector<Segment*>& segs = _typed[b];
+        if (segs.empty() || !(types & SegmentType(1 << b))) {
+            continue;
+        }
+        if (!first || segs.front()->m_listPos < first->m_listPos) {
+            first = segs.front();
+        }
+    }
+    return first;
+}
+
+//---------------------------------------------------------
+//   next
+//    Return the first segment of one of the given types
+//    following s in the list.
+//---------------------------------------------------------
+
+Segment* SegmentList::next(const Segment* s, SegmentType types) const
+{
+    assert(s->m_list == this);
+    Segment* next = nullptr;
+    for (size_t b = 0; b < TYPE_BUCKETS; ++b) {
+        const std::vector<Segment*>& segs = _typed[b];
+        if (segs.empty() || !(types & SegmentType(1 << b)) || segs.back()->m_listPos <= s->m_listPos) {
+            continue;
+        }
+        auto it = std::upper_bound(segs.begin(), segs.end(), s->m_listPos, [](size_t pos, const Segment* seg) {
+            return pos < seg->m_listPos;
+        });
+        if (!next || (*it)->m_listPos < next->m_listPos) {
+            next = *it;
+        }
+    }
+    return next;
+}
+
+//---------------------------------------------------------
+//   prev
+//    Return the last segment of one of the given types
+//    preceding s in the list.
+//---------------------------------------------------------
+
+Segment* SegmentList::prev(const Segment* s, SegmentType types) const
+{
+    assert(s->m_list == this);
+    Segment* prev = nullptr;
+    for (size_t b = 0; b < TYPE_BUCKETS; ++b) {
+        const std::vector<Segment*>& segs = _typed[b];
+        if (segs.empty() || !(types & SegmentType(1 << b)) || segs.front()->m_listPos >= s->m_listPos) {
+            continue;
+        }
+        auto it = std::lower_bound(segs.begin(), segs.end(), s->m_listPos, [](const Segment* seg, size_t pos) {
+            return seg->m_listPos < pos;
+        });
+        --it;
+        if (!prev || (*it)->m_listPos > prev->m_listPos) {
+            prev = *it;
+        }
+    }
+    return prev;
+}
+
+//---------------------------------------------------------
+//   find
+//    Return the first segment of one of the given types at
+//    measure relative tick rtick. Binary searches the
+//    buckets, which are sorted by tick as the list is.
+//---------------------------------------------------------
+
+Segment* SegmentList::find(SegmentType types, const Fraction& rtick) const
+{
+    Segment* found = nullptr;
+    for (size_t b = 0; b < TYPE_BUCKETS; ++b) {
+        const std::vector<Segment*>& segs = _typed[b];
+        if (segs.empty() || !(types & SegmentType(1 << b))) {
+            continue;
+        }
+        auto it = std::lower_bound(segs.begin(), segs.end(), rtick, [](const Segment* seg, const Fraction& t) {
+            return seg->rtick() < t;
+        });
+        if (it == segs.end() || (*it)->rtick() != rtick) {
+            continue;
+        }
+        if (!found || (*it)->m_listPos < found->m_listPos) {
+            found = *it;
+        }
+    }
+    return found;
+}
+
+//---------------------------------------------------------
+//   findLast
+//    Return the last segment of one of the given types at
+//    or before measure relative tick rtick.
+//---------------------------------------------------------
+
+Segment* SegmentList::findLast(SegmentType types, const Fraction& rtick) const
+{
+    Segment* found = nullptr;
+    for (size_t b = 0; b < TYPE_BUCKETS; ++b) {
+        const std::vector<Segment*>& segs = _typed[b];
+        if (segs.empty() || !(types & SegmentType(1 << b))) {
+            continue;
+        }
+        auto it = std::upper_bound(segs.begin(), segs.end(), rtick, [](const Fraction& t, const Segment* seg) {
+            return t < seg->rtick();
+        });
+        if (it == segs.begin()) {
+            continue;
+        }
+        --it;
+        if (!found || (*it)->m_listPos > found->m_listPos) {
+            found = *it;
         }
     }
-    return 0;
+    return found;
 }
 
 //---------------------------------------------------------
@@ -23,6 +23,10 @@
 #ifndef __SEGMENTLIST_H__
 #define __SEGMENTLIST_H__
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include "segment.h"
 
 namespace mu::engraving {
@@ -30,17 +34,43 @@ class Segment;
 
 //---------------------------------------------------------
 //   SegmentList
+//    Doubly linked list of the segments of a measure.
+//    Besides the links, the list keeps a secondary index of
+//    its segments bucketed by SegmentType, so that typed
+//    navigation (first/next/prev of a type) and lookups by
+//    tick don't have to walk over segments of other types.
 //---------------------------------------------------------
 
 class SegmentList
 {
+    //! NOTE One bucket per single-bit SegmentType value
+    static constexpr size_t TYPE_BUCKETS = 13;
+
     Segment* _first;          ///< First item of segment list
     Segment* _last;           ///< Last item of segment list
     int _size;                ///< Number of items in segment list
 
+    /// Segments of each type, in list order
+    std::array<std::vector<Segment*>, TYPE_BUCKETS> _typed;
+
+    uint64_t _generation = 0;  ///< Changes whenever a segment is added or removed
+
+    static size_t bucket(SegmentType t);
+    static uint64_t nextGeneration();
+    void addToIndex(Segment* s);
+    void removeFromIndex(Segment* s);
+    void renumberFrom(Segment* s);
+
+    friend class Segment;
+
 public:
     SegmentList() { clear(); }
-    void clear() { _first = _last = 0; _size = 0; }
+    SegmentList(const SegmentList&) = delete;
+    SegmentList& operator=(const SegmentList&) = delete;
+    SegmentList(SegmentList&&);
+    SegmentList& operator=(SegmentList&&);
+
+    void clear();
 #ifndef NDEBUG
     void check();
 #else
@@ -49,6 +79,10 @@ public:
     SegmentList clone() const;
     int size() const { return _size; }
 
+    //! NOTE Unique across all lists, so a memo holding it stays tied to the
+    //! segments it was made for even after the list is moved or replaced
+    uint64_t generation() const { return _generation; }
+
     Segment* first() const { return _first; }
     Segment* first(SegmentType) const;
     Segment* first(ElementFlag) const;
@@ -56,6 +90,13 @@ public:
     Segment* last() const { return _last; }
     Segment* last(ElementFlag) const;
     Segment* firstCRSegment() const;
+
+    Segment* next(const Segment* s, SegmentType) const;
+    Segment* prev(const Segment* s, SegmentType) const;
+    const std::vector<Segment*>& segments(SegmentType t) const { return _typed[bucket(t)]; }
+
+    Segment* find(SegmentType, const Fraction& rtick) const;
+    Segment* findLast(SegmentType, const Fraction& rtick) const;
     void remove(Segment*);
     void push_back(Segment*);
     void push_front(Segment*);
@@ -21,10 +21,13 @@
  */
 #include "slur.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "draw/types/transform.h"
 
+#include "infrastructure/slurobstacles.h"
+
 #include "beam.h"
 #include "chord.h"
 #include "measure.h"
@@ -58,6 +61,34 @@ struct SlurCollision
 };
 
 namespace mu::engraving {
+//---------------------------------------------------------
+//   AvoidanceKey
+//    compared exactly, PointF and RectF compare fuzzily
+//---------------------------------------------------------
+
+static bool isSame(const PointF& a, const PointF& b)
+{
+    return a.x() == b.x() && a.y() == b.y();
+}
+
+static bool isSame(const RectF& a, const RectF& b)
+{
+    return a.x() == b.x() && a.y() == b.y() && a.width() == b.width() && a.height() == b.height();
+}
+
+bool SlurSegment::LayoutData::AvoidanceKey::operator==(const AvoidanceKey& k) const
+{
+    if (!isSame(pp1, k.pp1) || !isSame(p2, k.p2) || !isSame(p3, k.p3) || !isSame(p4, k.p4)) {
+        return false;
+    }
+    if (slurAngle != k.slurAngle || leftBalance != k.leftBalance || rightBalance != k.rightBalance || step != k.step
+        || vertClearance != k.vertClearance || up != k.up || endPointsEdited != k.endPointsEdited) {
+        return false;
+    }
+    return std::equal(obstacles.begin(), obstacles.end(), k.obstacles.begin(), k.obstacles.end(),
+                      [](const RectF& a, const RectF& b) { return isSame(a, b); });
+}
+
 SlurSegment::SlurSegment(System* parent)
     : SlurTieSegment(ElementType::SLUR_SEGMENT, parent)
 {
@@ -439,6 +470,7 @@ void SlurSegment::avoidCollisions(PointF& pp1, PointF& p2, PointF& p3, PointF& p
     if (segShapes.empty()) {
         return;
     }
+    const SlurObstacles obstacles(segShapes, 2 * spatium());
 
     // Collision clearance at the center of the slur
     double slurLength = abs(p2.x() / spatium());
@@ -486,6 +518,21 @@ void SlurSegment::avoidCollisions(PointF& pp1, PointF& p2, PointF& p3, PointF& p
         step *= slurLength / longSlurLimit;
         step = std::min(step, 1.5 * spatium());
     }
+
+    // Laid out again with the same points among the same shapes, the slur ends up where it did before
+    LayoutData::AvoidanceKey avoidanceKey { pp1, p2, p3, p4, slurAngle, leftBalance, rightBalance, step, vertClearance,
+                                            slur()->up(), isEndPointsEdited(), obstacles.rects() };
+
+    const std::optional<LayoutData::Avoidance>& avoidance = ldata()->avoidance;
+    if (avoidance && avoidance->key == avoidanceKey) {
+        pp1 = avoidance->pp1;
+        p2 = avoidance->p2;
+        p3 = avoidance->p3;
+        p4 = avoidance->p4;
+        toSystemCoordinates = avoidance->toSystemCoordinates;
+        return;
+    }
+
     // Divide slur in several rectangles to localize collisions
     const unsigned npoints = 20;
     std::vector<RectF> slurRects;
@@ -512,28 +559,24 @@ void SlurSegment::avoidCollisions(PointF& pp1, PointF& p2, PointF& p3, PointF& p
             slurRects.push_back(RectF(clearancePoint1, clearancePoint2));
         }
         // Check collisions
-        for (Shape& segShape : segShapes) {
-            for (unsigned i=0; i < slurRects.size(); i++) {
-                bool leftSection = i < slurRects.size() / 3;
-                bool midSection = i >= slurRects.size() / 3 && i < 2 * slurRects.size() / 3;
-                bool rightSection = i >= 2 * slurRects.size() / 3;
-                if ((leftSection && collision.left)
-                    || (midSection && collision.mid)
-                    || (rightSection && collision.right)) {     // If a collision is already found in this section, no need to check again
-                    continue;
+        for (unsigned i=0; i < slurRects.size(); i++) {
+            bool leftSection = i < slurRects.size() / 3;
+            bool midSection = i >= slurRects.size() / 3 && i < 2 * slurRects.size() / 3;
+            bool rightSection = i >= 2 * slurRects.size() / 3;
+            if ((leftSection && collision.left)
+                || (midSection && collision.mid)
+                || (rightSection && collision.right)) {     // If a collision is already found in this section, no need to check again
+                continue;
+            }
+            if (obstacles.collides(slurRects[i], slur()->up())) {
+                if (leftSection) {
+                    collision.left = true;
                 }
-                bool intersection = slur()->up() ? !Shape(slurRects[i]).clearsVertically(segShape)
-                                    : !segShape.clearsVertically(slurRects[i]);
-                if (intersection) {
-                    if (leftSection) {
-                        collision.left = true;
-                    }
-                    if (midSection) {
-                        collision.mid = true;
-                    }
-                    if (rightSection) {
-                        collision.right = true;
-                    }
+                if (midSection) {
+                    collision.mid = true;
+                }
+                if (rightSection) {
+                    collision.right = true;
                 }
             }
         }
@@ -605,6 +648,8 @@ void SlurSegment::avoidCollisions(PointF& pp1, PointF& p2, PointF& p3, PointF& p
 
         ++iter;
     } while ((collision.left || collision.mid || collision.right) && iter < maxIter);
+
+    mutldata()->avoidance = LayoutData::Avoidance { std::move(avoidanceKey), pp1, p2, p3, p4, toSystemCoordinates };
 }
 
 //---------------------------------------------------------
@@ -944,7 +989,7 @@ bool Slur::isDirectionMixture(Chord* c1, Chord* c2)
 
 void Slur::setTrack(track_idx_t n)
 {
-    EngravingItem::setTrack(n);
+    Spanner::setTrack(n);
     for (SpannerSegment* ss : spannerSegments()) {
         ss->setTrack(n);
     }
@@ -23,9 +23,12 @@
 #ifndef __SLUR_H__
 #define __SLUR_H__
 
+#include <optional>
+
 #include "slurtie.h"
 
 #include "global/allocator.h"
+#include "draw/types/transform.h"
 
 namespace mu::engraving {
 //---------------------------------------------------------
@@ -61,6 +64,46 @@ public:
     Shape getSegmentShape(Segment* seg, ChordRest* startCR, ChordRest* endCR);
     void avoidCollisions(PointF& pp1, PointF& p2, PointF& p3, PointF& p4, mu::draw::Transform& toSystemCoordinates, double& slurAngle);
 
+    struct LayoutData : public EngravingItem::LayoutData {
+        //! NOTE The result of the last avoidCollisions, with everything it was computed from:
+        //! the slur points and parameters and the shapes it avoided. Laid out again unchanged,
+        //! the slur takes it over
+        struct AvoidanceKey {
+            PointF pp1;
+            PointF p2;
+            PointF p3;
+            PointF p4;
+            double slurAngle = 0.0;
+            double leftBalance = 0.0;
+            double rightBalance = 0.0;
+            double step = 0.0;
+            double vertClearance = 0.0;
+            bool up = false;
+            bool endPointsEdited = false;
+            std::vector<RectF> obstacles;
+
+            bool operator==(const AvoidanceKey& k) const;
+        };
+
+        struct Avoidance {
+            AvoidanceKey key;
+            PointF pp1;
+            PointF p2;
+            PointF p3;
+            PointF p4;
+            mu::draw::Transform toSystemCoordinates;
+        };
+
+        std::optional<Avoidance> avoidance;
+
+        void reset() override
+        {
+            EngravingItem::LayoutData::reset();
+            avoidance.reset();
+        }
+    };
+    DECLARE_LAYOUTDATA_METHODS(SlurSegment)
+
 protected:
     void changeAnchor(EditData&, EngravingItem*) override;
     double m_extraHeight = 0.0;
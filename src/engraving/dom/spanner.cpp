@@ -1289,7 +1289,26 @@ void Spanner::setTick(const Fraction& v)
     Score* score = this->score();
 
     if (score) {
-        score->spannerMap().setDirty();
+        score->spannerMap().updateSpanner(this);
+    }
+}
+
+//---------------------------------------------------------
+//   setTrack
+//---------------------------------------------------------
+
+void Spanner::setTrack(track_idx_t v)
+{
+    if (track() == v) {
+        return;
+    }
+
+    EngravingItem::setTrack(v);
+
+    Score* score = this->score();
+
+    if (score) {
+        score->spannerMap().updateSpanner(this);
     }
 }
 
@@ -1317,7 +1336,7 @@ void Spanner::setTicks(const Fraction& f)
     Score* score = this->score();
 
     if (score) {
-        score->spannerMap().setDirty();
+        score->spannerMap().updateSpanner(this);
     }
 }
 
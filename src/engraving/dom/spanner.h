@@ -164,6 +164,8 @@ public:
     Fraction tick2() const { return m_tick + m_ticks; }
     Fraction ticks() const { return m_ticks; }
 
+    void setTrack(track_idx_t v) override;
+
     void setTick(const Fraction&);
     void setTick2(const Fraction&);
     void setTicks(const Fraction&);
@@ -29,6 +29,256 @@
 using namespace mu;
 
 namespace mu::engraving {
+//---------------------------------------------------------
+//   SpannerIntervalTree
+//---------------------------------------------------------
+
+void SpannerIntervalTree::pull(int n)
+{
+    Node& node = m_nodes[n];
+    node.height = 1 + std::max(height(node.left), height(node.right));
+    node.maxStop = node.stop;
+    if (node.left != NIL) {
+        node.maxStop = std::max(node.maxStop, m_nodes[node.left].maxStop);
+    }
+    if (node.right != NIL) {
+        node.maxStop = std::max(node.maxStop, m_nodes[node.right].maxStop);
+    }
+}
+
+int SpannerIntervalTree::rotateLeft(int n)
+{
+    int r = m_nodes[n].right;
+    m_nodes[n].right = m_nodes[r].left;
+    m_nodes[r].left = n;
+    pull(n);
+    pull(r);
+    return r;
+}
+
+int SpannerIntervalTree::rotateRight(int n)
+{
+    int l = m_nodes[n].left;
+    m_nodes[n].left = m_nodes[l].right;
+    m_nodes[l].right = n;
+    pull(n);
+    pull(l);
+    return l;
+}
+
+int SpannerIntervalTree::rebalance(int n)
+{
+    pull(n);
+
+    const int balance = height(m_nodes[n].left) - height(m_nodes[n].right);
+    if (balance > 1) {
+        const int l = m_nodes[n].left;
+        if (height(m_nodes[l].left) < height(m_nodes[l].right)) {
+            m_nodes[n].left = rotateLeft(l);
+        }
+        return rotateRight(n);
+    }
+    if (balance < -1) {
+        const int r = m_nodes[n].right;
+        if (height(m_nodes[r].right) < height(m_nodes[r].left)) {
+            m_nodes[n].right = rotateRight(r);
+        }
+        return rotateLeft(n);
+    }
+
+    return n;
+}
+
+int SpannerIntervalTree::insertNode(int n, int node)
+{
+    if (n == NIL) {
+        return node;
+    }
+
+    if (m_nodes[node].key < m_nodes[n].key) {
+        const int l = insertNode(m_nodes[n].left, node);
+        m_nodes[n].left = l;
+    } else {
+        const int r = insertNode(m_nodes[n].right, node);
+        m_nodes[n].right = r;
+    }
+
+    return rebalance(n);
+}
+
+int SpannerIntervalTree::eraseMin(int n, int& min)
+{
+    if (m_nodes[n].left == NIL) {
+        min = n;
+        return m_nodes[n].right;
+    }
+
+    const int l = eraseMin(m_nodes[n].left, min);
+    m_nodes[n].left = l;
+    return rebalance(n);
+}
+
+int SpannerIntervalTree::eraseNode(int n, const Key& key, int& erased)
+{
+    if (n == NIL) {
+        return NIL;
+    }
+
+    if (key < m_nodes[n].key) {
+        const int l = eraseNode(m_nodes[n].left, key, erased);
+        m_nodes[n].left = l;
+    } else if (m_nodes[n].key < key) {
+        const int r = eraseNode(m_nodes[n].right, key, erased);
+        m_nodes[n].right = r;
+    } else {
+        erased = n;
+
+        const int l = m_nodes[n].left;
+        const int r = m_nodes[n].right;
+        if (r == NIL) {
+            return l;
+        }
+
+        int min = NIL;
+        const int rest = eraseMin(r, min);
+        m_nodes[min].left = l;
+        m_nodes[min].right = rest;
+        return rebalance(min);
+    }
+
+    return rebalance(n);
+}
+
+bool SpannerIntervalTree::setStop(int n, const Key& key, int stop)
+{
+    if (n == NIL) {
+        return false;
+    }
+
+    bool found = true;
+    if (key < m_nodes[n].key) {
+        found = setStop(m_nodes[n].left, key, stop);
+    } else if (m_nodes[n].key < key) {
+        found = setStop(m_nodes[n].right, key, stop);
+    } else {
+        m_nodes[n].stop = stop;
+    }
+
+    if (found) {
+        pull(n);
+    }
+    return found;
+}
+
+void SpannerIntervalTree::insert(const Key& key, int stop, Spanner* value)
+{
+    int node = NIL;
+    if (m_freeNodes.empty()) {
+        node = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    } else {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+
+    Node& n = m_nodes[node];
+    n.key = key;
+    n.stop = stop;
+    n.maxStop = stop;
+    n.value = value;
+    n.left = NIL;
+    n.right = NIL;
+    n.height = 1;
+
+    m_root = insertNode(m_root, node);
+    ++m_size;
+}
+
+bool SpannerIntervalTree::erase(const Key& key)
+{
+    int erased = NIL;
+    m_root = eraseNode(m_root, key, erased);
+    if (erased == NIL) {
+        return false;
+    }
+
+    m_nodes[erased].value = nullptr;
+    m_freeNodes.push_back(erased);
+    --m_size;
+    return true;
+}
+
+bool SpannerIntervalTree::setStop(const Key& key, int stop)
+{
+    return setStop(m_root, key, stop);
+}
+
+void SpannerIntervalTree::clear()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_root = NIL;
+    m_size = 0;
+}
+
+void SpannerIntervalTree::appendInterval(const Node& node, IntervalList& result)
+{
+    //! NOTE Interval's constructor swaps start and stop; keep the stop of
+    //! collision-free intervals even if they were cut before their start
+    result.emplace_back(node.key.start, node.key.start, node.value);
+    result.back().stop = node.stop;
+}
+
+void SpannerIntervalTree::findOverlapping(int n, int start, int stop, IntervalList& result) const
+{
+    if (n == NIL || m_nodes[n].maxStop < start) {
+        return;
+    }
+
+    const Node& node = m_nodes[n];
+    findOverlapping(node.left, start, stop, result);
+
+    if (node.key.start > stop) {
+        return;
+    }
+    if (node.stop >= start) {
+        appendInterval(node, result);
+    }
+
+    findOverlapping(node.right, start, stop, result);
+}
+
+void SpannerIntervalTree::findContained(int n, int start, int stop, IntervalList& result) const
+{
+    if (n == NIL) {
+        return;
+    }
+
+    const Node& node = m_nodes[n];
+    if (node.key.start >= start) {
+        findContained(node.left, start, stop, result);
+    }
+
+    if (node.key.start > stop) {
+        return;
+    }
+    if (node.key.start >= start && node.stop <= stop) {
+        appendInterval(node, result);
+    }
+
+    findContained(node.right, start, stop, result);
+}
+
+void SpannerIntervalTree::findOverlapping(int start, int stop, IntervalList& result) const
+{
+    findOverlapping(m_root, start, stop, result);
+}
+
+void SpannerIntervalTree::findContained(int start, int stop, IntervalList& result) const
+{
+    findContained(m_root, start, stop, result);
+}
+
 //---------------------------------------------------------
 //   SpannerMap
 //---------------------------------------------------------
@@ -36,68 +286,79 @@ namespace mu::engraving {
 SpannerMap::SpannerMap()
     : std::multimap<int, Spanner*>()
 {
-    dirty = true;
 }
 
 //---------------------------------------------------------
 //   update
-//   updates the internal lookup tree, not the map itself
+//   rebuilds the internal lookup trees, not the map itself
 //---------------------------------------------------------
 
-void SpannerMap::update() const
+void SpannerMap::update()
 {
-    IntervalList regularIntervals;
-    IntervalList collisionFreeIntervals;
-
-    collectIntervals(regularIntervals, collisionFreeIntervals);
+    m_tree.clear();
+    m_collisionFreeTree.clear();
+    m_groups.clear();
 
-    tree = interval_tree::IntervalTree<Spanner*>(std::move(regularIntervals));
-    collisionFreeTree = interval_tree::IntervalTree<Spanner*>(std::move(collisionFreeIntervals));
-    dirty = false;
+    for (const auto& pair : *this) {
+        Spanner* spanner = pair.second;
+        attach(spanner, m_entries.at(spanner));
+    }
 }
 
 //---------------------------------------------------------
 //   findContained
 //---------------------------------------------------------
 
-const SpannerMap::IntervalList& SpannerMap::findContained(int start, int stop, bool excludeCollisions) const
+void SpannerMap::findContained(int start, int stop, IntervalList& result, bool excludeCollisions) const
 {
-    if (dirty) {
-        update();
-    }
-
-    results.clear();
+    result.clear();
 
     if (excludeCollisions) {
-        results = collisionFreeTree.findContained(start, stop);
+        m_collisionFreeTree.findContained(start, stop, result);
     } else {
-        results = tree.findContained(start, stop);
+        m_tree.findContained(start, stop, result);
     }
+}
 
-    return results;
+SpannerMap::IntervalList SpannerMap::findContained(int start, int stop, bool excludeCollisions) const
+{
+    IntervalList result;
+    findContained(start, stop, result, excludeCollisions);
+    return result;
 }
 
 //---------------------------------------------------------
 //   findOverlapping
 //---------------------------------------------------------
 
-const SpannerMap::IntervalList& SpannerMap::findOverlapping(int start, int stop, bool excludeCollisions) const
+void SpannerMap::findOverlapping(int start, int stop, IntervalList& result, bool excludeCollisions) const
 {
-    if (dirty) {
-        update();
-    }
-
-    results.clear();
+    result.clear();
 
     if (excludeCollisions) {
-        results = collisionFreeTree.findOverlapping(start, stop);
+        m_collisionFreeTree.findOverlapping(start, stop, result);
     } else {
-        results = tree.findOverlapping(start, stop);
+        m_tree.findOverlapping(start, stop, result);
     }
+}
 
-    return results;
+SpannerMap::IntervalList SpannerMap::findOverlapping(int start, int stop, bool excludeCollisions) const
+{
+    IntervalList result;
+    findOverlapping(start, stop, result, excludeCollisions);
+    return result;
 }
 
+//!Note Because of the current UX of spanners adjustments spanners collision is a regular thing,
+//!     so we have to manage those cases when two similar spanners (e.g. Pedal line) are overlapping
+//!     with each other.
+static constexpr int COLLIDING_SPANNERS_PADDING = 1;
+
+//---------------------------------------------------------
+//   collectIntervals
+//   computes all intervals from scratch, in map order
+//---------------------------------------------------------
+
 void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const
 {
     using IntervalsByType = std::map<ElementType, IntervalList>;
@@ -105,11 +366,6 @@ void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList&
 
     IntervalsByPart intervalsByPart;
 
-    //!Note Because of the current UX of spanners adjustments spanners collision is a regular thing,
-    //!     so we have to manage those cases when two similar spanners (e.g. Pedal line) are overlapping
-    //!     with each other.
-    constexpr int collidingSpannersPadding = 1;
-
     for (const auto& pair : *this) {
         Spanner* spanner = pair.second;
 
@@ -123,7 +379,7 @@ void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList&
             auto lastIntervalIt = intervalList.rbegin();
             if (lastIntervalIt->stop >= newSpannerStartTick) {
                 if (!lastIntervalIt->value->isLinked(spanner)) {
-                    lastIntervalIt->stop = newSpannerStartTick - collidingSpannersPadding;
+                    lastIntervalIt->stop = newSpannerStartTick - COLLIDING_SPANNERS_PADDING;
                 }
             }
         }
@@ -146,14 +402,107 @@ void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList&
     }
 }
 
+//---------------------------------------------------------
+//   collisionFreeStop
+//   a spanner is cut right before the start of the next similar
+//   spanner of the same part it collides with (see collectIntervals)
+//---------------------------------------------------------
+
+int SpannerMap::collisionFreeStop(const Group& group, Group::const_iterator it, int stop)
+{
+    auto next = std::next(it);
+    if (next == group.cend()) {
+        return stop;
+    }
+
+    if (stop >= next->first.start && !it->second->isLinked(next->second)) {
+        return next->first.start - COLLIDING_SPANNERS_PADDING;
+    }
+
+    return stop;
+}
+
+void SpannerMap::updateCollisionFreeStop(const Group& group, Group::const_iterator it)
+{
+    Entry& e = m_entries.at(it->second);
+    int stop = collisionFreeStop(group, it, e.stop);
+    if (stop != e.collisionFreeStop) {
+        e.collisionFreeStop = stop;
+        m_collisionFreeTree.setStop(e.key, stop);
+    }
+}
+
+//---------------------------------------------------------
+//   attach
+//   inserts the spanner into the lookup trees
+//---------------------------------------------------------
+
+void SpannerMap::attach(Spanner* s, Entry& e)
+{
+    e.key.start = std::min(s->tick().ticks(), s->tick2().ticks());
+    e.stop = std::max(s->tick().ticks(), s->tick2().ticks());
+    e.group = GroupKey(s->part(), s->type());
+
+    m_tree.insert(e.key, e.stop, s);
+
+    Group& group = m_groups[e.group];
+    auto it = group.emplace(e.key, s).first;
+
+    e.collisionFreeStop = collisionFreeStop(group, it, e.stop);
+    m_collisionFreeTree.insert(e.key, e.collisionFreeStop, s);
+
+    if (it != group.begin()) {
+        updateCollisionFreeStop(group, std::prev(it));
+    }
+}
+
+//---------------------------------------------------------
+//   detach
+//   removes the spanner from the lookup trees
+//---------------------------------------------------------
+
+void SpannerMap::detach(Entry& e)
+{
+    m_tree.erase(e.key);
+    m_collisionFreeTree.erase(e.key);
+
+    auto groupIt = m_groups.find(e.group);
+    IF_ASSERT_FAILED(groupIt != m_groups.end()) {
+        return;
+    }
+
+    Group& group = groupIt->second;
+    auto it = group.find(e.key);
+    IF_ASSERT_FAILED(it != group.end()) {
+        return;
+    }
+
+    const bool hasPrev = it != group.begin();
+    auto prev = hasPrev ? std::prev(it) : group.end();
+    group.erase(it);
+
+    if (hasPrev) {
+        updateCollisionFreeStop(group, prev);
+    } else if (group.empty()) {
+        m_groups.erase(groupIt);
+    }
+}
+
 //---------------------------------------------------------
 //   addSpanner
 //---------------------------------------------------------
 
 void SpannerMap::addSpanner(Spanner* s)
 {
-    insert(std::pair<int, Spanner*>(s->tick().ticks(), s));
-    dirty = true;
+    if (m_entries.find(s) != m_entries.end()) {
+        LOGD("%s (%p) already added", s->typeName(), s);
+        return;
+    }
+
+    Entry& e = m_entries[s];
+    e.it = insert(std::pair<int, Spanner*>(s->tick().ticks(), s));
+    e.key.seq = m_nextSeq++;
+    attach(s, e);
 }
 
 //---------------------------------------------------------
@@ -162,15 +511,52 @@ void SpannerMap::addSpanner(Spanner* s)
 
 bool SpannerMap::removeSpanner(Spanner* s)
 {
-    for (auto i = begin(); i != end(); ++i) {
-        if (i->second == s) {
-            erase(i);
-            dirty = true;
-            return true;
-        }
+    auto entryIt = m_entries.find(s);
+    if (entryIt == m_entries.end()) {
+        LOGD("%s (%p) not found", s->typeName(), s);
+        return false;
+    }
+
+    detach(entryIt->second);
+    erase(entryIt->second.it);
+    m_entries.erase(entryIt);
+    return true;
+}
+
+//---------------------------------------------------------
+//   updateSpanner
+//   O(log n); spanners not in the map are ignored
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(Spanner* s)
+{
+    auto entryIt = m_entries.find(s);
+    if (entryIt == m_entries.end()) {
+        return;
+    }
+
+    Entry& e = entryIt->second;
+    const int start = std::min(s->tick().ticks(), s->tick2().ticks());
+    const int stop = std::max(s->tick().ticks(), s->tick2().ticks());
+    if (e.key.start == start && e.stop == stop && e.group == GroupKey(s->part(), s->type())) {
+        return;
     }
-    LOGD("%s (%p) not found", s->typeName(), s);
-    return false;
+
+    detach(e);
+    attach(s, e);
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+{
+    std::multimap<int, Spanner*>::clear();
+    m_entries.clear();
+    m_groups.clear();
+    m_tree.clear();
+    m_collisionFreeTree.clear();
 }
 
 #ifndef NDEBUG
@@ -23,34 +23,112 @@
 #ifndef __SPANNERMAP_H__
 #define __SPANNERMAP_H__
 
+#include <cstdint>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "thirdparty/intervaltree/IntervalTree.h"
 
+#include "types/types.h"
+
 namespace mu::engraving {
+class Part;
 class Spanner;
 
+//---------------------------------------------------------
+//   SpannerIntervalTree
+//    balanced (AVL) binary search tree of intervals ordered
+//    by start tick, each node augmented with the largest stop
+//    tick of its subtree; insert, erase and stop updates are
+//    O(log n), queries are O(log n + k)
+//---------------------------------------------------------
+
+class SpannerIntervalTree
+{
+public:
+    using Interval = interval_tree::Interval<Spanner*>;
+    using IntervalList = std::vector<Interval>;
+
+    //! NOTE Intervals with the same start are kept in the order they were added (seq)
+    struct Key {
+        int start = 0;
+        uint64_t seq = 0;
+
+        bool operator<(const Key& other) const
+        {
+            return start < other.start || (start == other.start && seq < other.seq);
+        }
+    };
+
+    void insert(const Key& key, int stop, Spanner* value);
+    bool erase(const Key& key);
+    bool setStop(const Key& key, int stop);
+    void clear();
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    //! NOTE Results are appended to `result` in ascending start order;
+    //! an interval is contained if its start lies in [start, stop] and it doesn't stop after `stop`
+    void findOverlapping(int start, int stop, IntervalList& result) const;
+    void findContained(int start, int stop, IntervalList& result) const;
+
+private:
+    static constexpr int NIL = -1;
+
+    struct Node {
+        Key key;
+        int stop = 0;
+        int maxStop = 0;
+        Spanner* value = nullptr;
+        int left = NIL;
+        int right = NIL;
+        int height = 1;
+    };
+
+    int height(int n) const { return n == NIL ? 0 : m_nodes[n].height; }
+    void pull(int n);
+    int rotateLeft(int n);
+    int rotateRight(int n);
+    int rebalance(int n);
+
+    int insertNode(int n, int node);
+    int eraseNode(int n, const Key& key, int& erased);
+    int eraseMin(int n, int& min);
+    bool setStop(int n, const Key& key, int stop);
+
+    static void appendInterval(const Node& node, IntervalList& result);
+    void findOverlapping(int n, int start, int stop, IntervalList& result) const;
+    void findContained(int n, int start, int stop, IntervalList& result) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<int> m_freeNodes;
+    int m_root = NIL;
+    size_t m_size = 0;
+};
+
 //---------------------------------------------------------
 //   SpannerMap
 //---------------------------------------------------------
 
 class SpannerMap : std::multimap<int, Spanner*>
 {
-    mutable bool dirty;
-    mutable interval_tree::IntervalTree<Spanner*> tree;
-    mutable interval_tree::IntervalTree<Spanner*> collisionFreeTree;
-    mutable std::vector<interval_tree::Interval<Spanner*> > results;
-
 public:
     typedef typename std::multimap<int, Spanner*>::const_reverse_iterator const_reverse_it;
     typedef typename std::multimap<int, Spanner*>::const_iterator const_it;
 
-    using IntervalList = std::vector<interval_tree::Interval<Spanner*> >;
+    using IntervalList = SpannerIntervalTree::IntervalList;
 
     SpannerMap();
 
-    const IntervalList& findContained(int start, int stop, bool excludeCollisions = false) const;
-    const IntervalList& findOverlapping(int start, int stop, bool excludeCollisions = false) const;
+    //! NOTE These overloads clear `result` and fill it; they don't touch any shared state,
+    //! so they may be called concurrently as long as nobody modifies the map meanwhile
+    void findContained(int start, int stop, IntervalList& result, bool excludeCollisions = false) const;
+    void findOverlapping(int start, int stop, IntervalList& result, bool excludeCollisions = false) const;
+
+    IntervalList findContained(int start, int stop, bool excludeCollisions = false) const;
+    IntervalList findOverlapping(int start, int stop, bool excludeCollisions = false) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
 
     void collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const;
@@ -61,13 +139,36 @@ public:
     const_it cend() const { return std::multimap<int, Spanner*>::cend(); }
     void addSpanner(Spanner* s);
     bool removeSpanner(Spanner* s);
-    void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
+    void updateSpanner(Spanner* s);     // must be called if a spanner changes start/length or part
+    void clear();
     bool empty() const { return std::multimap<int, Spanner*>::empty(); }
-    void update() const;
-    void setDirty() const { dirty = true; }     // must be called if a spanner changes start/length
+    void update();                      // rebuilds the lookup trees from scratch
 #ifndef NDEBUG
     void dump() const;
 #endif
+
+private:
+    using GroupKey = std::pair<const Part*, ElementType>;
+    using Group = std::map<SpannerIntervalTree::Key, Spanner*>;
+
+    struct Entry {
+        std::multimap<int, Spanner*>::iterator it;
+        SpannerIntervalTree::Key key;
+        int stop = 0;
+        int collisionFreeStop = 0;
+        GroupKey group;
+    };
+
+    void attach(Spanner* s, Entry& e);
+    void detach(Entry& e);
+    void updateCollisionFreeStop(const Group& group, Group::const_iterator it);
+    static int collisionFreeStop(const Group& group, Group::const_iterator it, int stop);
+
+    std::unordered_map<const Spanner*, Entry> m_entries;
+    std::map<GroupKey, Group> m_groups;
+    SpannerIntervalTree m_tree;
+    SpannerIntervalTree m_collisionFreeTree;
+    uint64_t m_nextSeq = 0;
 };
 } // namespace mu::engraving
 
@@ -226,7 +226,7 @@ void Trill::remove(EngravingItem* e)
 
 void Trill::setTrack(track_idx_t n)
 {
-    EngravingItem::setTrack(n);
+    Spanner::setTrack(n);
 
     for (SpannerSegment* ss : spannerSegments()) {
         ss->setTrack(n);
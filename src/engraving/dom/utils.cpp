@@ -58,6 +58,21 @@ RectF handleRect(const PointF& pos)
     return RectF(pos.x() - 4, pos.y() - 4, 8, 8);
 }
 
+//---------------------------------------------------------
+//   tickIndex
+//    return the measure tick index, rebuilding it if the
+//    measure list changed since the last lookup.
+//    Thread safe, see MeasureTickIndex
+//---------------------------------------------------------
+
+const MeasureTickIndex& Score::tickIndex(bool useMMrest) const
+{
+    MeasureTickIndex& index = m_measures.tickIndex(useMMrest);
+    bool withMMRests = useMMrest && style().styleB(Sid::createMultiMeasureRests);
+    index.ensureBuilt(useMMrest ? firstMeasureMM() : firstMeasure(), useMMrest, withMMRests);
+    return index;
+}
+
 //---------------------------------------------------------
 //   tick2measure
 //---------------------------------------------------------
@@ -71,6 +86,16 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
+    const MeasureTickIndex& index = tickIndex(false);
+    if (index.isSorted()) {
+        Measure* m = index.measureAt(tick);
+        if (!m) {
+            LOGD("tick2measure %d not found", tick.ticks());
+        }
+        return m;
+    }
+
+    // measure ticks are not in order (e.g. in the middle of an edit), walk the list
     Measure* lm = 0;
     for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
         if (tick < m->tick()) {
@@ -101,6 +126,15 @@ Measure* Score::tick2measureMM(const Fraction& t) const
         tick = Fraction(0, 1);
     }
 
+    const MeasureTickIndex& index = tickIndex(true);
+    if (index.isSorted()) {
+        Measure* m = index.measureAt(tick);
+        if (!m) {
+            LOGD("tick2measureMM %d not found", tick.ticks());
+        }
+        return m;
+    }
+
     Measure* lm = 0;
 
     for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
@@ -124,6 +158,15 @@ Measure* Score::tick2measureMM(const Fraction& t) const
 
 MeasureBase* Score::tick2measureBase(const Fraction& tick) const
 {
+    // frames have no length, so only a measure can contain the tick
+    const MeasureTickIndex& index = tickIndex(false);
+    if (index.isSorted()) {
+        Measure* m = index.measureAt(tick);
+        if (m && tick >= m->tick() && tick < m->endTick()) {
+            return m;
+        }
+    }
+
     for (MeasureBase* mb = first(); mb; mb = mb->next()) {
         Fraction st = mb->tick();
         Fraction l  = mb->ticks();
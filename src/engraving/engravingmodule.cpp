@@ -42,6 +42,7 @@
 #include "engraving/dom/mscore.h"
 #include "engraving/dom/masterscore.h"
 
+#include "rendering/layoutprofiler.h"
 #include "rendering/dev/scorerenderer.h"
 #include "rendering/stable/scorerenderer.h"
 #include "rendering/single/singlerenderer.h"
@@ -89,6 +90,8 @@ Versions:
     //ioc()->registerExport<rendering::IScoreRenderer>(moduleName(), new rendering::stable::ScoreRenderer());
 
     ioc()->registerExport<rendering::ISingleRenderer>(moduleName(), new rendering::single::SingleRenderer());
+
+    ioc()->registerExport<rendering::ILayoutProfiler>(moduleName(), new rendering::LayoutProfiler());
 }
 
 void EngravingModule::resolveImports()
@@ -0,0 +1,47 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_LAYOUTSCHEDULER_H
+#define MU_ENGRAVING_LAYOUTSCHEDULER_H
+
+#include <algorithm>
+#include <thread>
+
+#include "concurrency/taskscheduler.h"
+
+namespace mu::engraving {
+//! NOTE The pool that the work of a layout pass is spread over (see PassLayoutIndependentItems).
+//! A pool of its own, so that layout never waits behind audio tasks.
+//! The calling thread takes part in the work, hence one thread less.
+//! Work that already runs on one of its threads must not wait for the pool again, see isLayoutThread()
+inline TaskScheduler* layoutScheduler()
+{
+    static TaskScheduler s(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    return &s;
+}
+
+inline bool isLayoutThread()
+{
+    return layoutScheduler()->containsThread(std::this_thread::get_id());
+}
+}
+
+#endif // MU_ENGRAVING_LAYOUTSCHEDULER_H
@@ -22,6 +22,8 @@
 
 #include "skyline.h"
 
+#include <algorithm>
+
 #include "realfn.h"
 #include "draw/painter.h"
 
@@ -145,12 +147,29 @@ SkylineLine::SegConstIter SkylineLine::find(double x) const
     return const_cast<SkylineLine*>(this)->find(x);
 }
 
+//---------------------------------------------------------
+//   reserve
+//    room for n more segments, keeping the growth geometric
+//---------------------------------------------------------
+
+void SkylineLine::reserve(size_t n)
+{
+    size_t needed = seg.size() + n;
+    if (needed <= seg.capacity()) {
+        return;
+    }
+    needed = std::max(needed, 2 * seg.capacity());
+    seg.reserve(needed);
+}
+
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
 
 void SkylineLine::add(const Shape& s)
 {
+    // every element adds at most two segments
+    reserve(2 * s.elements().size());
     for (const auto& r : s.elements()) {
         add(r);
     }
@@ -167,30 +186,89 @@ void SkylineLine::add(const ShapeElement& r)
 
 void Skyline::add(const Shape& s)
 {
+    _north.reserve(2 * s.elements().size());
+    _south.reserve(2 * s.elements().size());
     for (const auto& r : s.elements()) {
         add(r);
     }
 }
 
 void SkylineLine::add(double x, double y, double w)
+{
+    size_t changed = doAdd(x, y, w);
+    if (changed < m_sumsCount) {
+        m_sumsCount = changed;
+        m_sumsSorted = true;
+    }
+}
+
+//---------------------------------------------------------
+//   sumsUntil
+//    Extends the cached running sums until they reach x and
+//    returns the index of the first segment ending at or
+//    after x, size() if there is none, or mu::nidx if a
+//    negative width makes the sums unusable for search.
+//    The widths are summed up in the same order as
+//    minDistance() walks the segments, so both agree bit
+//    for bit.
+//---------------------------------------------------------
+
+size_t SkylineLine::sumsUntil(double x) const
+{
+    const size_t n = seg.size();
+    if (m_ends.size() != n) {
+        m_ends.resize(n);
+        m_minY.resize(n);
+        m_maxY.resize(n);
+    }
+
+    while (m_sumsSorted && m_sumsCount < n && (m_sumsCount == 0 || m_ends[m_sumsCount - 1] < x)) {
+        const size_t i = m_sumsCount;
+        const SkylineSegment& s = seg[i];
+        if (s.w < 0.0) {
+            m_sumsSorted = false;
+            break;
+        }
+        m_ends[i] = (i > 0 ? m_ends[i - 1] : 0.0) + s.w;
+        m_minY[i] = i > 0 ? std::min(m_minY[i - 1], s.y) : s.y;
+        m_maxY[i] = i > 0 ? std::max(m_maxY[i - 1], s.y) : s.y;
+        ++m_sumsCount;
+    }
+
+    if (!m_sumsSorted) {
+        return mu::nidx;
+    }
+    return std::lower_bound(m_ends.begin(), m_ends.begin() + m_sumsCount, x) - m_ends.begin();
+}
+
+//---------------------------------------------------------
+//   doAdd
+//    returns the index of the first segment changed
+//---------------------------------------------------------
+
+size_t SkylineLine::doAdd(double x, double y, double w)
 {
 //      assert(w >= 0.0);
     if (x < 0.0) {
         w -= -x;
         x = 0.0;
         if (w <= 0.0) {
-            return;
+            return seg.size();
         }
     }
 
     DP("===add  %f %f %f\n", x, y, w);
 
     SegIter i = find(x);
+    size_t changed = seg.size();
+    auto markChanged = [this, &changed](SegIter it) {
+        changed = std::min(changed, static_cast<size_t>(std::distance(seg.begin(), it)));
+    };
     double cx = seg.empty() ? 0.0 : i->x;
     for (; i != seg.end(); ++i) {
         double cy = i->y;
         if ((x + w) <= cx) {                                            // A
-            return;       // break;
+            return changed;       // break;
         }
         if (x > (cx + i->w)) {                                          // B
             cx += i->w;
@@ -205,6 +283,7 @@ void SkylineLine::add(double x, double y, double w)
             double w1 = x - cx;
             double w2 = w;
             double w3 = i->w - (w1 + w2);
+            markChanged(i);
             if (w1 > 0.0000001) {
                 i->w = w1;
                 ++i;
@@ -220,20 +299,23 @@ void SkylineLine::add(double x, double y, double w)
                 DP("       C w3 %f\n", w3);
                 insert(i, x + w2, cy, w3);
             }
-            return;
+            return changed;
         } else if ((x <= cx) && ((x + w) >= (cx + i->w))) {                 // F
             DP("    change(F) cx %f y %f\n", cx, y);
+            markChanged(i);
             i->y = y;
         } else if (x < cx) {                                            // C
             double w1 = x + w - cx;
+            markChanged(i);
             i->w    -= w1;
             DP("    add(C) cx %f y %f w %f w1 %f\n", cx, y, w1, i->w);
             insert(i, cx, y, w1);
-            return;
+            return changed;
         } else {                                                        // D
             double w1 = x - cx;
             double w2 = i->w - w1;
             if (w2 > 0.0000001) {
+                markChanged(i);
                 i->w = w1;
                 cx  += w1;
                 DP("    add(D) %f %f\n", y, w2);
@@ -243,6 +325,7 @@ void SkylineLine::add(double x, double y, double w)
         }
         cx += i->w;
     }
+    changed = std::min(changed, seg.size());
     if (x >= cx) {
         if (x > cx) {
             double cy = north ? MAXIMUM_Y : MINIMUM_Y;
@@ -254,6 +337,7 @@ void SkylineLine::add(double x, double y, double w)
     } else if (x + w > cx) {
         append(cx, y, x + w - cx);
     }
+    return changed;
 }
 
 //---------------------------------------------------------
@@ -266,6 +350,14 @@ void Skyline::clear()
     _south.clear();
 }
 
+//! NOTE Keeps the capacity, so that rebuilding a skyline reuses its buffers
+void SkylineLine::clear()
+{
+    seg.clear();
+    m_sumsCount = 0;
+    m_sumsSorted = true;
+}
+
 //-------------------------------------------------------------------
 //   minDistance
 //    a is located below this skyline.
@@ -283,8 +375,39 @@ double SkylineLine::minDistance(const SkylineLine& sl) const
 
     double x1 = 0.0;
     double x2 = 0.0;
+    auto i   = begin();
     auto k   = sl.begin();
-    for (auto i = begin(); i != end(); ++i) {
+
+    // Fast path for the leading run of segments on one line facing the first
+    // segment of the other one. It visits the same segment pairs as the walk
+    // below and takes the maximum of the same differences (rounding is
+    // monotonic), then hands over the state the walk would have reached.
+    if (!seg.empty() && !sl.seg.empty() && seg.front().w > 0.0 && sl.seg.front().w > 0.0) {
+        if (seg.front().w > sl.seg.front().w) {
+            // the first segment of this line faces a run of sl
+            const double xr = seg.front().w;
+            const size_t last = sl.sumsUntil(xr);
+            if (last == sl.seg.size()) {
+                return std::max(dist, seg.front().y - sl.m_minY[last - 1]);
+            } else if (last != mu::nidx) {
+                dist = std::max(dist, seg.front().y - sl.m_minY[last]);
+                x1 = xr;
+                x2 = sl.m_ends[last - 1];
+                ++i;
+                k += last;
+            }
+        } else {
+            // a run of this line faces the first segment of sl
+            const size_t run = sumsUntil(sl.seg.front().w);
+            if (run != mu::nidx && run > 0) {
+                dist = std::max(dist, m_maxY[run - 1] - sl.seg.front().y);
+                x1 = m_ends[run - 1];
+                i += run;
+            }
+        }
+    }
+
+    for (; i != end(); ++i) {
         while (k != sl.end() && (x2 + k->w) < x1) {
             x2 += k->w;
             ++k;
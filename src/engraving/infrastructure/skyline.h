@@ -50,6 +50,11 @@ struct SkylineSegment {
 
 //---------------------------------------------------------
 //   SkylineLine
+//    Running sums of the widths and running min and max of
+//    y are cached for a prefix of the segments, so that
+//    minDistance() can skip a leading run of segments which
+//    face a single segment of the other line, like the empty
+//    space before an element being autoplaced.
 //---------------------------------------------------------
 
 class SkylineLine
@@ -59,10 +64,19 @@ class SkylineLine
     typedef std::vector<SkylineSegment>::iterator SegIter;
     typedef std::vector<SkylineSegment>::const_iterator SegConstIter;
 
+    // cache
+    mutable std::vector<double> m_ends;
+    mutable std::vector<double> m_minY;
+    mutable std::vector<double> m_maxY;
+    mutable size_t m_sumsCount = 0;
+    mutable bool m_sumsSorted = true;
+
     SegIter insert(SegIter i, double x, double y, double w);
     void append(double x, double y, double w);
     SegIter find(double x);
     SegConstIter find(double x) const;
+    size_t doAdd(double x, double y, double w);
+    size_t sumsUntil(double x) const;
 
 public:
     SkylineLine(bool n)
@@ -72,7 +86,8 @@ public:
     void add(double x, double y, double w);
     void add(const RectF& r) { add(ShapeElement(r)); }
 
-    void clear() { seg.clear(); }
+    void clear();
+    void reserve(size_t n);
     void paint(mu::draw::Painter& painter) const;
     void dump() const;
     double minDistance(const SkylineLine&) const;
@@ -81,9 +96,7 @@ public:
     bool valid(const SkylineSegment& s) const;
     bool isNorth() const { return north; }
 
-    SegIter begin() { return seg.begin(); }
     SegConstIter begin() const { return seg.begin(); }
-    SegIter end() { return seg.end(); }
     SegConstIter end() const { return seg.end(); }
 };
 
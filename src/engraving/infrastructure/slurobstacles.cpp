@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "slurobstacles.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace mu;
+using namespace mu::engraving;
+
+SlurObstacles::SlurObstacles(const std::vector<Shape>& shapes, double cellWidth)
+{
+    for (const Shape& shape : shapes) {
+        for (const ShapeElement& el : shape.elements()) {
+            m_rects.push_back(el);
+        }
+    }
+
+    if (m_rects.empty()) {
+        return;
+    }
+
+    double left = std::numeric_limits<double>::max();
+    double right = std::numeric_limits<double>::lowest();
+    for (const RectF& r : m_rects) {
+        left = std::min(left, std::min(r.left(), r.right()));
+        right = std::max(right, std::max(r.left(), r.right()));
+    }
+
+    //! NOTE Very wide shapes (or a very long slur) must not make a huge grid
+    static constexpr size_t maxCells = 512;
+    m_left = left;
+    m_cellWidth = std::max(cellWidth, (right - left) / maxCells);
+    m_cells.resize(cellIdx(right) + 1);
+
+    for (size_t i = 0; i < m_rects.size(); ++i) {
+        const RectF& r = m_rects.at(i);
+        size_t last = cellIdx(std::max(r.left(), r.right()));
+        for (size_t c = cellIdx(std::min(r.left(), r.right())); c <= last; ++c) {
+            m_cells[c].push_back(i);
+        }
+    }
+}
+
+bool SlurObstacles::collides(const RectF& r, bool up) const
+{
+    if (m_cells.empty()) {
+        return false;
+    }
+
+    double left = std::min(r.left(), r.right());
+    double right = std::max(r.left(), r.right());
+    if (right < m_left) {
+        return false;
+    }
+
+    size_t first = cellIdx(left);
+    size_t last = std::min(cellIdx(right), m_cells.size() - 1);
+    for (size_t c = first; c <= last; ++c) {
+        for (size_t i : m_cells.at(c)) {
+            const RectF& o = m_rects.at(i);
+            if (!mu::engraving::intersects(o.left(), o.right(), r.left(), r.right(), 0.0)) {
+                continue;
+            }
+            bool collision = up ? std::min(o.top(), o.bottom()) <= std::max(r.top(), r.bottom())
+                             : std::min(r.top(), r.bottom()) <= std::max(o.top(), o.bottom());
+            if (collision) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+size_t SlurObstacles::cellIdx(double x) const
+{
+    return x <= m_left ? 0 : static_cast<size_t>((x - m_left) / m_cellWidth);
+}
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_SLUROBSTACLES_H
+#define MU_ENGRAVING_SLUROBSTACLES_H
+
+#include <vector>
+
+#include "draw/types/geometry.h"
+
+#include "shape.h"
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   SlurObstacles
+//    The shapes a slur segment avoids, bucketed by their
+//    horizontal extent, so that checking a part of the slur
+//    only looks at the shapes below or above it instead of
+//    at every shape of every segment the slur spans.
+//---------------------------------------------------------
+
+class SlurObstacles
+{
+public:
+    SlurObstacles(const std::vector<Shape>& shapes, double cellWidth);
+
+    bool empty() const { return m_rects.empty(); }
+    const std::vector<RectF>& rects() const { return m_rects; }
+
+    //! NOTE Same as !Shape(r).clearsVertically(shape) for an up slur and
+    //! !shape.clearsVertically(r) for a down slur, for any of the shapes
+    bool collides(const RectF& r, bool up) const;
+
+private:
+    size_t cellIdx(double x) const;
+
+    std::vector<RectF> m_rects;
+    std::vector<std::vector<size_t> > m_cells;
+    double m_left = 0.0;
+    double m_cellWidth = 1.0;
+};
+}
+
+#endif // MU_ENGRAVING_SLUROBSTACLES_H
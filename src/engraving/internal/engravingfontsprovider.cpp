@@ -102,4 +102,8 @@ void EngravingFontsProvider::loadAllFonts()
     for (std::shared_ptr<EngravingFont>& f : m_symbolFonts) {
         f->ensureLoad();
     }
+
+    //! NOTE Resolve the fallback font now rather than on first use,
+    //! symbol lookups may come from several layout threads at once
+    doFallbackFont();
 }
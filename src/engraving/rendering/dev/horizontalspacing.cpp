@@ -45,39 +45,71 @@ double HorizontalSpacing::minHorizontalDistance(const Shape& f, const Shape& s,
     double dist = -1000000.0;        // min real
     double absoluteMinPadding = 0.1 * spatium * squeezeFactor;
     double verticalClearance = 0.2 * spatium * squeezeFactor;
+
+    // A pair in which one of the elements has no item is never kerned and gets
+    // no padding, so for such pairs only the right-most edge of f matters.
+    bool fHasElements = false;
+    bool fHasElementsWithoutItem = false;
+    double fRight = dist;
+    double fRightWithoutItem = dist;
+    for (const ShapeElement& r1 : f.elements()) {
+        if (r1.isNull()) {
+            continue;
+        }
+        fHasElements = true;
+        fRight = std::max(fRight, r1.right());
+        if (!r1.item()) {
+            fHasElementsWithoutItem = true;
+            fRightWithoutItem = std::max(fRightWithoutItem, r1.right());
+        }
+    }
+    if (!fHasElements) {
+        return dist;
+    }
+
     for (const ShapeElement& r2 : s.elements()) {
         if (r2.isNull()) {
             continue;
         }
         const EngravingItem* item2 = r2.item();
+        double bx1 = r2.left();
+        if (!item2) {
+            dist = std::max(dist, fRight - bx1);
+            continue;
+        }
+        if (fHasElementsWithoutItem) {
+            dist = std::max(dist, fRightWithoutItem - bx1);
+        }
+
         double by1 = r2.top();
         double by2 = r2.bottom();
+        bool zeroWidth2 = r2.width() == 0; // Temporary hack: shapes of zero-width are assumed to collide with everything
         for (const ShapeElement& r1 : f.elements()) {
-            if (r1.isNull()) {
-                continue;
-            }
             const EngravingItem* item1 = r1.item();
-            double ay1 = r1.top();
-            double ay2 = r1.bottom();
-            bool intersection = mu::engraving::intersects(ay1, ay2, by1, by2, verticalClearance);
-            double padding = 0;
-            KerningType kerningType = KerningType::NON_KERNING;
-            if (item1 && item2) {
-                padding = computePadding(item1, item2);
-                padding *= squeezeFactor;
-                padding = std::max(padding, absoluteMinPadding);
-                kerningType = computeKerning(item1, item2);
+            if (!item1 || r1.isNull()) {
+                continue;
             }
-            if ((intersection && kerningType != KerningType::ALLOW_COLLISION)
-                || (r1.width() == 0 || r2.width() == 0)  // Temporary hack: shapes of zero-width are assumed to collide with everyghin
-                || (!item1 && item2 && item2->isLyrics())  // Temporary hack: avoids collision with melisma line
-                || kerningType == KerningType::NON_KERNING) {
-                dist = std::max(dist, r1.right() - r2.left() + padding);
+            bool collision = zeroWidth2 || r1.width() == 0;
+            if (!collision) {
+                // The kerning type doesn't matter for zero-width shapes: kerning until origin
+                // can't give more than the collision distance
+                KerningType kerningType = computeKerning(item1, item2);
+                if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
+                    double origin = r1.left();
+                    dist = std::max(dist, origin - bx1);
+                }
+                collision = kerningType == KerningType::NON_KERNING
+                            || (kerningType != KerningType::ALLOW_COLLISION
+                                && mu::engraving::intersects(r1.top(), r1.bottom(), by1, by2, verticalClearance));
             }
-            if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
-                double origin = r1.left();
-                dist = std::max(dist, origin - r2.left());
+            if (!collision) {
+                continue;
             }
+            // Padding is the expensive part, only compute it for the pairs that collide
+            double padding = computePadding(item1, item2);
+            padding *= squeezeFactor;
+            padding = std::max(padding, absoluteMinPadding);
+            dist = std::max(dist, r1.right() - bx1 + padding);
         }
     }
     return dist;
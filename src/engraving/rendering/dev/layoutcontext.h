@@ -33,6 +33,7 @@
 #include "dom/mscore.h"
 
 #include "../layoutoptions.h"
+#include "../layoutprofiler.h"
 
 namespace mu::engraving {
 class EngravingItem;
@@ -84,6 +85,7 @@ public:
 
     bool isShowVBox() const { return options().isShowVBox; }
     double noteHeadWidth() const { return options().noteHeadWidth; }
+    size_t pageLimit() const { return options().pageLimit; }
     bool isShowInvisible() const;
     int pageNumberOffset() const;
     bool isVerticalSpreadEnabled() const;
@@ -204,6 +206,7 @@ public:
     const std::vector<System*>& systemList() const { return m_systemList; }
     const System* prevSystem() const { return m_prevSystem; }
     const System* curSystem() const { return m_curSystem; }
+    bool curSystemFromPrevLayout() const { return m_curSystemFromPrevLayout; }
 
     const MeasureBase* prevMeasure() const { return m_prevMeasure; }
     const MeasureBase* curMeasure() const { return m_curMeasure; }
@@ -238,6 +241,7 @@ public:
     void setPrevSystem(System* s) { m_prevSystem = s; }
     System* curSystem() { return m_curSystem; }
     void setCurSystem(System* s) { m_curSystem = s; }
+    void setCurSystemFromPrevLayout(bool val) { m_curSystemFromPrevLayout = val; }
 
     MeasureBase* prevMeasure() { return m_prevMeasure; }
     void setPrevMeasure(MeasureBase* m) { m_prevMeasure = m; }
@@ -274,6 +278,7 @@ private:
     std::vector<System*> m_systemList;      // reusable systems
     System* m_prevSystem = nullptr;         // used during page layout
     System* m_curSystem = nullptr;
+    bool m_curSystemFromPrevLayout = false; // curSystem was taken over unchanged from the previous layout
 
     MeasureBase* m_prevMeasure = nullptr;
     MeasureBase* m_curMeasure = nullptr;
@@ -324,6 +329,11 @@ public:
     void select(EngravingItem* item, SelectType = SelectType::SINGLE, staff_idx_t staff = 0);
     void deselect(EngravingItem* el);
 
+    // Profiling
+    //! NOTE Null unless the layout profiler is enabled
+    LayoutProfile* profile() const { return m_profile.get(); }
+    void setProfile(const LayoutProfilePtr& profile) { m_profile = profile; }
+
 private:
 
     Score* score() override { return m_score; }
@@ -333,6 +343,8 @@ private:
     LayoutConfiguration m_configuration;
     DomAccessor m_dom;
     LayoutState m_state;
+
+    LayoutProfilePtr m_profile;
 };
 }
 
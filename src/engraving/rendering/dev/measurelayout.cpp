@@ -762,6 +762,11 @@ void MeasureLayout::getNextMeasure(LayoutContext& ctx)
         return;
     }
 
+    rendering::LayoutProfile::clock::time_point profileStart;
+    if (ctx.profile()) {
+        profileStart = rendering::LayoutProfile::clock::now();
+    }
+
     int mno = adjustMeasureNo(ctx.mutState().curMeasure(), ctx);
 
     if (ctx.state().curMeasure()->isMeasure()) {
@@ -831,6 +836,10 @@ void MeasureLayout::getNextMeasure(LayoutContext& ctx)
     // calculate accidentals and note lines,
     // create stem and set stem direction
     //
+    // Trills may carry an accidental into this measure that requires a force-restate
+    SpannerMap::IntervalList spanners;
+    ctx.dom().spannerMap().findOverlapping(measure->tick().ticks(), measure->tick().ticks(), spanners, true);
+
     for (size_t staffIdx = 0; staffIdx < ctx.dom().nstaves(); ++staffIdx) {
         const Staff* staff = ctx.dom().staff(staffIdx);
         if (!staff->show()) {
@@ -840,10 +849,7 @@ void MeasureLayout::getNextMeasure(LayoutContext& ctx)
         AccidentalState as;          // list of already set accidentals for this measure
         as.init(staff->keySigEvent(measure->tick()));
 
-        // Trills may carry an accidental into this measure that requires a force-restate
-        int ticks = measure->tick().ticks();
-        auto spanners = ctx.dom().spannerMap().findOverlapping(ticks, ticks, true);
-        for (auto iter : spanners) {
+        for (const auto& iter : spanners) {
             Spanner* spanner = iter.value;
             if (spanner->staffIdx() != staffIdx || !spanner->isTrill() || spanner->tick2() == measure->tick()) {
                 continue;
@@ -1021,6 +1027,10 @@ void MeasureLayout::getNextMeasure(LayoutContext& ctx)
     // Segment::visible() property, which is determined by Segment::createShapes().
 
     ctx.mutState().setTick(ctx.state().tick() + measure->ticks());
+
+    if (ctx.profile()) {
+        ctx.profile()->addMeasure(measure->no(), measure->tick().ticks(), rendering::LayoutProfile::nsecSince(profileStart));
+    }
 }
 
 //---------------------------------------------------------
@@ -2139,11 +2149,208 @@ void MeasureLayout::computeWidth(Measure* m, LayoutContext& ctx, Fraction minTic
 
     ChordLayout::updateGraceNotes(m, ctx);
 
+    Measure::LayoutData::SpacingKey spacingKey = computeSpacingKey(m, ctx, minTicks, maxTicks, stretchCoeff, overrideMinMeasureWidth);
+    bool isMemoized = restoreSpacing(m, spacingKey);
+    if (ctx.profile()) {
+        ctx.profile()->addMeasureWidthLookup(isMemoized);
+    }
+    if (isMemoized) {
+        return;
+    }
+
     x = HorizontalSpacing::computeFirstSegmentXPosition(m, s, ctx.state().segmentShapeSqueezeFactor());
     bool isSystemHeader = s->header();
 
     m->setSqueezableSpace(0.0);
     computeWidth(m, ctx, s, x, isSystemHeader, minTicks, maxTicks, stretchCoeff, overrideMinMeasureWidth);
+
+    storeSpacing(m, std::move(spacingKey));
+}
+
+//---------------------------------------------------------
+//   computeSpacingKey
+//    Everything computeWidth depends on: the segments with
+//    their shapes, the end of the previous measure in the
+//    system, the style values spacing and padding read, and
+//    the arguments.
+//---------------------------------------------------------
+
+//! NOTE The style values read by computeWidth, HorizontalSpacing and the padding table
+static constexpr Sid SPACING_STYLE_IDS[] = {
+    Sid::accidentalNoteDistance, Sid::ambitusMargin, Sid::barAccidentalDistance, Sid::barNoteDistance,
+    Sid::clefBarlineDistance, Sid::clefKeyDistance, Sid::clefKeyRightMargin, Sid::clefLeftMargin,
+    Sid::clefTimesigDistance, Sid::dotDotDistance, Sid::dotNoteDistance, Sid::endBarDistance, Sid::endBarWidth,
+    Sid::graceToGraceNoteDist, Sid::graceToMainNoteDist, Sid::HeaderToLineStartDistance, Sid::keyBarlineDistance,
+    Sid::keysigLeftMargin, Sid::keyTimesigDistance, Sid::ledgerLineLength, Sid::minHarmonyDistance,
+    Sid::minMeasureWidth, Sid::minMMRestWidth, Sid::minNoteDistance, Sid::MinStraightGlissandoLength, Sid::MinTieLength,
+    Sid::MinWigglyGlissandoLength, Sid::multiMeasureRestMargin, Sid::noteBarDistance, Sid::oldStyleMultiMeasureRests,
+    Sid::stemWidth, Sid::systemHeaderDistance, Sid::systemHeaderTimeSigDistance, Sid::timesigBarlineDistance,
+    Sid::timesigLeftMargin,
+};
+
+static std::vector<Measure::LayoutData::ShapeKey> shapeKeys(const Segment* s)
+{
+    std::vector<Measure::LayoutData::ShapeKey> keys;
+    keys.reserve(s->shapes().size());
+    for (const Shape& shape : s->shapes()) {
+        Measure::LayoutData::ShapeKey key;
+        key.reserve(shape.elements().size());
+        for (const ShapeElement& e : shape.elements()) {
+            key.push_back({ e.item() ? e.item()->type() : ElementType::INVALID, e.x(), e.y(), e.width(), e.height() });
+        }
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+Measure::LayoutData::SpacingKey MeasureLayout::computeSpacingKey(const Measure* m, const LayoutContext& ctx, Fraction minTicks,
+                                                                 Fraction maxTicks, double stretchCoeff, bool overrideMinMeasureWidth)
+{
+    Measure::LayoutData::SpacingKey key;
+
+    const bool first = m->isFirstInSystem();
+    const System* system = m->system();
+    key.segmentsGeneration = m->segments().generation();
+    key.isFirstInSystem = first;
+    key.systemWidth = system->width();
+    key.systemLeftMargin = system->leftMargin();
+    key.spatium = m->spatium();
+    key.mag = m->mag();
+    key.userStretch = m->userStretch();
+    key.ticks = m->ticks();
+    key.timesig = m->timesig();
+    key.mmRestCount = m->mmRestCount();
+
+    key.minTicks = minTicks;
+    key.maxTicks = maxTicks;
+    key.stretchCoeff = stretchCoeff;
+    key.overrideMinMeasureWidth = overrideMinMeasureWidth;
+    key.squeezeFactor = ctx.state().segmentShapeSqueezeFactor();
+
+    key.noteHeadWidth = ctx.conf().noteHeadWidth();
+    key.style.reserve(std::size(SPACING_STYLE_IDS));
+    for (Sid id : SPACING_STYLE_IDS) {
+        key.style.push_back(ctx.conf().styleV(id));
+    }
+
+    // the first segment is padded against the end of the previous measure
+    const MeasureBase* pmb = m->prev();
+    if (pmb && pmb->isMeasure() && pmb->system() == system) {
+        const Measure* pm = toMeasure(pmb);
+        key.prevRepeatEnd = pm->repeatEnd();
+        if (const Segment* pmEnd = pm->lastEnabled()) {
+            key.hasPrevEnd = true;
+            key.prevEndType = pmEnd->segmentType();
+            key.prevEndSpace = pm->width() - pmEnd->x();
+            key.prevEndShapes = shapeKeys(pmEnd);
+        }
+    }
+
+    key.segments.reserve(m->segments().size());
+    for (const Segment* s = m->first(); s; s = s->next()) {
+        Measure::LayoutData::SegmentKey sk;
+        sk.type = s->segmentType();
+        sk.rtick = s->rtick();
+        sk.ticks = s->ticks();
+        sk.enabled = s->enabled();
+        sk.visible = s->visible();
+        sk.allElementsInvisible = s->allElementsInvisible();
+        sk.header = s->header();
+        sk.extraLeadingSpace = s->extraLeadingSpace().val();
+        sk.shapes = shapeKeys(s);
+
+        if (s->isChordRestType()) {
+            for (const EngravingItem* e : s->elist()) {
+                if (!e || !e->isChordRest()) {
+                    continue;
+                }
+                const ChordRest* cr = toChordRest(e);
+                Measure::LayoutData::ChordRestKey ck;
+                ck.type = cr->type();
+                ck.track = cr->track();
+                ck.ticks = cr->ticks();
+                ck.hasBeam = cr->beam() != nullptr;
+                ck.up = cr->up();
+                ck.visible = cr->visible();
+                ck.staffVisible = cr->staff()->visible();
+
+                // dangling ties and glissandos after the system header
+                if (first && cr->isChord()) {
+                    const Chord* chord = toChord(cr);
+                    ck.danglingLinesX.push_back(chord->pos().x());
+                    for (const Note* note : chord->notes()) {
+                        if (note->lineAttachPoints().empty()) {
+                            continue;
+                        }
+                        ck.danglingLinesX.push_back(note->pos().x());
+                        ck.danglingLinesX.push_back(note->lineAttachPoints().front().pos().x());
+                    }
+                }
+                sk.chordRests.push_back(std::move(ck));
+            }
+        }
+
+        key.segments.push_back(std::move(sk));
+    }
+
+    return key;
+}
+
+//---------------------------------------------------------
+//   restoreSpacing
+//    Puts back the spacing memoized by computeWidth if it
+//    was computed from the same state, drops it otherwise
+//---------------------------------------------------------
+
+bool MeasureLayout::restoreSpacing(Measure* m, const Measure::LayoutData::SpacingKey& key)
+{
+    std::optional<Measure::LayoutData::Spacing>& spacing = m->mutldata()->spacing;
+    if (!spacing) {
+        return false;
+    }
+    if (spacing->key != key) {
+        spacing.reset();
+        return false;
+    }
+
+    for (const Measure::LayoutData::SegmentSpacing& ss : spacing->segments) {
+        Segment* s = ss.segment;
+        s->mutldata()->setPosX(ss.x);
+        s->setWidth(ss.width);
+        s->setWidthOffset(ss.widthOffset);
+        s->setStretch(ss.stretch);
+        s->setCrossBeamType(ss.crossBeamType);
+    }
+
+    m->setSqueezableSpace(spacing->squeezableSpace);
+    m->setLayoutStretch(spacing->layoutStretch);
+    m->setWidth(spacing->width);
+    m->setWidthLocked(spacing->widthLocked);
+
+    return true;
+}
+
+void MeasureLayout::storeSpacing(Measure* m, Measure::LayoutData::SpacingKey&& key)
+{
+    Measure::LayoutData::Spacing spacing;
+    spacing.key = std::move(key);
+    for (Segment& s : m->segments()) {
+        Measure::LayoutData::SegmentSpacing ss;
+        ss.segment = &s;
+        ss.x = s.x();
+        ss.width = s.width(LD_ACCESS::BAD);
+        ss.widthOffset = s.widthOffset();
+        ss.stretch = s.stretch();
+        ss.crossBeamType = s.crossBeamType();
+        spacing.segments.push_back(ss);
+    }
+
+    spacing.squeezableSpace = m->squeezableSpace();
+    spacing.layoutStretch = m->layoutStretch();
+    spacing.width = m->width();
+    spacing.widthLocked = m->isWidthLocked();
+
+    m->mutldata()->spacing = std::move(spacing);
 }
 
 //---------------------------------------------------------
@@ -22,11 +22,12 @@
 #ifndef MU_ENGRAVING_MEASURELAYOUT_DEV_H
 #define MU_ENGRAVING_MEASURELAYOUT_DEV_H
 
+#include "dom/measure.h"
+
 #include "../layoutoptions.h"
 #include "layoutcontext.h"
 
 namespace mu::engraving {
-class Measure;
 class MeasureBase;
 class Score;
 class Segment;
@@ -76,6 +77,11 @@ private:
 
     static double computeMinMeasureWidth(Measure* m, LayoutContext& ctx);
 
+    static Measure::LayoutData::SpacingKey computeSpacingKey(const Measure* m, const LayoutContext& ctx, Fraction minTicks,
+                                                             Fraction maxTicks, double stretchCoeff, bool overrideMinMeasureWidth);
+    static bool restoreSpacing(Measure* m, const Measure::LayoutData::SpacingKey& key);
+    static void storeSpacing(Measure* m, Measure::LayoutData::SpacingKey&& key);
+
     static void layoutPartialWidth(StaffLines* lines, LayoutContext& ctx, double w, double wPartial, bool alignLeft);
 };
 }
@@ -88,20 +88,30 @@ void PageLayout::getNextPage(LayoutContext& ctx)
     }
     ctx.mutState().page()->mutldata()->setBbox(0.0, 0.0, ctx.conf().loWidth(), ctx.conf().loHeight());
     ctx.mutState().page()->setNo(ctx.state().pageIdx());
+    setPagePos(ctx, ctx.mutState().page());
+    ctx.mutState().setPageIdx(ctx.state().pageIdx() + 1);
+}
+
+//---------------------------------------------------------
+//   setPagePos
+//    place page next to the page before it
+//---------------------------------------------------------
+
+void PageLayout::setPagePos(LayoutContext& ctx, Page* page)
+{
     double x = 0.0;
     double y = 0.0;
-    if (ctx.state().pageIdx()) {
-        Page* prevPage = ctx.mutDom().pages()[ctx.state().pageIdx() - 1];
+    if (page->no()) {
+        Page* prevPage = ctx.mutDom().pages()[page->no() - 1];
         if (MScore::verticalOrientation()) {
-            y = prevPage->pos().y() + ctx.state().page()->height() + MScore::verticalPageGap;
+            y = prevPage->pos().y() + page->height() + MScore::verticalPageGap;
         } else {
-            double gap = (ctx.state().pageIdx() + ctx.conf().pageNumberOffset())
+            double gap = (page->no() + ctx.conf().pageNumberOffset())
                          & 1 ? MScore::horizontalPageGapOdd : MScore::horizontalPageGapEven;
-            x = prevPage->pos().x() + ctx.state().page()->width() + gap;
+            x = prevPage->pos().x() + page->width() + gap;
         }
     }
-    ctx.mutState().setPageIdx(ctx.state().pageIdx() + 1);
-    ctx.mutState().page()->setPos(x, y);
+    page->setPos(x, y);
 }
 
 //---------------------------------------------------------
@@ -112,6 +122,13 @@ void PageLayout::collectPage(LayoutContext& ctx)
 {
     TRACEFUNC;
 
+    rendering::LayoutPassTimer profileTimer(ctx.profile(), "collectPage");
+    if (ctx.profile()) {
+        ctx.profile()->addPage();
+    }
+
+    ctx.mutState().page()->markLayoutChanged();
+
     const double slb = ctx.conf().styleMM(Sid::staffLowerBorder);
     bool breakPages = ctx.conf().viewMode() != LayoutMode::SYSTEM;
     double footerExtension = ctx.state().page()->footerExtension();
@@ -199,6 +216,7 @@ void PageLayout::collectPage(LayoutContext& ctx)
         //  check for page break or if next system will fit on page
         //
         bool collected = false;
+        bool fromPrevLayout = false;
         if (ctx.state().rangeDone()) {
             // take next system unchanged
             if (systemIdx > 0) {
@@ -210,6 +228,7 @@ void PageLayout::collectPage(LayoutContext& ctx)
                 nextSystem = ctx.state().systemList().empty() ? 0 : mu::takeFirst(ctx.mutState().systemList());
                 if (nextSystem) {
                     ctx.mutDom().systems().push_back(nextSystem);
+                    fromPrevLayout = true;
                 }
             }
         } else {
@@ -221,6 +240,7 @@ void PageLayout::collectPage(LayoutContext& ctx)
         ctx.mutState().setPrevSystem(ctx.mutState().curSystem());
         assert(ctx.state().curSystem() != nextSystem);
         ctx.mutState().setCurSystem(nextSystem);
+        ctx.mutState().setCurSystemFromPrevLayout(fromPrevLayout);
 
         bool breakPage = !ctx.state().curSystem() || (breakPages && ctx.state().prevSystem()->pageBreak());
 
@@ -551,6 +571,8 @@ void PageLayout::checkDivider(LayoutContext& ctx, bool left, System* s, double y
 
 void PageLayout::distributeStaves(LayoutContext& ctx, Page* page, double footerPadding)
 {
+    rendering::LayoutPassTimer profileTimer(ctx.profile(), "distributeStaves");
+
     VerticalGapDataList vgdl;
 
     // Find and classify all gaps between staves.
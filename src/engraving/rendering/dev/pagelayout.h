@@ -36,6 +36,7 @@ public:
 
     static void getNextPage(LayoutContext& ctx);
     static void collectPage(LayoutContext& ctx);
+    static void setPagePos(LayoutContext& ctx, Page* page);
 
 private:
     static void layoutPage(LayoutContext& ctx, Page* page, double restHeight, double footerPadding);
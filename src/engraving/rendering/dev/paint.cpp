@@ -22,9 +22,12 @@
 #include "paint.h"
 
 #include "draw/painter.h"
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
 #include "dom/score.h"
 #include "dom/page.h"
 #include "dom/engravingitem.h"
+#include "dom/mscore.h"
 
 #include "tdraw.h"
 #include "debugpaint.h"
@@ -34,6 +37,246 @@
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
+//---------------------------------------------------------
+//   display lists
+//    The items of a page are sorted and recorded once after
+//    the page was laid out and then replayed by every paint.
+//    An item is recorded again when it is painted in another
+//    color (selection, drop target...), the whole list when
+//    the items of the page change (see Page::invalidateBspTree)
+//    or when a setting every item depends on changes
+//    (see displayListKey).
+//    The lists of a score are kept within a memory budget,
+//    the lists of the pages painted least recently, that is
+//    the pages that are off-screen, are dropped first
+//    (see limitDisplayLists).
+//---------------------------------------------------------
+
+static constexpr size_t MAX_DISPLAY_LISTS_MEMORY = 64 * 1024 * 1024;
+
+static uint64_t s_displayListPaintNo = 0;
+
+static void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+template<typename T>
+static void hashAdd(size_t& seed, const T& value)
+{
+    hashCombine(seed, std::hash<T>()(value));
+}
+
+static void hashColor(size_t& seed, const Color& color)
+{
+    hashAdd(seed, color.isValid());
+    hashAdd(seed, color.red());
+    hashAdd(seed, color.green());
+    hashAdd(seed, color.blue());
+    hashAdd(seed, color.alpha());
+}
+
+static size_t displayListKey(const Score* score)
+{
+    const auto config = EngravingItem::engravingConfiguration();
+
+    size_t key = 0;
+    hashAdd(key, score->printing());
+    hashAdd(key, score->isShowInvisible());
+    hashAdd(key, score->showUnprintable());
+    hashAdd(key, score->showFrames());
+    hashAdd(key, MScore::pixelRatio);
+    hashAdd(key, MScore::warnPitchRange);
+    hashAdd(key, config->scoreInversionEnabled());
+    hashColor(key, config->defaultColor());
+    hashColor(key, config->scoreInversionColor());
+    hashColor(key, config->invisibleColor());
+    hashColor(key, config->formattingMarksColor());
+    hashColor(key, config->noteBackgroundColor());
+    hashColor(key, config->fontPrimaryColor());
+    hashColor(key, config->warningColor());
+    hashColor(key, config->criticalColor());
+
+    return key;
+}
+
+//! NOTE Texts are laid out for the zoom they are painted at (see TextBase::drawTextWorkaround)
+//! and images are scaled to it, so they are painted directly in their place in the list
+static bool isRetained(const EngravingItem* item)
+{
+    return !item->isTextBase() && !item->isImage();
+}
+
+static size_t itemMemoryUsage(const mu::draw::DrawData::Item& item)
+{
+    size_t size = sizeof(mu::draw::DrawData::Item) + item.name.capacity();
+
+    for (const mu::draw::DrawData::Data& d : item.datas) {
+        size += sizeof(mu::draw::DrawData::Data);
+
+        for (const mu::draw::DrawPath& path : d.paths) {
+            size += sizeof(mu::draw::DrawPath) + path.path.elementCount() * sizeof(mu::draw::PainterPath::Element);
+        }
+
+        for (const mu::draw::DrawPolygon& polygon : d.polygons) {
+            size += sizeof(mu::draw::DrawPolygon) + polygon.polygon.size() * sizeof(PointF);
+        }
+
+        for (const mu::draw::DrawText& text : d.texts) {
+            size += sizeof(mu::draw::DrawText) + text.text.size() * sizeof(char16_t);
+        }
+
+        size += d.pixmaps.size() * sizeof(mu::draw::DrawPixmap);
+    }
+
+    for (const mu::draw::DrawData::Item& ch : item.chilren) {
+        size += itemMemoryUsage(ch);
+    }
+
+    return size;
+}
+
+static size_t drawDataMemoryUsage(const mu::draw::DrawData& data)
+{
+    return sizeof(mu::draw::DrawData) + data.states.size() * sizeof(mu::draw::DrawData::State) + itemMemoryUsage(data.item);
+}
+
+static void recordItem(Page::DisplayItem& entry)
+{
+    const EngravingItem* item = entry.item;
+
+    entry.color = item->curColor();
+    entry.selected = item->selected();
+    entry.data = nullptr;
+    entry.memoryUsage = 0;
+
+    if (!isRetained(item)) {
+        return;
+    }
+
+    std::shared_ptr<mu::draw::BufferedPaintProvider> provider = std::make_shared<mu::draw::BufferedPaintProvider>();
+    {
+        mu::draw::Painter painter(provider, "DisplayItem");
+        painter.setAntialiasing(true);
+        painter.translate(item->pagePos());
+        TDraw::drawItem(item, &painter);
+        painter.endDraw();
+    }
+
+    entry.data = provider->drawData();
+    entry.memoryUsage = drawDataMemoryUsage(*entry.data);
+}
+
+static Page::DisplayList* buildDisplayList(Page* page, size_t paintKey)
+{
+    TRACEFUNC;
+
+    // the same items as in the bsp tree, see Page::doRebuildBspTree
+    std::vector<EngravingItem*> items;
+    page->scanElements(&items, collectElements, false);
+    std::sort(items.begin(), items.end(), mu::engraving::elementLessThan);
+
+    std::shared_ptr<Page::DisplayList> list = std::make_shared<Page::DisplayList>();
+    list->paintKey = paintKey;
+    list->items.reserve(items.size());
+
+    for (EngravingItem* item : items) {
+        Page::DisplayItem& entry = list->items.emplace_back();
+        entry.item = item;
+        entry.rect = item->pageBoundingRect();
+        recordItem(entry);
+        list->memoryUsage += entry.memoryUsage;
+    }
+
+    page->setDisplayList(list);
+
+    return page->displayList();
+}
+
+static void paintDisplayList(mu::draw::Painter& painter, Page* page, const mu::RectF& rect, uint64_t paintNo,
+                             std::vector<EngravingItem*>& painted)
+{
+    TRACEFUNC;
+
+    const size_t paintKey = displayListKey(page->score());
+
+    Page::DisplayList* list = page->displayList();
+    if (!list || list->paintKey != paintKey) {
+        list = buildDisplayList(page, paintKey);
+    }
+
+    list->lastPainted = paintNo;
+
+    for (Page::DisplayItem& entry : list->items) {
+        if (!entry.rect.intersects(rect)) {
+            continue;
+        }
+
+        EngravingItem* item = entry.item;
+        painted.push_back(item);
+
+        if (!item->isInteractionAvailable()) {
+            continue;
+        }
+
+        if (!isRetained(item)) {
+            Paint::paintItem(painter, item);
+            continue;
+        }
+
+        if (item->ldata()->isSkipDraw()) {
+            continue;
+        }
+
+        if (entry.color != item->curColor() || entry.selected != item->selected()) {
+            list->memoryUsage -= entry.memoryUsage;
+            recordItem(entry);
+            list->memoryUsage += entry.memoryUsage;
+        }
+
+        item->itemDiscovered = false;
+        mu::draw::DrawDataPaint::paintOnTop(&painter, entry.data);
+    }
+}
+
+//---------------------------------------------------------
+//   limitDisplayLists
+//    drops the lists of the pages painted least recently
+//    until the lists of the score fit in the budget; the
+//    pages of the current paint are kept in any case
+//---------------------------------------------------------
+
+static void limitDisplayLists(const Score* score, uint64_t paintNo)
+{
+    std::vector<Page*> recorded;
+    size_t memoryUsage = 0;
+
+    for (Page* page : score->pages()) {
+        const Page::DisplayList* list = page->displayList();
+        if (list) {
+            recorded.push_back(page);
+            memoryUsage += list->memoryUsage;
+        }
+    }
+
+    if (memoryUsage <= MAX_DISPLAY_LISTS_MEMORY) {
+        return;
+    }
+
+    std::sort(recorded.begin(), recorded.end(), [](const Page* p1, const Page* p2) {
+        return p1->displayList()->lastPainted < p2->displayList()->lastPainted;
+    });
+
+    for (Page* page : recorded) {
+        if (memoryUsage <= MAX_DISPLAY_LISTS_MEMORY || page->displayList()->lastPainted == paintNo) {
+            break;
+        }
+
+        memoryUsage -= page->displayList()->memoryUsage;
+        page->setDisplayList(nullptr);
+    }
+}
+
 void Paint::paintScore(draw::Painter* painter, Score* score, const IScoreRenderer::PaintOptions& opt)
 {
     TRACEFUNC;
@@ -74,6 +317,8 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const IScoreRendere
     int fromPage = opt.fromPage >= 0 ? opt.fromPage : 0;
     int toPage = (opt.toPage >= 0 && opt.toPage < int(pages.size())) ? opt.toPage : (int(pages.size()) - 1);
 
+    const uint64_t paintNo = opt.useDisplayList ? ++s_displayListPaintNo : 0;
+
     for (int copy = 0; copy < opt.copyCount; ++copy) {
         bool firstPage = true;
         for (int pi = fromPage; pi <= toPage; ++pi) {
@@ -137,8 +382,13 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const IScoreRendere
                 disableClipping = true;
             }
 
-            std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
-            paintItems(*painter, elements);
+            std::vector<EngravingItem*> elements;
+            if (opt.useDisplayList) {
+                paintDisplayList(*painter, page, drawRect.translated(-pagePos), paintNo, elements);
+            } else {
+                elements = page->items(drawRect.translated(-pagePos));
+                paintItems(*painter, elements);
+            }
 
             if (disableClipping) {
                 painter->setClipping(false);
@@ -165,6 +415,10 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const IScoreRendere
             }
         }
     }
+
+    if (opt.useDisplayList) {
+        limitDisplayLists(score, paintNo);
+    }
 }
 
 SizeF Paint::pageSizeInch(const Score* score)
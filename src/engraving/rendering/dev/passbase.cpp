@@ -21,9 +21,13 @@
  */
 #include "passbase.h"
 
+#include "layoutcontext.h"
+
+using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
 void PassBase::run(Score* score, LayoutContext& ctx)
 {
+    rendering::LayoutPassTimer timer(ctx.profile(), name());
     doRun(score, ctx);
 }
@@ -21,20 +21,27 @@
  */
 #include "passlayoutindependentitems.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "infrastructure/layoutscheduler.h"
+
+#include "dom/chord.h"
+#include "dom/note.h"
 #include "dom/score.h"
+#include "dom/staff.h"
 
 #include "tlayout.h"
 
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
-void PassLayoutIndependentItems::doRun(Score* score, LayoutContext& ctx)
-{
-    RootItem* rootItem = score->rootItem();
-    scan(rootItem, ctx);
-}
+//! NOTE Below this number of items, spreading the pass over threads costs more than it saves
+static constexpr size_t MIN_PARALLEL_ITEMS = 1000;
 
-void PassLayoutIndependentItems::scan(EngravingItem* item, LayoutContext& ctx)
+static bool isIndependent(const EngravingItem* item)
 {
     //! NOTE These items are independent
     switch (item->type()) {
@@ -59,15 +66,173 @@ void PassLayoutIndependentItems::scan(EngravingItem* item, LayoutContext& ctx)
     case ElementType::SYSTEM_DIVIDER:
     case ElementType::TIMESIG:
     case ElementType::TREMOLOBAR:
-        TLayout::layoutItem(item, ctx);
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+//! NOTE Text is measured through the font provider, which is only used from the calling thread.
+//! Nothing else in the pass reads the layout of these items, so they can be laid out last.
+static bool isTextItem(const EngravingItem* item)
+{
+    switch (item->type()) {
+    case ElementType::ACTION_ICON:
+    case ElementType::FSYMBOL:
+    case ElementType::HARMONY:
+    case ElementType::INSTRUMENT_NAME:
+    case ElementType::SYMBOL:           // may hold images and symbols of other fonts
+    case ElementType::SYSTEM_DIVIDER:
+        return true;
     default:
         break;
     }
+    return false;
+}
+
+//! NOTE Fret marks on tablature are text too, but stems read the layout of their notes,
+//! so the whole chunk stays on the calling thread
+static bool isTabNote(const EngravingItem* item)
+{
+    if (!item->isNote()) {
+        return false;
+    }
+    const Note* note = toNote(item);
+    return note->staff() && note->chord() && note->staff()->isTabStaff(note->chord()->tick());
+}
+
+void PassLayoutIndependentItems::doRun(Score* score, LayoutContext& ctx)
+{
+    m_chunks.clear();
+    m_callerThreadItems.clear();
+    m_itemsCount = 0;
+
+    RootItem* rootItem = score->rootItem();
+    m_chunks.emplace_back();
+    collect(rootItem, 0);
+
+    if (!score->layoutOptions().isParallel
+        || m_itemsCount < MIN_PARALLEL_ITEMS || m_chunks.size() < 2
+        || isLayoutThread()) {
+        for (const Chunk& chunk : m_chunks) {
+            for (EngravingItem* item : chunk.items) {
+                TLayout::layoutItem(item, ctx);
+            }
+        }
+    } else {
+        layoutParallel(ctx);
+    }
+
+    for (EngravingItem* item : m_callerThreadItems) {
+        TLayout::layoutItem(item, ctx);
+    }
+
+    m_chunks.clear();
+    m_callerThreadItems.clear();
+}
+
+//---------------------------------------------------------
+//   collect
+//    Gather the independent items in tree order. Every measure
+//    and system starts a chunk of its own; items of the same
+//    chunk are laid out in order on one thread.
+//---------------------------------------------------------
+
+void PassLayoutIndependentItems::collect(EngravingItem* item, size_t chunkIdx)
+{
+    if (item->isMeasureBase() || item->isSystem()) {
+        chunkIdx = m_chunks.size();
+        m_chunks.emplace_back();
+    }
+
+    if (isIndependent(item)) {
+        if (isTextItem(item)) {
+            m_callerThreadItems.push_back(item);
+        } else {
+            Chunk& chunk = m_chunks[chunkIdx];
+            chunk.items.push_back(item);
+            chunk.callerThreadOnly = chunk.callerThreadOnly || isTabNote(item);
+            ++m_itemsCount;
+        }
+    }
 
     for (EngravingItem* ch : item->childrenItems()) {
         if (ch->isType(ElementType::DUMMY)) {
             continue;
         }
-        scan(ch, ctx);
+        collect(ch, chunkIdx);
+    }
+}
+
+//---------------------------------------------------------
+//   layoutParallel
+//    Workers claim chunks one by one until none are left, so
+//    uneven measures even out. The layout functions of these
+//    items only read the context (style, font, dom), and write
+//    nothing but the layout data of the items of their chunk.
+//---------------------------------------------------------
+
+void PassLayoutIndependentItems::layoutParallel(LayoutContext& ctx)
+{
+    // Resolve lazily initialised statics before going wide
+    EngravingItem::engravingConfiguration();
+
+    struct Job {
+        std::vector<Chunk> chunks;
+        LayoutContext* ctx = nullptr;
+        std::atomic<size_t> next = 0;
+        size_t done = 0;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        void work()
+        {
+            size_t count = 0;
+            for (size_t i = next++; i < chunks.size(); i = next++) {
+                for (EngravingItem* item : chunks[i].items) {
+                    TLayout::layoutItem(item, *ctx);
+                }
+                ++count;
+            }
+            if (count == 0) {
+                return;
+            }
+            std::lock_guard lock(mutex);
+            done += count;
+            if (done == chunks.size()) {
+                finished.notify_all();
+            }
+        }
+    };
+
+    // Chunks that must stay on this thread are laid out first
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->ctx = &ctx;
+    for (Chunk& chunk : m_chunks) {
+        if (chunk.callerThreadOnly) {
+            for (EngravingItem* item : chunk.items) {
+                TLayout::layoutItem(item, ctx);
+            }
+        } else if (!chunk.items.empty()) {
+            job->chunks.push_back(std::move(chunk));
+        }
+    }
+
+    if (job->chunks.empty()) {
+        return;
     }
+
+    //! NOTE Workers that start after all chunks are taken return without touching the context,
+    //! the job itself is kept alive by the shared pointer
+    mu::TaskScheduler* scheduler = layoutScheduler();
+    size_t workers = std::min<size_t>(scheduler->threadPoolSize(), job->chunks.size() - 1);
+    for (size_t i = 0; i < workers; ++i) {
+        scheduler->push([job]() { job->work(); });
+    }
+
+    job->work();
+
+    std::unique_lock lock(job->mutex);
+    job->finished.wait(lock, [&job]() { return job->done == job->chunks.size(); });
 }
@@ -22,6 +22,9 @@
 #ifndef MU_ENGRAVING_PASSLAYOUTINDEPENDEDITEMS_DEV_H
 #define MU_ENGRAVING_PASSLAYOUTINDEPENDEDITEMS_DEV_H
 
+#include <cstddef>
+#include <vector>
+
 #include "passbase.h"
 
 namespace mu::engraving {
@@ -29,15 +32,41 @@ class EngravingItem;
 }
 
 namespace mu::engraving::rendering::dev {
+//! NOTE Lays out the items that depend on nothing but themselves and the style.
+//! The score tree is split into chunks at measure and system granularity, and the
+//! chunks of large scores are laid out on a thread pool
+//! (unless LayoutOptions::isParallel is off, which tests use as the serial reference).
+//!
+//! Excluded from the worker threads:
+//!   - ACTION_ICON, FSYMBOL, HARMONY, INSTRUMENT_NAME, SYMBOL, SYSTEM_DIVIDER:
+//!     their layout measures text (or symbols of other fonts) through the font provider,
+//!     which is only used from the calling thread (see IFontProvider). They are laid out after the chunks,
+//!     nothing else in the pass reads their layout.
+//!   - chunks holding NOTEs of tablature staves: fret marks are text too, and the stems
+//!     of the chunk read the layout of their notes, so the whole chunk stays together.
+//! Everything else only reads the style, the engraving font and the dom,
+//! and writes nothing but the layout data of the items of its own chunk.
 class PassLayoutIndependentItems : public PassBase
 {
 public:
 
+    const char* name() const override { return "PassLayoutIndependentItems"; }
+
 private:
 
+    struct Chunk {
+        std::vector<EngravingItem*> items;
+        bool callerThreadOnly = false;      // contains items that need text layout
+    };
+
     void doRun(Score* score, LayoutContext& ctx) override;
 
-    void scan(EngravingItem* item, LayoutContext& ctx);
+    void collect(EngravingItem* item, size_t chunkIdx);
+    void layoutParallel(LayoutContext& ctx);
+
+    std::vector<Chunk> m_chunks;
+    std::vector<EngravingItem*> m_callerThreadItems;
+    size_t m_itemsCount = 0;
 };
 }
 
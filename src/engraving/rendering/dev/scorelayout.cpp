@@ -45,10 +45,30 @@ public:
     ~CmdStateLocker() { m_score->cmdState().unlock(); }
 };
 
+class LayoutProfileRun
+{
+    std::shared_ptr<rendering::ILayoutProfiler> m_profiler;
+    rendering::LayoutProfilePtr m_profile;
+public:
+    LayoutProfileRun(const std::shared_ptr<rendering::ILayoutProfiler>& profiler, const mu::String& scoreName)
+        : m_profiler(profiler), m_profile(profiler ? profiler->startRun(scoreName) : nullptr) {}
+    ~LayoutProfileRun()
+    {
+        if (m_profile) {
+            m_profiler->finishRun(m_profile);
+        }
+    }
+
+    const rendering::LayoutProfilePtr& profile() const { return m_profile; }
+};
+
 void ScoreLayout::layoutRange(Score* score, const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(score);
+    //! NOTE Finishes the run after the context, whose destruction belongs to the layout
+    LayoutProfileRun profileRun(layoutProfiler(), score->name());
     LayoutContext ctx(score);
+    ctx.setProfile(profileRun.profile());
 
     Fraction stick(st);
     Fraction etick(et);
@@ -76,6 +96,10 @@ void ScoreLayout::layoutRange(Score* score, const Fraction& st, const Fraction&
 
     ctx.mutState().setIsLayoutAll(isLayoutAll);
 
+    if (ctx.profile()) {
+        ctx.profile()->setRange(stick.ticks(), etick.ticks(), isLayoutAll);
+    }
+
     // Init context and layout
     switch (ctx.conf().viewMode()) {
     case LayoutMode::PAGE:
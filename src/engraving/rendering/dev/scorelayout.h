@@ -22,8 +22,11 @@
 #ifndef MU_ENGRAVING_SCORELAYOUT_DEV_H
 #define MU_ENGRAVING_SCORELAYOUT_DEV_H
 
+#include "modularity/ioc.h"
 #include "types/fraction.h"
 
+#include "../ilayoutprofiler.h"
+
 namespace mu::engraving {
 class Score;
 }
@@ -31,6 +34,8 @@ class Score;
 namespace mu::engraving::rendering::dev {
 class ScoreLayout
 {
+    INJECT_STATIC(ILayoutProfiler, layoutProfiler)
+
 public:
 
     static void layoutRange(Score* score, const Fraction& st, const Fraction& et);
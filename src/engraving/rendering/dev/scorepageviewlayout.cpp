@@ -27,6 +27,7 @@
 #include "dom/system.h"
 #include "dom/bracket.h"
 #include "dom/layoutbreak.h"
+#include "dom/factory.h"
 #include "dom/page.h"
 
 #include "passresetlayoutdata.h"
@@ -72,6 +73,8 @@ void ScorePageViewLayout::layoutPageView(Score* score, LayoutContext& ctx, const
         m = toMeasure(m)->mmRest();
     }
 
+    OldPages oldPages;
+
     if (!ctx.state().isLayoutAll() && m->system()) {
         System* system = m->system();
         system_idx_t systemIndex = mu::indexOf(score->systems(), system);
@@ -80,6 +83,10 @@ void ScorePageViewLayout::layoutPageView(Score* score, LayoutContext& ctx, const
         if (ctx.state().pageIdx() == mu::nidx) {
             ctx.mutState().setPageIdx(0);
         }
+        oldPages.firstIdx = ctx.state().pageIdx();
+        for (page_idx_t i = oldPages.firstIdx; i < score->npages(); ++i) {
+            oldPages.systems.push_back(score->pages().at(i)->systems());
+        }
         ctx.mutState().setCurSystem(system);
         ctx.mutState().setSystemList(mu::mid(score->systems(), systemIndex));
 
@@ -152,10 +159,10 @@ void ScorePageViewLayout::layoutPageView(Score* score, LayoutContext& ctx, const
         independentPass.run(score, ctx);
     }
 
-    doLayout(ctx);
+    doLayout(ctx, oldPages);
 }
 
-void ScorePageViewLayout::doLayout(LayoutContext& ctx)
+void ScorePageViewLayout::doLayout(LayoutContext& ctx, const OldPages& oldPages)
 {
     const MeasureBase* lmb = nullptr;
     do {
@@ -177,7 +184,15 @@ void ScorePageViewLayout::doLayout(LayoutContext& ctx)
         //    c) this page ends with the same measure as the previous layout
         //    pageOldMeasure will be last measure from previous layout if range was completed on or before this page
         //    it will be nullptr if this page was never laid out or if we collected a system for next page
-    } while (ctx.state().curSystem() && !(ctx.state().rangeDone() && lmb == ctx.state().pageOldMeasure()));
+        // or
+        // 3) the remaining systems and pages can be taken over from the previous layout
+        //    even though page breaks have moved (see takeOverFollowingPages)
+        // or
+        // 4) we have reached the page limit of a progressive layout,
+        //    the following pages will be laid out by a later call
+    } while (ctx.state().curSystem() && !(ctx.state().rangeDone() && lmb == ctx.state().pageOldMeasure())
+             && !takeOverFollowingPages(ctx, oldPages)
+             && !(ctx.conf().pageLimit() && ctx.state().pageIdx() >= ctx.conf().pageLimit()));
     // && page->system(0)->measures().back()->tick() > endTick // FIXME: perhaps the first measure was meant? Or last system?
 
     if (!ctx.state().curSystem()) {
@@ -198,3 +213,106 @@ void ScorePageViewLayout::doLayout(LayoutContext& ctx)
     }
     ctx.mutDom().systems().insert(ctx.mutDom().systems().end(), ctx.state().systemList().begin(), ctx.state().systemList().end());
 }
+
+//---------------------------------------------------------
+//   takeOverFollowingPages
+//    Once the edited range is done, the following systems are
+//    taken over unchanged from the previous layout. If the next
+//    of them started a page back then, that page and all the
+//    following ones are taken over as well, even if they now
+//    get another number, provided the page geometry is the same
+//    for both numbers. Edits then don't relayout every page up
+//    to the end of the score only because page breaks moved.
+//---------------------------------------------------------
+
+bool ScorePageViewLayout::takeOverFollowingPages(LayoutContext& ctx, const OldPages& oldPages)
+{
+    if (!ctx.state().rangeDone() || !ctx.state().curSystem() || !ctx.state().curSystemFromPrevLayout()) {
+        return false;
+    }
+
+    const System* curSystem = ctx.state().curSystem();
+    size_t first = mu::nidx;
+    for (size_t i = 0; i < oldPages.systems.size(); ++i) {
+        if (!oldPages.systems[i].empty() && oldPages.systems[i].front() == curSystem) {
+            first = i;
+            break;
+        }
+    }
+    if (first == mu::nidx) {
+        return false;
+    }
+
+    // the systems left to place must be exactly those of the old pages
+    const std::vector<System*>& systemList = ctx.state().systemList();
+    size_t n = 0;
+    for (size_t i = first; i < oldPages.systems.size(); ++i) {
+        for (const System* s : oldPages.systems[i]) {
+            const System* expected = n == 0 ? curSystem : (n <= systemList.size() ? systemList[n - 1] : nullptr);
+            if (s != expected) {
+                return false;
+            }
+            ++n;
+        }
+    }
+    if (n != systemList.size() + 1) {
+        return false;
+    }
+
+    std::vector<Page*>& pages = ctx.mutDom().pages();
+    const page_idx_t oldIdx = oldPages.firstIdx + first;
+    const page_idx_t newIdx = ctx.state().pageIdx();
+    if (oldIdx != newIdx && !samePageGeometry(pages.at(oldPages.firstIdx), oldIdx, newIdx)) {
+        return false;
+    }
+
+    // curSystem is in the score systems already
+    System* lastSystem = systemList.empty() ? ctx.mutState().curSystem() : systemList.back();
+    ctx.mutDom().systems().insert(ctx.mutDom().systems().end(), systemList.begin(), systemList.end());
+    ctx.mutState().systemList().clear();
+
+    for (size_t i = first; i < oldPages.systems.size(); ++i) {
+        const page_idx_t idx = ctx.state().pageIdx();
+        Page* page = nullptr;
+        if (idx < pages.size()) {
+            page = pages[idx];
+        } else {
+            page = Factory::createPage(ctx.mutDom().rootItem());
+            page->mutldata()->setBbox(0.0, 0.0, ctx.conf().loWidth(), ctx.conf().loHeight());
+            pages.push_back(page);
+        }
+        page->systems().clear();
+        for (System* s : oldPages.systems[i]) {
+            page->appendSystem(s);
+        }
+        page->setNo(idx);
+        PageLayout::setPagePos(ctx, page);
+        page->invalidateBspTree();
+
+        ctx.mutState().setPage(page);
+        ctx.mutState().setPageIdx(idx + 1);
+    }
+
+    ctx.mutState().setPrevSystem(lastSystem);
+    ctx.mutState().setCurSystem(nullptr);
+    ctx.mutState().setCurSystemFromPrevLayout(false);
+    return true;
+}
+
+//---------------------------------------------------------
+//   samePageGeometry
+//    margins and header/footer extensions depend on the page
+//    number (odd/even, first page, page number macros)
+//---------------------------------------------------------
+
+bool ScorePageViewLayout::samePageGeometry(Page* page, page_idx_t no1, page_idx_t no2)
+{
+    const page_idx_t no = page->no();
+    auto geometry = [page](page_idx_t n) {
+        page->setNo(n);
+        return std::vector<double> { page->lm(), page->tm(), page->bm(), page->headerExtension(), page->footerExtension() };
+    };
+    const bool same = geometry(no1) == geometry(no2);
+    page->setNo(no);
+    return same;
+}
@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_SCOREPAGEVIEWLAYOUT_DEV_H
 #define MU_ENGRAVING_SCOREPAGEVIEWLAYOUT_DEV_H
 
+#include <vector>
+
 #include "layoutcontext.h"
 
 namespace mu::engraving::rendering::dev {
@@ -32,7 +34,15 @@ public:
     static void layoutPageView(Score* score, LayoutContext& ctx, const Fraction& stick, const Fraction& etick);
 
 private:
-    static void doLayout(LayoutContext& ctx);
+    // Systems of the pages from the first relaid one on, as they were before the layout
+    struct OldPages {
+        page_idx_t firstIdx = 0;
+        std::vector<std::vector<System*> > systems;
+    };
+
+    static void doLayout(LayoutContext& ctx, const OldPages& oldPages);
+    static bool takeOverFollowingPages(LayoutContext& ctx, const OldPages& oldPages);
+    static bool samePageGeometry(Page* page, page_idx_t no1, page_idx_t no2);
 };
 }
 
@@ -83,6 +83,11 @@ System* SystemLayout::collectSystem(LayoutContext& ctx)
         return nullptr;
     }
 
+    rendering::LayoutPassTimer profileTimer(ctx.profile(), "collectSystem");
+    if (ctx.profile()) {
+        ctx.profile()->addSystem();
+    }
+
     const MeasureBase* measure = ctx.dom().systems().empty() ? 0 : ctx.dom().systems().back()->measures().back();
     if (measure) {
         measure = measure->findPotentialSectionBreak();
@@ -701,6 +706,8 @@ void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
         return;
     }
 
+    rendering::LayoutPassTimer profileTimer(ctx.profile(), "layoutSystemElements");
+
     //-------------------------------------------------------------
     //    create cr segment list to speed up computations
     //-------------------------------------------------------------
@@ -167,6 +167,12 @@ void TLayout::layoutItem(EngravingItem* item, LayoutContext& ctx)
 {
     //DO_ASSERT(!ctx.conf().isPaletteMode());
 
+    rendering::LayoutProfile* profile = ctx.profile();
+    rendering::LayoutProfile::clock::time_point profileStart;
+    if (profile) {
+        profileStart = rendering::LayoutProfile::clock::now();
+    }
+
     EngravingItem::LayoutData* ldata = item->mutldata();
 
     switch (item->type()) {
@@ -434,6 +440,11 @@ void TLayout::layoutItem(EngravingItem* item, LayoutContext& ctx)
         LOGE() << "not found in layout types item: " << item->typeName();
         DO_ASSERT(false);
     }
+
+    //! NOTE Inclusive, the items laid out from within this one are counted for their own types as well
+    if (profile) {
+        profile->addItem(item->type(), rendering::LayoutProfile::nsecSince(profileStart));
+    }
 }
 
 void TLayout::layoutAccidental(const Accidental* item, Accidental::LayoutData* ldata, const LayoutConfiguration& conf)
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ILAYOUTPROFILER_H
+#define MU_ENGRAVING_ILAYOUTPROFILER_H
+
+#include <memory>
+#include <vector>
+
+#include "modularity/imoduleinterface.h"
+
+#include "types/bytearray.h"
+#include "types/string.h"
+
+namespace mu::engraving::rendering {
+class LayoutProfile;
+using LayoutProfilePtr = std::shared_ptr<LayoutProfile>;
+
+class ILayoutProfiler : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(ILayoutProfiler)
+
+public:
+    virtual ~ILayoutProfiler() = default;
+
+    virtual bool isEnabled() const = 0;
+    virtual void setEnabled(bool arg) = 0;
+
+    //! NOTE Returns null while disabled
+    virtual LayoutProfilePtr startRun(const String& scoreName) = 0;
+    virtual void finishRun(const LayoutProfilePtr& profile) = 0;
+
+    virtual std::vector<LayoutProfilePtr> runs() const = 0;
+    virtual void clear() = 0;
+
+    virtual ByteArray toJson() const = 0;
+};
+}
+
+#endif // MU_ENGRAVING_ILAYOUTPROFILER_H
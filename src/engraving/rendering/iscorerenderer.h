@@ -108,6 +108,9 @@ public:
         int copyCount = 1;
         int trimMarginPixelSize = -1;
         int deviceDpi = -1;
+        //! NOTE Replay the display lists of the pages, recorded once after layout,
+        //! instead of drawing every item again. For views painting the same pages many times.
+        bool useDisplayList = false;
 
         std::function<void(draw::Painter* painter, const Page* page, const RectF& pageRect)> onPaintPageSheet;
         std::function<void()> onNewPage;
@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_LAYOUTOPTIONS_H
 #define MU_ENGRAVING_LAYOUTOPTIONS_H
 
+#include <cstddef>
+
 namespace mu::engraving {
 //---------------------------------------------------------
 //   LayoutMode
@@ -42,6 +44,13 @@ struct LayoutOptions
     bool isShowVBox = true;
     double noteHeadWidth = 0.0;
 
+    //! NOTE If not 0, page view layout stops once this number of pages is laid out,
+    //! the rest of the score is laid out later (see Score::continueLayout)
+    size_t pageLimit = 0;
+
+    //! NOTE If false, the passes that spread their work over threads run on the calling thread only
+    bool isParallel = true;
+
     bool isMode(LayoutMode m) const { return mode == m; }
     bool isLinearMode() const { return mode == LayoutMode::LINE || mode == LayoutMode::HORIZONTAL_FIXED; }
 };
@@ -0,0 +1,217 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "layoutprofiler.h"
+
+#include <cstring>
+
+#include "serialization/json.h"
+
+#include "types/typesconv.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace mu::engraving::rendering;
+
+static double toMsec(uint64_t nsec)
+{
+    return static_cast<double>(nsec) / 1000000.0;
+}
+
+// ============================================================
+// LayoutProfile
+// ============================================================
+
+LayoutProfile::LayoutProfile(const String& scoreName)
+    : m_scoreName(scoreName), m_start(clock::now())
+{
+}
+
+void LayoutProfile::setRange(int startTick, int endTick, bool isLayoutAll)
+{
+    m_startTick = startTick;
+    m_endTick = endTick;
+    m_isLayoutAll = isLayoutAll;
+}
+
+void LayoutProfile::finish()
+{
+    m_totalNsec = nsecSince(m_start);
+}
+
+void LayoutProfile::addPass(const char* name, uint64_t nsec)
+{
+    for (auto& p : m_passes) {
+        if (std::strcmp(p.first.c_str(), name) == 0) {
+            p.second.calls++;
+            p.second.nsec += nsec;
+            return;
+        }
+    }
+
+    m_passes.push_back({ name, Timing { 1, nsec } });
+}
+
+void LayoutProfile::addMeasure(int no, int tick, uint64_t nsec)
+{
+    m_measures.push_back(MeasureTiming { no, tick, nsec });
+}
+
+void LayoutProfile::addItem(ElementType type, uint64_t nsec)
+{
+    size_t idx = static_cast<size_t>(type);
+    if (idx >= m_itemCalls.size()) {
+        return;
+    }
+
+    m_itemCalls[idx].fetch_add(1, std::memory_order_relaxed);
+    m_itemNsec[idx].fetch_add(nsec, std::memory_order_relaxed);
+}
+
+LayoutProfile::Timing LayoutProfile::itemTiming(ElementType type) const
+{
+    size_t idx = static_cast<size_t>(type);
+    if (idx >= m_itemCalls.size()) {
+        return Timing();
+    }
+
+    return Timing { m_itemCalls[idx].load(std::memory_order_relaxed), m_itemNsec[idx].load(std::memory_order_relaxed) };
+}
+
+uint64_t LayoutProfile::itemsCount() const
+{
+    uint64_t count = 0;
+    for (const std::atomic<uint64_t>& c : m_itemCalls) {
+        count += c.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t LayoutProfile::nsecSince(const clock::time_point& start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+}
+
+// ============================================================
+// LayoutProfiler
+// ============================================================
+
+void LayoutProfiler::setEnabled(bool arg)
+{
+    m_enabled = arg;
+}
+
+LayoutProfilePtr LayoutProfiler::startRun(const String& scoreName)
+{
+    if (!m_enabled) {
+        return nullptr;
+    }
+
+    return std::make_shared<LayoutProfile>(scoreName);
+}
+
+void LayoutProfiler::finishRun(const LayoutProfilePtr& profile)
+{
+    if (!profile) {
+        return;
+    }
+
+    profile->finish();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_runs.push_back(profile);
+    while (m_runs.size() > MAX_RUNS) {
+        m_runs.pop_front();
+    }
+}
+
+std::vector<LayoutProfilePtr> LayoutProfiler::runs() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<LayoutProfilePtr>(m_runs.begin(), m_runs.end());
+}
+
+void LayoutProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_runs.clear();
+}
+
+ByteArray LayoutProfiler::toJson() const
+{
+    JsonArray runsArr;
+    for (const LayoutProfilePtr& run : runs()) {
+        JsonObject runObj;
+        runObj.set("score", run->scoreName());
+        runObj.set("startTick", run->startTick());
+        runObj.set("endTick", run->endTick());
+        runObj.set("layoutAll", run->isLayoutAll());
+        runObj.set("totalMs", toMsec(run->totalNsec()));
+        runObj.set("items", static_cast<double>(run->itemsCount()));
+        runObj.set("systems", static_cast<int>(run->systemsCount()));
+        runObj.set("pages", static_cast<int>(run->pagesCount()));
+        runObj.set("measureWidthHits", static_cast<int>(run->measureWidthHits()));
+        runObj.set("measureWidthMisses", static_cast<int>(run->measureWidthMisses()));
+
+        JsonArray passesArr;
+        for (const auto& p : run->passes()) {
+            JsonObject passObj;
+            passObj.set("name", p.first);
+            passObj.set("calls", static_cast<double>(p.second.calls));
+            passObj.set("ms", toMsec(p.second.nsec));
+            passesArr.append(passObj);
+        }
+        runObj.set("passes", passesArr);
+
+        JsonArray typesArr;
+        for (size_t i = 0; i < TOT_ELEMENT_TYPES; ++i) {
+            ElementType type = static_cast<ElementType>(i);
+            LayoutProfile::Timing t = run->itemTiming(type);
+            if (t.calls == 0) {
+                continue;
+            }
+
+            JsonObject typeObj;
+            typeObj.set("type", TConv::toXml(type).ascii());
+            typeObj.set("calls", static_cast<double>(t.calls));
+            typeObj.set("ms", toMsec(t.nsec));
+            typesArr.append(typeObj);
+        }
+        runObj.set("types", typesArr);
+
+        JsonArray measuresArr;
+        for (const LayoutProfile::MeasureTiming& m : run->measures()) {
+            JsonObject measureObj;
+            measureObj.set("no", m.no);
+            measureObj.set("tick", m.tick);
+            measureObj.set("ms", toMsec(m.nsec));
+            measuresArr.append(measureObj);
+        }
+        runObj.set("measures", measuresArr);
+
+        runsArr.append(runObj);
+    }
+
+    JsonObject root;
+    root.set("runs", runsArr);
+
+    return JsonDocument(root).toJson();
+}
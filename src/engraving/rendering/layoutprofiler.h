@@ -0,0 +1,191 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_LAYOUTPROFILER_H
+#define MU_ENGRAVING_LAYOUTPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types/bytearray.h"
+#include "types/string.h"
+
+#include "types/types.h"
+
+#include "ilayoutprofiler.h"
+
+namespace mu::engraving::rendering {
+//---------------------------------------------------------
+//   LayoutProfile
+//    The timings of one layout run, that is one call of
+//    layoutRange() for one score.
+//    Passes and measures are added by the thread that owns
+//    the layout context, items may be laid out by several
+//    threads at once.
+//---------------------------------------------------------
+
+class LayoutProfile
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Timing {
+        uint64_t calls = 0;
+        uint64_t nsec = 0;
+    };
+
+    struct MeasureTiming {
+        int no = 0;
+        int tick = 0;
+        uint64_t nsec = 0;
+    };
+
+    LayoutProfile(const String& scoreName);
+
+    const String& scoreName() const { return m_scoreName; }
+
+    void setRange(int startTick, int endTick, bool isLayoutAll);
+    int startTick() const { return m_startTick; }
+    int endTick() const { return m_endTick; }
+    bool isLayoutAll() const { return m_isLayoutAll; }
+
+    void finish();
+    uint64_t totalNsec() const { return m_totalNsec; }
+
+    void addPass(const char* name, uint64_t nsec);
+    const std::vector<std::pair<std::string, Timing> >& passes() const { return m_passes; }
+
+    void addMeasure(int no, int tick, uint64_t nsec);
+    const std::vector<MeasureTiming>& measures() const { return m_measures; }
+
+    //! NOTE Thread safe
+    void addItem(ElementType type, uint64_t nsec);
+    Timing itemTiming(ElementType type) const;
+    uint64_t itemsCount() const;
+
+    void addSystem() { ++m_systemsCount; }
+    size_t systemsCount() const { return m_systemsCount; }
+
+    void addPage() { ++m_pagesCount; }
+    size_t pagesCount() const { return m_pagesCount; }
+
+    //! NOTE Lookups of the measure widths memoized by MeasureLayout::computeWidth
+    void addMeasureWidthLookup(bool hit) { ++(hit ? m_measureWidthHits : m_measureWidthMisses); }
+    size_t measureWidthHits() const { return m_measureWidthHits; }
+    size_t measureWidthMisses() const { return m_measureWidthMisses; }
+
+    static uint64_t nsecSince(const clock::time_point& start);
+
+private:
+    String m_scoreName;
+    int m_startTick = 0;
+    int m_endTick = 0;
+    bool m_isLayoutAll = false;
+
+    clock::time_point m_start;
+    uint64_t m_totalNsec = 0;
+
+    std::vector<std::pair<std::string, Timing> > m_passes;
+    std::vector<MeasureTiming> m_measures;
+    size_t m_systemsCount = 0;
+    size_t m_pagesCount = 0;
+    size_t m_measureWidthHits = 0;
+    size_t m_measureWidthMisses = 0;
+
+    std::array<std::atomic<uint64_t>, TOT_ELEMENT_TYPES> m_itemCalls = {};
+    std::array<std::atomic<uint64_t>, TOT_ELEMENT_TYPES> m_itemNsec = {};
+};
+
+//---------------------------------------------------------
+//   LayoutProfiler
+//    Collects the profiles of the layout runs while it is
+//    enabled. Disabled by default, then layout does not
+//    measure anything.
+//---------------------------------------------------------
+
+class LayoutProfiler : public ILayoutProfiler
+{
+public:
+    LayoutProfiler() = default;
+
+    bool isEnabled() const override { return m_enabled; }
+    void setEnabled(bool arg) override;
+
+    LayoutProfilePtr startRun(const String& scoreName) override;
+    void finishRun(const LayoutProfilePtr& profile) override;
+
+    std::vector<LayoutProfilePtr> runs() const override;
+    void clear() override;
+
+    ByteArray toJson() const override;
+
+private:
+    //! NOTE An enabled profiler in a long session should not grow without bound
+    static constexpr size_t MAX_RUNS = 10000;
+
+    std::atomic<bool> m_enabled = false;
+
+    mutable std::mutex m_mutex;
+    std::deque<LayoutProfilePtr> m_runs;
+};
+
+//---------------------------------------------------------
+//   LayoutPassTimer
+//    Adds the time of its scope as a pass to the profile,
+//    does nothing if there is no profile
+//---------------------------------------------------------
+
+class LayoutPassTimer
+{
+public:
+    LayoutPassTimer(LayoutProfile* profile, const char* name)
+        : m_profile(profile), m_name(name)
+    {
+        if (m_profile) {
+            m_start = LayoutProfile::clock::now();
+        }
+    }
+
+    ~LayoutPassTimer()
+    {
+        if (m_profile) {
+            m_profile->addPass(m_name, LayoutProfile::nsecSince(m_start));
+        }
+    }
+
+    LayoutPassTimer(const LayoutPassTimer&) = delete;
+    LayoutPassTimer& operator=(const LayoutPassTimer&) = delete;
+
+private:
+    LayoutProfile* m_profile = nullptr;
+    const char* m_name = nullptr;
+    LayoutProfile::clock::time_point m_start;
+};
+}
+
+#endif // MU_ENGRAVING_LAYOUTPROFILER_H
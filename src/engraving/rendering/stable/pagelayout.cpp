@@ -112,6 +112,8 @@ void PageLayout::collectPage(LayoutContext& ctx)
 {
     TRACEFUNC;
 
+    ctx.mutState().page()->markLayoutChanged();
+
     const double slb = ctx.conf().styleMM(Sid::staffLowerBorder);
     bool breakPages = ctx.conf().viewMode() != LayoutMode::SYSTEM;
     double footerExtension = ctx.state().page()->footerExtension();
@@ -84,6 +84,9 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
 
     ScoreLoad sl;
 
+    masterScore->arena()->setName(masterScore->fileInfo()->fileName().toStdString());
+    ObjectArena::Scope arenaScope(masterScore->arena());
+
     // Read style
     {
         ByteArray styleData = mscReader.readStyleFile();
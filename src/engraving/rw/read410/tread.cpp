@@ -784,7 +784,7 @@ void TRead::read(Instrument* item, XmlReader& e, ReadContext& ctx, Part* part)
     bool readSingleNoteDynamics = false;
 
     item->clearChannels();         // remove default channel
-    item->setId(e.attribute("id"));
+    item->setId(String::interned(e.attribute("id")));
     while (e.readNextStartElement()) {
         const AsciiStringView tag(e.name());
         if (tag == "singleNoteDynamics") {
@@ -862,7 +862,7 @@ bool TRead::readProperties(Instrument* item, XmlReader& e, ReadContext& ctx, Par
         transpose.diatonic = e.readInt();
         item->setTranspose(transpose);
     } else if (tag == "instrumentId") {
-        item->setMusicXmlId(e.readText());
+        item->setMusicXmlId(String::interned(e.readText()));
     } else if (tag == "useDrumset") {
         item->setUseDrumset(e.readInt());
         if (item->useDrumset()) {
@@ -132,7 +132,7 @@ bool MStyle::readProperties(XmlReader& e)
                 set(idx, DirectionV(e.readInt()));
                 break;
             case P_TYPE::STRING:
-                set(idx, e.readText());
+                set(idx, String::interned(e.readText()));
                 break;
             case P_TYPE::ALIGN: {
                 Align align = TConv::fromXml(e.readText(), Align());
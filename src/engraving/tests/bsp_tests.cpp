@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <set>
+
+#include "dom/masterscore.h"
+#include "dom/page.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_BspTests : public ::testing::Test
+{
+};
+
+static void collectItem(void* data, EngravingItem* e)
+{
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
+}
+
+//---------------------------------------------------------
+//   checkItems
+//    the tree must find exactly the items whose bounding
+//    rect intersects r, each of them once
+//---------------------------------------------------------
+
+static void checkItems(Page* page, const std::vector<EngravingItem*>& all, const RectF& r)
+{
+    std::vector<EngravingItem*> found = page->items(r);
+    std::set<EngravingItem*> foundSet(found.begin(), found.end());
+    EXPECT_EQ(found.size(), foundSet.size());
+
+    std::set<EngravingItem*> expected;
+    for (EngravingItem* e : all) {
+        if (e->pageBoundingRect().intersects(r)) {
+            expected.insert(e);
+        }
+    }
+    EXPECT_EQ(foundSet, expected);
+}
+
+static void checkPage(Page* page)
+{
+    std::vector<EngravingItem*> all;
+    page->scanElements(&all, collectItem, false);
+    ASSERT_FALSE(all.empty());
+
+    RectF pageRect = page->abbox();
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            double w = pageRect.width() / 8;
+            double h = pageRect.height() / 8;
+            checkItems(page, all, RectF(i * w, j * h, w * (1 + i % 3), h * (1 + j % 3)));
+        }
+    }
+    checkItems(page, all, pageRect);
+
+    for (EngravingItem* e : all) {
+        if (e->isPage()) {
+            continue;
+        }
+        PointF center = e->pageBoundingRect().center();
+        std::vector<EngravingItem*> found = page->items(center);
+        if (e->contains(center)) {
+            EXPECT_NE(std::find(found.begin(), found.end(), e), found.end());
+        }
+    }
+}
+
+TEST_F(Engraving_BspTests, pageItems)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    for (Page* page : score->pages()) {
+        checkPage(page);
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_BspTests, incrementalUpdate)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    checkPage(page);
+
+    // move some items by a distance larger than a leaf
+    std::vector<EngravingItem*> all;
+    page->scanElements(&all, collectItem, false);
+    double dx = page->abbox().width() / 3;
+    double dy = page->abbox().height() / 5;
+    for (size_t i = 0; i < all.size(); i += 7) {
+        if (!all[i]->isPage()) {
+            all[i]->mutldata()->setPos(all[i]->pos() + PointF(dx, dy));
+        }
+    }
+
+    page->invalidateBspTree();
+    checkPage(page);
+
+    // and back
+    for (size_t i = 0; i < all.size(); i += 7) {
+        if (!all[i]->isPage()) {
+            all[i]->mutldata()->setPos(all[i]->pos() - PointF(dx, dy));
+        }
+    }
+
+    page->invalidateBspTree();
+    checkPage(page);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   pageItemsBenchmark
+//    queries as done while scrolling and lasso selecting,
+//    run with --gtest_also_run_disabled_tests
+//---------------------------------------------------------
+
+TEST_F(Engraving_BspTests, DISABLED_pageItemsBenchmark)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    RectF pageRect = page->abbox();
+    std::vector<EngravingItem*> result;
+    size_t found = 0;
+
+    auto measure = [&](const char* name, const std::vector<RectF>& rects) {
+        auto start = std::chrono::steady_clock::now();
+        for (const RectF& r : rects) {
+            result.clear();
+            page->items(r, result);
+            found += result.size();
+        }
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        LOGI() << name << ": " << rects.size() << " queries, " << elapsed / rects.size() << " us/query";
+    };
+
+    constexpr int STEPS = 10000;
+
+    // a viewport of a quarter of the page scrolling down
+    std::vector<RectF> scrolling;
+    for (int i = 0; i < STEPS; ++i) {
+        double y = pageRect.height() * 0.75 * i / STEPS;
+        scrolling.emplace_back(0.0, y, pageRect.width(), pageRect.height() / 4);
+    }
+    measure("scrolling", scrolling);
+
+    // a lasso growing from the top left corner
+    std::vector<RectF> lasso;
+    for (int i = 1; i <= STEPS; ++i) {
+        lasso.emplace_back(0.0, 0.0, pageRect.width() * i / STEPS, pageRect.height() * i / STEPS);
+    }
+    measure("lasso", lasso);
+
+    // rebuild after an edit which doesn't move anything
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        page->invalidateBspTree();
+        result.clear();
+        page->items(pageRect, result);
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    LOGI() << "rebuild: " << elapsed / 100 << " us";
+
+    EXPECT_GT(found, 0);
+
+    delete score;
+}
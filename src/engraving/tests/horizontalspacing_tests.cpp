@@ -0,0 +1,174 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/segment.h"
+#include "rendering/dev/horizontalspacing.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace mu::engraving::rendering::dev;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_HorizontalSpacingTests : public ::testing::Test
+{
+public:
+    using ShapePair = std::pair<Shape, Shape>;
+    std::vector<ShapePair> collectShapePairs(MasterScore* score) const;
+};
+
+//---------------------------------------------------------
+//   referenceMinHorizontalDistance
+//    compares every element of one shape with every element
+//    of the other, the kernel must give the same result
+//---------------------------------------------------------
+
+static double referenceMinHorizontalDistance(const Shape& f, const Shape& s, double spatium, double squeezeFactor)
+{
+    double dist = -1000000.0;
+    double absoluteMinPadding = 0.1 * spatium * squeezeFactor;
+    double verticalClearance = 0.2 * spatium * squeezeFactor;
+    for (const ShapeElement& r2 : s.elements()) {
+        if (r2.isNull()) {
+            continue;
+        }
+        const EngravingItem* item2 = r2.item();
+        for (const ShapeElement& r1 : f.elements()) {
+            if (r1.isNull()) {
+                continue;
+            }
+            const EngravingItem* item1 = r1.item();
+            bool intersection = mu::engraving::intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom(), verticalClearance);
+            double padding = 0;
+            KerningType kerningType = KerningType::NON_KERNING;
+            if (item1 && item2) {
+                padding = HorizontalSpacing::computePadding(item1, item2);
+                padding *= squeezeFactor;
+                padding = std::max(padding, absoluteMinPadding);
+                kerningType = HorizontalSpacing::computeKerning(item1, item2);
+            }
+            if ((intersection && kerningType != KerningType::ALLOW_COLLISION)
+                || (r1.width() == 0 || r2.width() == 0)
+                || (!item1 && item2 && item2->isLyrics())
+                || kerningType == KerningType::NON_KERNING) {
+                dist = std::max(dist, r1.right() - r2.left() + padding);
+            }
+            if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) {
+                dist = std::max(dist, r1.left() - r2.left());
+            }
+        }
+    }
+    return dist;
+}
+
+//---------------------------------------------------------
+//   collectShapePairs
+//    staff shapes of all adjacent segments, as they are
+//    passed to minHorizontalDistance during layout
+//---------------------------------------------------------
+
+std::vector<Engraving_HorizontalSpacingTests::ShapePair> Engraving_HorizontalSpacingTests::collectShapePairs(MasterScore* score) const
+{
+    std::vector<ShapePair> pairs;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (Segment* s = m->first(); s; s = s->next()) {
+            Segment* ns = s->next();
+            if (!ns || !s->enabled() || !ns->enabled()) {
+                continue;
+            }
+            for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                pairs.emplace_back(s->staffShape(staffIdx), ns->staffShape(staffIdx));
+            }
+        }
+    }
+    return pairs;
+}
+
+TEST_F(Engraving_HorizontalSpacingTests, minHorizontalDistance)
+{
+    for (const String& file : { String(u"moonlight.mscx"), String(u"layout_elements.mscx") }) {
+        MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+        ASSERT_TRUE(score);
+
+        std::vector<ShapePair> pairs = collectShapePairs(score);
+        EXPECT_FALSE(pairs.empty());
+
+        for (const ShapePair& p : pairs) {
+            double sp = HorizontalSpacing::shapeSpatium(p.first);
+            for (double squeezeFactor : { 1.0, 0.5 }) {
+                EXPECT_DOUBLE_EQ(HorizontalSpacing::minHorizontalDistance(p.first, p.second, sp, squeezeFactor),
+                                 referenceMinHorizontalDistance(p.first, p.second, sp, squeezeFactor));
+            }
+        }
+
+        delete score;
+    }
+}
+
+//---------------------------------------------------------
+//   minHorizontalDistanceBenchmark
+//    run with --gtest_also_run_disabled_tests
+//---------------------------------------------------------
+
+TEST_F(Engraving_HorizontalSpacingTests, DISABLED_minHorizontalDistanceBenchmark)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<ShapePair> pairs = collectShapePairs(score);
+    ASSERT_FALSE(pairs.empty());
+
+    constexpr int ITERATIONS = 200;
+    auto measure = [&pairs](auto func) {
+        double sum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            for (const ShapePair& p : pairs) {
+                sum += func(p.first, p.second, HorizontalSpacing::shapeSpatium(p.first), 1.0);
+            }
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(elapsed / (ITERATIONS * pairs.size()), sum);
+    };
+
+    auto kernel = measure([](const Shape& f, const Shape& s, double sp, double sq) {
+        return HorizontalSpacing::minHorizontalDistance(f, s, sp, sq);
+    });
+    auto reference = measure(referenceMinHorizontalDistance);
+
+    EXPECT_DOUBLE_EQ(kernel.second, reference.second);
+    LOGI() << "pairs: " << pairs.size()
+           << ", kernel: " << kernel.first << " ns/pair"
+           << ", reference: " << reference.first << " ns/pair";
+
+    delete score;
+}
@@ -32,6 +32,7 @@
 #include "dom/note.h"
 
 #include "utils/scorerw.h"
+#include "utils/scorecomp.h"
 
 #include "log.h"
 
@@ -151,3 +152,31 @@ TEST_F(Engraving_LayoutElementsTests, tstLayoutCrossStaffArp)
 
     delete score;
 }
+
+//---------------------------------------------------------
+//   tstParallelLayoutDeterministic
+//    the layout of independent items spread over threads
+//    must give the same result as the serial layout
+//---------------------------------------------------------
+
+TEST_F(Engraving_LayoutElementsTests, tstParallelLayoutDeterministic)
+{
+    for (const String& file : { String(u"moonlight.mscx"), String(u"layout_elements_tab.mscx") }) {
+        MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+        ASSERT_TRUE(score);
+
+        score->setParallelLayout(false);
+        score->doLayout();
+        const String serial = ScoreComp::layoutData(score);
+        EXPECT_FALSE(serial.isEmpty());
+
+        score->setParallelLayout(true);
+        for (int run = 0; run < 3; ++run) {
+            score->doLayout();
+            EXPECT_EQ(ScoreComp::layoutData(score), serial) << file.toStdString();
+        }
+
+        delete score;
+    }
+}
+
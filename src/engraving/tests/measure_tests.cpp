@@ -22,6 +22,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "dom/engravingitem.h"
 #include "dom/masterscore.h"
 #include "dom/measure.h"
@@ -567,3 +570,318 @@ TEST_F(Engraving_MeasureTests, measureNumbers)
 
     delete score;
 }
+
+//---------------------------------------------------------
+///   tick2measureIndex
+///    tick lookups must follow insertion, undo and
+///    multimeasure rest changes
+//---------------------------------------------------------
+
+static void checkTick2Measure(MasterScore* score)
+{
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        EXPECT_EQ(score->tick2measure(m->tick()), m);
+        EXPECT_EQ(score->tick2measure(m->endTick() - Fraction::fromTicks(1)), m);
+        EXPECT_EQ(score->tick2measureBase(m->tick()), m);
+    }
+    for (Measure* m = score->firstMeasureMM(); m; m = m->nextMeasureMM()) {
+        EXPECT_EQ(score->tick2measureMM(m->tick()), m);
+    }
+
+    Measure* lm = score->lastMeasure();
+    EXPECT_EQ(score->tick2measure(lm->endTick()), lm);
+    EXPECT_EQ(score->tick2measure(lm->endTick() + Fraction::fromTicks(1)), nullptr);
+    EXPECT_EQ(score->tick2measureBase(lm->endTick()), nullptr);
+}
+
+TEST_F(Engraving_MeasureTests, tick2measureIndex)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"mmrest.mscx");
+    EXPECT_TRUE(score);
+    checkTick2Measure(score);
+
+    score->startCmd();
+    score->insertMeasure(score->firstMeasure()->nextMeasure());
+    score->endCmd();
+    checkTick2Measure(score);
+
+    score->startCmd();
+    score->undo(new ChangeStyleVal(score, Sid::createMultiMeasureRests, true));
+    score->setLayoutAll();
+    score->endCmd();
+    checkTick2Measure(score);
+
+    score->undoRedo(true, 0);
+    checkTick2Measure(score);
+    score->undoRedo(true, 0);
+    checkTick2Measure(score);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   segmentTypeIndex
+///    typed segment navigation must match a walk over the
+///    segment list after insertion and undo
+//---------------------------------------------------------
+
+static void checkSegmentIndex(Score* score)
+{
+    static const std::vector<SegmentType> types {
+        SegmentType::ChordRest, SegmentType::Clef, SegmentType::HeaderClef, SegmentType::KeySig, SegmentType::TimeSig,
+        SegmentType::EndBarLine, SegmentType::BarLineType, SegmentType::ChordRest | SegmentType::Clef, SegmentType::All
+    };
+
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (SegmentType t : types) {
+            Segment* first = nullptr;
+            for (Segment* s = m->first(); s; s = s->next()) {
+                if (s->segmentType() & t) {
+                    first = s;
+                    break;
+                }
+            }
+            EXPECT_EQ(m->first(t), first);
+
+            for (Segment* s = m->first(); s; s = s->next()) {
+                Segment* next = s->next();
+                while (next && !(next->segmentType() & t)) {
+                    next = next->next();
+                }
+                EXPECT_EQ(s->next(t), next);
+
+                Segment* prev = s->prev();
+                while (prev && !(prev->segmentType() & t)) {
+                    prev = prev->prev();
+                }
+                EXPECT_EQ(s->prev(t), prev);
+
+                Segment* found = nullptr;
+                for (Segment* fs = m->first(); fs && fs->rtick() <= s->rtick(); fs = fs->next()) {
+                    if (fs->rtick() == s->rtick() && (fs->segmentType() & t)) {
+                        found = fs;
+                        break;
+                    }
+                }
+                EXPECT_EQ(m->findSegmentR(t, s->rtick()), found);
+            }
+        }
+
+        std::vector<Segment*> crSegments;
+        for (Segment* s = m->first(); s; s = s->next()) {
+            if (s->isChordRestType()) {
+                crSegments.push_back(s);
+            }
+        }
+        EXPECT_EQ(m->segments().segments(SegmentType::ChordRest), crSegments);
+    }
+}
+
+TEST_F(Engraving_MeasureTests, segmentTypeIndex)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-insert_bf_clef.mscx");
+    EXPECT_TRUE(score);
+    checkSegmentIndex(score);
+
+    Measure* m = score->firstMeasure()->nextMeasure()->nextMeasure()->nextMeasure();
+    score->startCmd();
+    score->insertMeasure(m);
+    score->endCmd();
+    checkSegmentIndex(score);
+
+    score->undoRedo(true, 0);
+    checkSegmentIndex(score);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   findCR
+///    compare the chord/rest lookups with a forward walk
+///    over the chord/rest segments of the measure
+//---------------------------------------------------------
+
+TEST_F(Engraving_MeasureTests, findCR)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"gaps.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    Segment* s = score->firstMeasure()->undoGetSegment(SegmentType::ChordRest, Fraction::fromTicks(960));
+    score->select(s->element(1));
+    score->cmdDeleteSelection();
+    score->endCmd();
+
+    auto linearFindCR = [score](Fraction tick, track_idx_t track) -> ChordRest* {
+        Measure* m = score->tick2measureMM(tick);
+        Segment* s = m->first(SegmentType::ChordRest);
+        for (Segment* ns = s; ns && ns->tick() <= tick; ns = ns->next(SegmentType::ChordRest)) {
+            EngravingItem* el = ns->element(track);
+            if (el && !(el->isRest() && toRest(el)->isGap())) {
+                s = ns;
+            }
+        }
+        EngravingItem* el = s ? s->element(track) : nullptr;
+        if (!el || (el->isRest() && toRest(el)->isGap())) {
+            return nullptr;
+        }
+        return toChordRest(el);
+    };
+
+    auto linearFindCRinStaff = [score](const Fraction& tick, staff_idx_t staffIdx) -> ChordRest* {
+        Fraction ptick = tick - Fraction::fromTicks(1);
+        Measure* m = score->tick2measureMM(ptick);
+        Segment* s = m->first(SegmentType::ChordRest);
+        track_idx_t actualTrack = staffIdx * VOICES;
+        Fraction lastTick = Fraction(-1, 1);
+        for (Segment* ns = s; ns && ns->tick() <= ptick; ns = ns->next(SegmentType::ChordRest)) {
+            for (track_idx_t t = staffIdx * VOICES; t < (staffIdx + 1) * VOICES; ++t) {
+                ChordRest* cr = toChordRest(ns->element(t));
+                if (cr) {
+                    Fraction endTick = cr->tick() + cr->actualTicks();
+                    if (endTick >= lastTick && endTick <= tick) {
+                        s = ns;
+                        actualTrack = t;
+                        lastTick = endTick;
+                    }
+                }
+            }
+        }
+        return s ? toChordRest(s->element(actualTrack)) : nullptr;
+    };
+
+    for (Segment* seg = score->firstSegment(SegmentType::ChordRest); seg; seg = seg->next1(SegmentType::ChordRest)) {
+        for (Fraction tick : { seg->tick(), seg->tick() + Fraction::fromTicks(1) }) {
+            for (track_idx_t track = 0; track < score->ntracks(); ++track) {
+                EXPECT_EQ(score->findCR(tick, track), linearFindCR(tick, track));
+            }
+            for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                EXPECT_EQ(score->findCRinStaff(tick + Fraction::fromTicks(1), staffIdx),
+                          linearFindCRinStaff(tick + Fraction::fromTicks(1), staffIdx));
+            }
+        }
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   tick2measureConcurrent
+///    layout threads look up ticks at the same time, the
+///    first lookup after an edit rebuilds the index
+//---------------------------------------------------------
+
+TEST_F(Engraving_MeasureTests, tick2measureConcurrent)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(200);
+    score->endCmd();
+
+    std::vector<Fraction> ticks;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        ticks.push_back(s->tick());
+    }
+
+    std::vector<Measure*> expected;
+    for (const Fraction& tick : ticks) {
+        expected.push_back(score->tick2measure(tick));
+    }
+
+    for (int run = 0; run < 10; ++run) {
+        score->measures()->invalidateTickIndex();
+
+        const size_t threadCount = 8;
+        std::vector<std::vector<Measure*> > found(threadCount);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([score, &ticks, &result = found[t]]() {
+                for (const Fraction& tick : ticks) {
+                    result.push_back(score->tick2measure(tick));
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (const std::vector<Measure*>& result : found) {
+            EXPECT_EQ(result, expected);
+        }
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   tick2measureBenchmark
+///    cursor navigation and range selection on a large
+///    score, compared against a walk over the measure list.
+///    Run with --gtest_also_run_disabled_tests
+//---------------------------------------------------------
+
+TEST_F(Engraving_MeasureTests, DISABLED_tick2measureBenchmark)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(1500);
+    score->endCmd();
+
+    auto linearTick2measure = [score](const Fraction& tick) {
+        Measure* lm = nullptr;
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            if (tick < m->tick()) {
+                return lm;
+            }
+            lm = m;
+        }
+        return lm;
+    };
+
+    using clock = std::chrono::steady_clock;
+    auto elapsedMs = [](clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start).count();
+    };
+
+    std::vector<Fraction> ticks;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        ticks.push_back(s->tick());
+    }
+
+    std::vector<Measure*> expected;
+    clock::time_point start = clock::now();
+    for (const Fraction& tick : ticks) {
+        expected.push_back(linearTick2measure(tick));
+    }
+    RecordProperty("linearLookupMs", std::to_string(elapsedMs(start)));
+
+    std::vector<Measure*> found;
+    start = clock::now();
+    for (const Fraction& tick : ticks) {
+        found.push_back(score->tick2measure(tick));
+    }
+    RecordProperty("indexedLookupMs", std::to_string(elapsedMs(start)));
+    EXPECT_EQ(found, expected);
+
+    start = clock::now();
+    for (const Fraction& tick : ticks) {
+        score->findCR(tick, 0);
+        score->tick2segment(tick, true, SegmentType::ChordRest);
+    }
+    RecordProperty("cursorNavigationMs", std::to_string(elapsedMs(start)));
+
+    start = clock::now();
+    for (size_t i = 0; i + 8 < ticks.size(); i += 8) {
+        score->selection().setRangeTicks(ticks[i], ticks[i + 8], 0, score->nstaves());
+        score->selection().updateSelectedElements();
+    }
+    score->deselectAll();
+    RecordProperty("rangeSelectionMs", std::to_string(elapsedMs(start)));
+
+    delete score;
+}
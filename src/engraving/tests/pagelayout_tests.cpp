@@ -0,0 +1,490 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/page.h"
+#include "dom/segment.h"
+#include "dom/system.h"
+
+#include "rendering/layoutprofiler.h"
+#include "rendering/dev/scorelayout.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String MEASURE_DATA_DIR(u"measure_data/");
+
+class Engraving_PageLayoutTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+///   PageSystems
+///    what a page holds: its position and, for every system,
+///    the ticks it spans and its vertical position
+//---------------------------------------------------------
+
+struct PageSystems {
+    page_idx_t no = 0;
+    PointF pos;
+    std::vector<std::pair<Fraction, Fraction> > ticks;
+    std::vector<double> y;
+
+    bool operator==(const PageSystems& p) const
+    {
+        return no == p.no && pos == p.pos && ticks == p.ticks && y == p.y;
+    }
+};
+
+static std::vector<PageSystems> pageSystems(Score* score)
+{
+    std::vector<PageSystems> result;
+    for (const Page* page : score->pages()) {
+        PageSystems ps;
+        ps.no = page->no();
+        ps.pos = page->pos();
+        for (const System* s : page->systems()) {
+            ps.ticks.push_back({ s->measures().front()->tick(), s->measures().back()->endTick() });
+            ps.y.push_back(s->y());
+        }
+        result.push_back(ps);
+    }
+    return result;
+}
+
+static void expectSameAsFullLayout(MasterScore* score)
+{
+    std::vector<PageSystems> incremental = pageSystems(score);
+
+    score->setLayoutAll();
+    score->update();
+    std::vector<PageSystems> full = pageSystems(score);
+
+    ASSERT_EQ(incremental.size(), full.size());
+    for (size_t i = 0; i < full.size(); ++i) {
+        EXPECT_TRUE(incremental[i] == full[i]) << "page " << i;
+    }
+}
+
+//---------------------------------------------------------
+///   movedPageBreaks
+///    removing and restoring a page break moves all following
+///    pages by one; the incremental layout, which takes them
+///    over from the previous layout, must match a full layout
+//---------------------------------------------------------
+
+TEST_F(Engraving_PageLayoutTests, movedPageBreaks)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(80);
+    int n = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (++n % 8 == 0) {
+            m->undoSetPageBreak(true);
+        }
+    }
+    score->endCmd();
+    expectSameAsFullLayout(score);
+    size_t npages = score->npages();
+
+    Measure* m = score->firstMeasure();
+    for (int i = 1; i < 8; ++i) {
+        m = m->nextMeasure();
+    }
+
+    score->startCmd();
+    m->undoSetPageBreak(false);
+    score->endCmd();
+    EXPECT_EQ(score->npages(), npages - 1);
+    expectSameAsFullLayout(score);
+
+    score->undoRedo(true, 0);
+    EXPECT_EQ(score->npages(), npages);
+    expectSameAsFullLayout(score);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   pagedScore
+///    measure-1 with 80 more measures and a page break
+///    every 8 measures, laid out in full
+//---------------------------------------------------------
+
+static MasterScore* pagedScore()
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(80);
+    int n = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (++n % 8 == 0) {
+            m->undoSetPageBreak(true);
+        }
+    }
+    score->endCmd();
+    EXPECT_FALSE(score->layoutPending());
+    return score;
+}
+
+static Measure* nthMeasure(Score* score, int n)
+{
+    Measure* m = score->firstMeasure();
+    for (int i = 1; i < n && m; ++i) {
+        m = m->nextMeasure();
+    }
+    return m;
+}
+
+//---------------------------------------------------------
+///   progressiveLayout
+///    a progressive layout lays out the first pages only,
+///    continuing it must end up with the pages of a full layout;
+///    commands and undo keep the pending layout and the rest
+///    of the score is laid out again from their result
+//---------------------------------------------------------
+
+TEST_F(Engraving_PageLayoutTests, progressiveLayout)
+{
+    MasterScore* score = pagedScore();
+    std::vector<PageSystems> full = pageSystems(score);
+    ASSERT_GT(full.size(), size_t(6));
+
+    score->setProgressiveLayout(2);
+    score->doLayout();
+    EXPECT_EQ(score->npages(), size_t(2));
+    EXPECT_TRUE(score->layoutPending());
+
+    score->continueLayout(3);
+    EXPECT_EQ(score->npages(), size_t(5));
+    EXPECT_TRUE(score->layoutPending());
+
+    score->finishLayout();
+    EXPECT_FALSE(score->layoutPending());
+    std::vector<PageSystems> progressive = pageSystems(score);
+    ASSERT_EQ(progressive.size(), full.size());
+    for (size_t i = 0; i < full.size(); ++i) {
+        EXPECT_TRUE(progressive[i] == full[i]) << "page " << i;
+    }
+
+    // restart, then remove a page break on the laid out pages:
+    // the command lays out these pages only
+    score->doLayout();
+    EXPECT_EQ(score->npages(), size_t(2));
+
+    score->startCmd();
+    EXPECT_TRUE(score->layoutPending());
+    EXPECT_EQ(score->npages(), size_t(2));
+    nthMeasure(score, 8)->undoSetPageBreak(false);
+    score->endCmd();
+
+    EXPECT_TRUE(score->layoutPending());
+    EXPECT_EQ(score->npages(), size_t(2));
+
+    // the pending layout restarts from the edited pages
+    score->continueLayout(1);
+    EXPECT_EQ(score->npages(), size_t(3));
+    score->finishLayout();
+    EXPECT_FALSE(score->layoutPending());
+    EXPECT_EQ(score->npages(), full.size() - 1);
+
+    // undo keeps a pending layout as well
+    score->doLayout();
+    ASSERT_TRUE(score->layoutPending());
+    score->undoRedo(true, nullptr);
+    EXPECT_TRUE(score->layoutPending());
+    EXPECT_EQ(score->npages(), size_t(2));
+
+    score->finishLayout();
+    EXPECT_EQ(score->npages(), full.size());
+    progressive = pageSystems(score);
+    ASSERT_EQ(progressive.size(), full.size());
+    for (size_t i = 0; i < full.size(); ++i) {
+        EXPECT_TRUE(progressive[i] == full[i]) << "page " << i;
+    }
+
+    score->setProgressiveLayout(0);
+    expectSameAsFullLayout(score);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   progressiveLayoutEditPastLimit
+///    relayouting a range after the laid out pages of a pending
+///    progressive layout lays out the score up to that range,
+///    the rest stays pending
+//---------------------------------------------------------
+
+TEST_F(Engraving_PageLayoutTests, progressiveLayoutEditPastLimit)
+{
+    MasterScore* score = pagedScore();
+    std::vector<PageSystems> full = pageSystems(score);
+
+    score->setProgressiveLayout(2);
+    score->doLayout();
+    ASSERT_TRUE(score->layoutPending());
+
+    Measure* m = nthMeasure(score, 60);
+    ASSERT_TRUE(m);
+    score->doLayoutRange(m->tick(), m->endTick());
+    EXPECT_TRUE(score->layoutPending());
+    EXPECT_LT(score->npages(), full.size());
+
+    std::vector<PageSystems> pages = pageSystems(score);
+    ASSERT_FALSE(pages.empty());
+    EXPECT_GE(pages.back().ticks.back().second, m->endTick());
+    for (size_t i = 0; i < pages.size(); ++i) {
+        EXPECT_TRUE(pages[i] == full[i]) << "page " << i;
+    }
+
+    score->finishLayout();
+    EXPECT_FALSE(score->layoutPending());
+
+    pages = pageSystems(score);
+    ASSERT_EQ(pages.size(), full.size());
+    for (size_t i = 0; i < full.size(); ++i) {
+        EXPECT_TRUE(pages[i] == full[i]) << "page " << i;
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   progressiveLayoutPageCount
+///    while a progressive layout is pending the score reports
+///    the laid out pages only, each one complete
+//---------------------------------------------------------
+
+TEST_F(Engraving_PageLayoutTests, progressiveLayoutPageCount)
+{
+    MasterScore* score = pagedScore();
+    std::vector<PageSystems> full = pageSystems(score);
+
+    score->setProgressiveLayout(1);
+    score->doLayout();
+
+    size_t expected = 1;
+    while (score->layoutPending()) {
+        EXPECT_EQ(score->npages(), expected);
+        std::vector<PageSystems> pages = pageSystems(score);
+        ASSERT_EQ(pages.size(), expected);
+        for (size_t i = 0; i < pages.size(); ++i) {
+            EXPECT_TRUE(pages[i] == full[i]) << "page " << i;
+        }
+        score->continueLayout(1);
+        ++expected;
+    }
+    EXPECT_EQ(score->npages(), full.size());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   layoutProfile
+///    an enabled profiler records one run per layout with
+///    the measures, systems and pages it touched; an
+///    incremental layout touches fewer measures than a full one
+//---------------------------------------------------------
+
+TEST_F(Engraving_PageLayoutTests, layoutProfile)
+{
+    using namespace mu::engraving::rendering;
+
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(80);
+    int n = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (++n % 8 == 0) {
+            m->undoSetPageBreak(true);
+        }
+    }
+    score->endCmd();
+
+    std::shared_ptr<LayoutProfiler> profiler = std::make_shared<LayoutProfiler>();
+    profiler->setEnabled(true);
+    dev::ScoreLayout::setlayoutProfiler(profiler);
+
+    score->doLayout();
+
+    std::vector<LayoutProfilePtr> runs = profiler->runs();
+    ASSERT_EQ(runs.size(), size_t(1));
+    const LayoutProfilePtr& full = runs.front();
+    EXPECT_TRUE(full->isLayoutAll());
+    EXPECT_GE(full->measures().size(), size_t(n));
+    EXPECT_EQ(full->systemsCount(), score->systems().size());
+    EXPECT_EQ(full->pagesCount(), score->npages());
+    EXPECT_GT(full->itemsCount(), uint64_t(0));
+
+    bool hasResetPass = false;
+    for (const auto& pass : full->passes()) {
+        if (pass.first == "PassResetLayoutData") {
+            hasResetPass = true;
+            EXPECT_EQ(pass.second.calls, uint64_t(1));
+        }
+    }
+    EXPECT_TRUE(hasResetPass);
+
+    profiler->clear();
+
+    Measure* m = score->firstMeasure();
+    for (int i = 1; i < 20; ++i) {
+        m = m->nextMeasure();
+    }
+    score->startCmd();
+    m->undoSetLineBreak(true);
+    score->endCmd();
+
+    runs = profiler->runs();
+    ASSERT_EQ(runs.size(), size_t(1));
+    EXPECT_FALSE(runs.front()->isLayoutAll());
+    EXPECT_FALSE(runs.front()->measures().empty());
+    EXPECT_LT(runs.front()->measures().size(), size_t(n));
+
+    EXPECT_NE(profiler->toJson().size(), size_t(0));
+
+    profiler->setEnabled(false);
+    profiler->clear();
+
+    score->doLayout();
+    EXPECT_TRUE(profiler->runs().empty());
+
+    dev::ScoreLayout::setlayoutProfiler(nullptr);
+    delete score;
+}
+
+//---------------------------------------------------------
+///   measureSpacing
+///    the widths of the measures and the positions of their
+///    segments
+//---------------------------------------------------------
+
+static std::vector<double> measureSpacing(Score* score)
+{
+    std::vector<double> result;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        result.push_back(m->width());
+        for (const Segment& s : m->segments()) {
+            result.push_back(s.x());
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+///   memoizedMeasureSpacing
+///    measures out of the range of an incremental layout take
+///    their memoized spacing, which must match the spacing a
+///    full layout computes
+//---------------------------------------------------------
+
+TEST_F(Engraving_PageLayoutTests, memoizedMeasureSpacing)
+{
+    using namespace mu::engraving::rendering;
+
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(40);
+    score->endCmd();
+    std::vector<double> full = measureSpacing(score);
+
+    std::shared_ptr<LayoutProfiler> profiler = std::make_shared<LayoutProfiler>();
+    profiler->setEnabled(true);
+    dev::ScoreLayout::setlayoutProfiler(profiler);
+
+    Measure* m = score->firstMeasure();
+    for (int i = 1; i < 6; ++i) {
+        m = m->nextMeasure();
+    }
+    score->startCmd();
+    m->undoSetLineBreak(true);
+    score->endCmd();
+    score->undoRedo(true, 0);
+
+    std::vector<LayoutProfilePtr> runs = profiler->runs();
+    ASSERT_EQ(runs.size(), size_t(2));
+    EXPECT_FALSE(runs.back()->isLayoutAll());
+    EXPECT_GT(runs.back()->measureWidthHits(), size_t(0));
+
+    dev::ScoreLayout::setlayoutProfiler(nullptr);
+
+    EXPECT_EQ(measureSpacing(score), full);
+
+    score->setLayoutAll();
+    score->update();
+    EXPECT_EQ(measureSpacing(score), full);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   memoizedSpacingDroppedOnSegmentChange
+///    adding or removing a segment drops the memoized spacing
+///    of its measure, the next layout spaces it again
+//---------------------------------------------------------
+
+TEST_F(Engraving_PageLayoutTests, memoizedSpacingDroppedOnSegmentChange)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(40);
+    score->endCmd();
+    std::vector<double> full = measureSpacing(score);
+
+    Measure* pm = score->firstMeasure()->nextMeasure();
+    Measure* m = pm->nextMeasure();
+    ASSERT_TRUE(m && m->system() == pm->system());
+    ASSERT_TRUE(m->ldata()->spacing);
+    const uint64_t generation = m->segments().generation();
+    EXPECT_EQ(m->ldata()->spacing->key.segmentsGeneration, generation);
+
+    Segment* seg = m->getSegmentR(SegmentType::Breath, Fraction(1, 4));
+    EXPECT_NE(m->segments().generation(), generation);
+    m->remove(seg);
+    delete seg;
+    EXPECT_NE(m->segments().generation(), generation);
+
+    // m is out of the range, it is spaced again with the rest of its system
+    score->doLayoutRange(pm->tick(), pm->endTick());
+    ASSERT_TRUE(m->ldata()->spacing);
+    EXPECT_EQ(m->ldata()->spacing->key.segmentsGeneration, m->segments().generation());
+    EXPECT_EQ(measureSpacing(score), full);
+
+    delete score;
+}
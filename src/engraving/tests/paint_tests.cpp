@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "draw/painter.h"
+#include "draw/bufferedpaintprovider.h"
+
+#include "dom/masterscore.h"
+#include "dom/page.h"
+
+#include "rendering/dev/paint.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace mu::draw;
+
+static const String VTEST_SCORES_DIR(u"../../../vtest/scores/");
+
+class Engraving_PaintTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   paintScore
+//    paints all pages into draw data
+//---------------------------------------------------------
+
+static DrawDataPtr paintScore(Score* score, bool useDisplayList)
+{
+    std::shared_ptr<BufferedPaintProvider> provider = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter painter(provider, "paint_tests");
+
+        rendering::IScoreRenderer::PaintOptions opt;
+        opt.isSetViewport = false;
+        opt.isMultiPage = true;
+        opt.printPageBackground = false;
+        opt.useDisplayList = useDisplayList;
+
+        rendering::dev::Paint::paintScore(&painter, score, opt);
+
+        painter.endDraw();
+    }
+
+    return provider->drawData();
+}
+
+//---------------------------------------------------------
+//   primitives
+//    every primitive of the draw data with the state it is
+//    drawn in, as text rounded like DrawDataComp does.
+//    The same items are painted in the same order by both
+//    paths, but items that compare equal in elementLessThan
+//    may be swapped, so the primitives are compared sorted.
+//---------------------------------------------------------
+
+static std::string str(double v)
+{
+    return std::to_string(std::lround(v * 1000.0));
+}
+
+static std::string str(const Transform& t)
+{
+    return "transform " + str(t.m11()) + " " + str(t.m12()) + " " + str(t.m21()) + " " + str(t.m22())
+           + " " + str(t.dx()) + " " + str(t.dy());
+}
+
+static std::string str(const Pen& pen)
+{
+    return "pen " + std::to_string(int(pen.style())) + " " + str(pen.widthF()) + " " + pen.color().toString();
+}
+
+static std::string str(const Brush& brush)
+{
+    return "brush " + std::to_string(int(brush.style())) + " " + brush.color().toString();
+}
+
+static std::string str(const RectF& r)
+{
+    return "rect " + str(r.x()) + " " + str(r.y()) + " " + str(r.width()) + " " + str(r.height());
+}
+
+static void collectPrimitives(const DrawData& data, const DrawData::Item& item, std::vector<std::string>& result)
+{
+    for (const DrawData::Data& d : item.datas) {
+        const DrawData::State& state = data.states.at(d.state);
+        const std::string stateStr = str(state.transform) + " " + std::to_string(state.isAntialiasing)
+                                     + " " + std::to_string(int(state.compositionMode));
+
+        for (const DrawPath& path : d.paths) {
+            std::string s = "path " + stateStr + " " + str(path.pen) + " " + str(path.brush) + " " + std::to_string(int(path.mode));
+            for (size_t i = 0; i < path.path.elementCount(); ++i) {
+                PainterPath::Element e = path.path.elementAt(i);
+                s += " " + std::to_string(int(e.type)) + " " + str(e.x) + " " + str(e.y);
+            }
+            result.push_back(s);
+        }
+
+        for (const DrawPolygon& polygon : d.polygons) {
+            std::string s = "polygon " + stateStr + " " + str(state.pen) + " " + str(state.brush) + " " + std::to_string(int(polygon.mode));
+            for (const PointF& p : polygon.polygon) {
+                s += " " + str(p.x()) + " " + str(p.y());
+            }
+            result.push_back(s);
+        }
+
+        for (const DrawText& text : d.texts) {
+            result.push_back("text " + stateStr + " " + str(state.pen) + " " + state.font.family().toStdString()
+                             + " " + str(state.font.pointSizeF()) + " " + std::to_string(int(text.mode)) + " " + str(text.rect)
+                             + " " + std::to_string(text.flags) + " " + text.text.toStdString());
+        }
+
+        for (const DrawPixmap& pixmap : d.pixmaps) {
+            result.push_back("pixmap " + stateStr + " " + std::to_string(int(pixmap.mode)) + " " + str(pixmap.rect)
+                             + " " + std::to_string(pixmap.pm.width()) + " " + std::to_string(pixmap.pm.height()));
+        }
+    }
+
+    for (const DrawData::Item& ch : item.chilren) {
+        collectPrimitives(data, ch, result);
+    }
+}
+
+static std::vector<std::string> primitives(const DrawDataPtr& data)
+{
+    std::vector<std::string> result;
+    collectPrimitives(*data, data->item, result);
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+static void checkPrimitives(const std::vector<std::string>& actual, const std::vector<std::string>& expected)
+{
+    EXPECT_EQ(actual.size(), expected.size());
+
+    for (size_t i = 0; i < std::min(actual.size(), expected.size()); ++i) {
+        if (actual.at(i) != expected.at(i)) {
+            ADD_FAILURE() << "first difference:\n  display list: " << actual.at(i) << "\n  direct:       " << expected.at(i);
+            break;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   displayListMatchesDirectPaint
+//    replaying the display lists paints the same as drawing
+//    every item, both when the lists are recorded and when
+//    they are replayed later
+//---------------------------------------------------------
+
+TEST_F(Engraving_PaintTests, displayListMatchesDirectPaint)
+{
+    const std::vector<String> files = {
+        u"accidental-1.mscx",
+        u"barline-1.mscx",
+        u"beams-1.mscz",
+        u"chord-layout-1.mscx",
+        u"hairpins-1.mscx",
+        u"layout-1.mscx",
+    };
+
+    for (const String& file : files) {
+        SCOPED_TRACE(file.toStdString());
+
+        MasterScore* score = ScoreRW::readScore(VTEST_SCORES_DIR + file);
+        ASSERT_TRUE(score);
+
+        const std::vector<std::string> direct = primitives(paintScore(score, false));
+        EXPECT_FALSE(direct.empty());
+
+        // [WHEN] The lists are recorded
+        checkPrimitives(primitives(paintScore(score, true)), direct);
+
+        for (const Page* page : score->pages()) {
+            ASSERT_TRUE(page->displayList());
+            EXPECT_GT(page->displayList()->memoryUsage, 0u);
+        }
+
+        // [WHEN] The recorded lists are replayed
+        checkPrimitives(primitives(paintScore(score, true)), direct);
+
+        // [WHEN] The direct path is used again
+        EXPECT_EQ(primitives(paintScore(score, false)), direct);
+
+        delete score;
+    }
+}
@@ -38,6 +38,7 @@
 #include "dom/part.h"
 #include "dom/segment.h"
 #include "dom/spanner.h"
+#include "dom/system.h"
 
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
@@ -303,6 +304,51 @@ TEST_F(Engraving_PartsTests, styleScoreReload)
     delete partScore;
 }
 
+static std::vector<std::pair<Fraction, double> > systemEnds(const Score* score)
+{
+    std::vector<std::pair<Fraction, double> > result;
+    for (const System* s : score->systems()) {
+        if (!s->measures().empty()) {
+            result.push_back({ s->measures().back()->endTick(), s->y() });
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   layoutClosedPartsOnDemand
+//    parts that are not open are only marked on changes,
+//    and laid out when their layout is asked for
+//---------------------------------------------------------
+
+TEST_F(Engraving_PartsTests, layoutClosedPartsOnDemand)
+{
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-all.mscx");
+    ASSERT_TRUE(score);
+
+    createParts(score);
+    Score* part = score->excerpts().front()->excerptScore();
+    ASSERT_FALSE(part->isOpen());
+    part->doLayout();
+    EXPECT_FALSE(part->needsLayout());
+    std::vector<std::pair<Fraction, double> > before = systemEnds(part);
+
+    score->startCmd();
+    score->appendMeasures(40);
+    score->endCmd();
+
+    EXPECT_FALSE(score->needsLayout());
+    EXPECT_TRUE(part->needsLayout());
+    EXPECT_EQ(systemEnds(part), before);
+
+    part->layoutIfNeeded();
+    EXPECT_FALSE(part->needsLayout());
+    ASSERT_FALSE(systemEnds(part).empty());
+    EXPECT_EQ(systemEnds(part).back().first, score->lastMeasure()->endTick());
+
+    delete score;
+}
+
 #if 0
 //---------------------------------------------------------
 //   stylePartDefault
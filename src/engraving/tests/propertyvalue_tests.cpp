@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "types/propertyvalue.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_PropertyValueTests : public ::testing::Test
+{
+};
+
+TEST_F(Engraving_PropertyValueTests, Size)
+{
+    //! NOTE Must not grow beyond the type tag plus a shared pointer
+    EXPECT_LE(sizeof(PropertyValue), 3 * sizeof(void*));
+}
+
+TEST_F(Engraving_PropertyValueTests, InlineTypes)
+{
+    PropertyValue b(true);
+    EXPECT_EQ(b.type(), P_TYPE::BOOL);
+    EXPECT_TRUE(b.toBool());
+
+    PropertyValue r(2.5);
+    EXPECT_EQ(r.type(), P_TYPE::REAL);
+    EXPECT_DOUBLE_EQ(r.toReal(), 2.5);
+
+    PropertyValue p(PointF(1.0, -3.0));
+    EXPECT_EQ(p.value<PointF>(), PointF(1.0, -3.0));
+
+    PropertyValue f(Fraction(3, 8));
+    EXPECT_EQ(f.value<Fraction>(), Fraction(3, 8));
+
+    PropertyValue c(Color(10, 20, 30));
+    EXPECT_EQ(c.value<Color>(), Color(10, 20, 30));
+}
+
+TEST_F(Engraving_PropertyValueTests, HeapTypes)
+{
+    PropertyValue s(String(u"hello"));
+    EXPECT_EQ(s.type(), P_TYPE::STRING);
+    EXPECT_EQ(s.value<String>(), String(u"hello"));
+
+    std::vector<int> vec = { 1, 2, 3 };
+    PropertyValue v(vec);
+    EXPECT_EQ(v.type(), P_TYPE::INT_VEC);
+    EXPECT_EQ(v.value<std::vector<int> >(), vec);
+}
+
+TEST_F(Engraving_PropertyValueTests, CopyAndMove)
+{
+    PropertyValue s(String(u"shared"));
+    PropertyValue sCopy(s);
+    EXPECT_EQ(sCopy, s);
+    EXPECT_EQ(sCopy.value<String>(), String(u"shared"));
+
+    PropertyValue sMoved(std::move(sCopy));
+    EXPECT_EQ(sMoved.value<String>(), String(u"shared"));
+    EXPECT_FALSE(sCopy.isValid());
+    EXPECT_EQ(sCopy.value<String>(), String());
+
+    PropertyValue i(42);
+    PropertyValue iMoved(std::move(i));
+    EXPECT_EQ(iMoved.toInt(), 42);
+
+    //! NOTE Assignments switching between inline and heap storage
+    PropertyValue a(7);
+    a = s;
+    EXPECT_EQ(a.type(), P_TYPE::STRING);
+    EXPECT_EQ(a.value<String>(), String(u"shared"));
+
+    a = PropertyValue(PointF(2.0, 4.0));
+    EXPECT_EQ(a.type(), P_TYPE::POINT);
+    EXPECT_EQ(a.value<PointF>(), PointF(2.0, 4.0));
+
+    a = PropertyValue(std::vector<int> { 5 });
+    EXPECT_EQ(a.value<std::vector<int> >(), std::vector<int> { 5 });
+
+    const PropertyValue& self = a;
+    a = self;
+    EXPECT_EQ(a.value<std::vector<int> >(), std::vector<int> { 5 });
+
+    //! NOTE The original must not be affected by changes to a copy
+    EXPECT_EQ(s.value<String>(), String(u"shared"));
+}
+
+TEST_F(Engraving_PropertyValueTests, MismatchedReads)
+{
+    PropertyValue p(PointF(1.0, 2.0));
+    EXPECT_EQ(p.value<String>(), String());
+    EXPECT_EQ(p.value<std::vector<int> >(), std::vector<int>());
+
+    PropertyValue s(String(u"text"));
+    EXPECT_EQ(s.value<PointF>(), PointF());
+    EXPECT_EQ(s.value<Fraction>(), Fraction());
+
+    PropertyValue undefined;
+    EXPECT_EQ(undefined.value<String>(), String());
+    EXPECT_EQ(undefined.toInt(), 0);
+}
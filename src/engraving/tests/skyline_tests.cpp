@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "infrastructure/skyline.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   walkMinDistance
+//    walks all segments of both lines, minDistance()
+//    must give exactly the same result
+//---------------------------------------------------------
+
+static double walkMinDistance(const SkylineLine& a, const SkylineLine& b)
+{
+    double dist = -1000000.0;
+    double x1 = 0.0;
+    double x2 = 0.0;
+    auto k = b.begin();
+    for (auto i = a.begin(); i != a.end(); ++i) {
+        while (k != b.end() && (x2 + k->w) < x1) {
+            x2 += k->w;
+            ++k;
+        }
+        if (k == b.end()) {
+            break;
+        }
+        for (;;) {
+            if ((x1 + i->w > x2) && (x1 < x2 + k->w)) {
+                dist = std::max(dist, i->y - k->y);
+            }
+            if (x2 + k->w < x1 + i->w) {
+                x2 += k->w;
+                ++k;
+                if (k == b.end()) {
+                    break;
+                }
+            } else {
+                break;
+            }
+        }
+        if (k == b.end()) {
+            break;
+        }
+        x1 += i->w;
+    }
+    return dist;
+}
+
+TEST_F(Engraving_SkylineTests, minDistance)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> xDist(-10.0, 300.0);
+    std::uniform_real_distribution<double> yDist(-30.0, 30.0);
+    std::uniform_real_distribution<double> wDist(0.0, 40.0);
+    std::uniform_int_distribution<int> countDist(0, 50);
+
+    auto fill = [&](SkylineLine& line, int count) {
+        for (int i = 0; i < count; ++i) {
+            line.add(xDist(rng), yDist(rng), wDist(rng));
+        }
+    };
+
+    for (int n = 0; n < 2000; ++n) {
+        SkylineLine south(false);
+        SkylineLine north(true);
+        fill(south, countDist(rng));
+        fill(north, countDist(rng));
+        EXPECT_EQ(south.minDistance(north), walkMinDistance(south, north));
+
+        // a single element against a staff, as in autoplace
+        SkylineLine above(false);
+        fill(above, 1);
+        EXPECT_EQ(above.minDistance(north), walkMinDistance(above, north));
+        SkylineLine below(true);
+        fill(below, 1);
+        EXPECT_EQ(south.minDistance(below), walkMinDistance(south, below));
+
+        // the cached sums follow later additions
+        fill(north, 3);
+        EXPECT_EQ(above.minDistance(north), walkMinDistance(above, north));
+    }
+}
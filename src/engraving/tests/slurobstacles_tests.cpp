@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "infrastructure/slurobstacles.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_SlurObstaclesTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   collides
+//    the grid must find a collision exactly when the
+//    clearsVertically() check over all shapes does
+//---------------------------------------------------------
+
+static bool collidesWithShapes(const std::vector<Shape>& shapes, const RectF& r, bool up)
+{
+    for (const Shape& shape : shapes) {
+        bool intersection = up ? !Shape(r).clearsVertically(shape) : !shape.clearsVertically(r);
+        if (intersection) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_F(Engraving_SlurObstaclesTests, collides)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> xDist(-20.0, 400.0);
+    std::uniform_real_distribution<double> yDist(-40.0, 40.0);
+    std::uniform_real_distribution<double> wDist(0.0, 30.0);
+    std::uniform_real_distribution<double> cellDist(0.5, 20.0);
+    std::uniform_int_distribution<int> countDist(0, 8);
+
+    for (int n = 0; n < 500; ++n) {
+        std::vector<Shape> shapes(countDist(rng));
+        for (Shape& shape : shapes) {
+            int count = countDist(rng);
+            for (int i = 0; i < count; ++i) {
+                shape.add(RectF(xDist(rng), yDist(rng), wDist(rng), wDist(rng)));
+            }
+        }
+        const SlurObstacles obstacles(shapes, cellDist(rng));
+
+        // the rectangles of a slur are spanned between two points, either way round
+        for (int i = 0; i < 50; ++i) {
+            PointF p1(xDist(rng), yDist(rng));
+            PointF p2(p1.x() + wDist(rng) - 15.0, p1.y() + wDist(rng) - 15.0);
+            RectF r(p1, p2);
+            EXPECT_EQ(obstacles.collides(r, true), collidesWithShapes(shapes, r, true));
+            EXPECT_EQ(obstacles.collides(r, false), collidesWithShapes(shapes, r, false));
+        }
+
+        // rectangles left and right of all the shapes
+        RectF before(-200.0, 0.0, 10.0, 10.0);
+        RectF after(1000.0, 0.0, 10.0, 10.0);
+        EXPECT_EQ(obstacles.collides(before, true), collidesWithShapes(shapes, before, true));
+        EXPECT_EQ(obstacles.collides(after, false), collidesWithShapes(shapes, after, false));
+    }
+}
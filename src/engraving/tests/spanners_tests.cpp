@@ -22,15 +22,20 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <tuple>
+
 #include "dom/chord.h"
 #include "dom/excerpt.h"
 #include "dom/factory.h"
 #include "dom/glissando.h"
+#include "dom/hairpin.h"
 #include "dom/layoutbreak.h"
 #include "dom/line.h"
 #include "dom/masterscore.h"
 #include "dom/measure.h"
 #include "dom/part.h"
+#include "dom/slur.h"
 #include "dom/staff.h"
 #include "dom/system.h"
 #include "dom/undo.h"
@@ -593,3 +598,124 @@ TEST_F(Engraving_SpannersTests, spanners16)
     EXPECT_TRUE(ScoreComp::saveCompareScore(score, u"smallstaff01.mscx", SPANNERS_DATA_DIR + u"smallstaff01-ref.mscx"));
     delete score;
 }
+
+//---------------------------------------------------------
+///  spannerMapIncremental
+///   the lookup trees of the spanner map are maintained on
+///   add, remove, tick and track changes; compare them against
+///   intervals computed from scratch
+//---------------------------------------------------------
+
+static void sortIntervals(SpannerMap::IntervalList& intervals)
+{
+    std::sort(intervals.begin(), intervals.end(), [](const auto& a, const auto& b) {
+        return std::make_tuple(a.start, a.stop, a.value) < std::make_tuple(b.start, b.stop, b.value);
+    });
+}
+
+static void checkSpannerMap(const SpannerMap& spannerMap, int lastTick)
+{
+    SpannerMap fresh;
+    for (const auto& pair : spannerMap.map()) {
+        fresh.addSpanner(pair.second);
+    }
+
+    SpannerMap::IntervalList regular;
+    SpannerMap::IntervalList collisionFree;
+    fresh.collectIntervals(regular, collisionFree);
+
+    const int step = Constants::DIVISION / 2;
+    SpannerMap::IntervalList found;
+
+    for (bool excludeCollisions : { false, true }) {
+        const SpannerMap::IntervalList& all = excludeCollisions ? collisionFree : regular;
+
+        for (int start = -step; start <= lastTick + step; start += step) {
+            const int stop = start + step;
+
+            SpannerMap::IntervalList expected;
+            for (const auto& interval : all) {
+                if (interval.stop >= start && interval.start <= stop) {
+                    expected.push_back(interval);
+                }
+            }
+
+            spannerMap.findOverlapping(start, stop, found, excludeCollisions);
+            EXPECT_TRUE(std::is_sorted(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.start < b.start; }));
+
+            sortIntervals(expected);
+            sortIntervals(found);
+            ASSERT_EQ(found.size(), expected.size());
+            for (size_t i = 0; i < found.size(); ++i) {
+                EXPECT_EQ(found[i].start, expected[i].start);
+                EXPECT_EQ(found[i].stop, expected[i].stop);
+                EXPECT_EQ(found[i].value, expected[i].value);
+            }
+        }
+    }
+
+    SpannerMap::IntervalList contained = spannerMap.findContained(0, lastTick);
+    size_t expectedContained = std::count_if(regular.begin(), regular.end(), [lastTick](const auto& interval) {
+        return interval.start >= 0 && interval.stop <= lastTick;
+    });
+    EXPECT_EQ(contained.size(), expectedContained);
+}
+
+TEST_F(Engraving_SpannersTests, spannerMapIncremental)
+{
+    MasterScore* score = ScoreRW::readScore(SPANNERS_DATA_DIR + u"glissando-cloning04.mscx");
+    EXPECT_TRUE(score);
+    ASSERT_TRUE(score->parts().size() > 1);
+
+    const int quarter = Constants::DIVISION;
+    const track_idx_t otherPartTrack = score->parts().back()->startTrack();
+    SpannerMap& spannerMap = score->spannerMap();
+
+    // overlapping hairpins of the same part collide, a slur in between doesn't
+    std::vector<Spanner*> spanners;
+    for (int i = 0; i < 8; ++i) {
+        Hairpin* hairpin = Factory::createHairpin(score->dummy()->segment());
+        hairpin->setTrack(0);
+        hairpin->setTick(Fraction::fromTicks(i * 3 * quarter));
+        hairpin->setTick2(Fraction::fromTicks(i * 3 * quarter + 4 * quarter));
+        score->addSpanner(hairpin);
+        spanners.push_back(hairpin);
+    }
+    Slur* slur = Factory::createSlur(score->dummy());
+    slur->setTrack(0);
+    slur->setTick(Fraction::fromTicks(quarter + 1));
+    slur->setTick2(Fraction::fromTicks(8 * quarter));
+    score->addSpanner(slur);
+    spanners.push_back(slur);
+
+    const int lastTick = 32 * quarter;
+    checkSpannerMap(spannerMap, lastTick);
+
+    // change start and length
+    spanners[2]->setTick(Fraction::fromTicks(10 * quarter + 2));
+    spanners[2]->setTick2(Fraction::fromTicks(13 * quarter));
+    checkSpannerMap(spannerMap, lastTick);
+
+    spanners[5]->setTicks(Fraction::fromTicks(quarter));
+    checkSpannerMap(spannerMap, lastTick);
+
+    // move to another part
+    spanners[4]->setTrack(otherPartTrack);
+    checkSpannerMap(spannerMap, lastTick);
+
+    // remove
+    EXPECT_TRUE(spannerMap.removeSpanner(spanners[3]));
+    EXPECT_FALSE(spannerMap.removeSpanner(spanners[3]));
+    checkSpannerMap(spannerMap, lastTick);
+
+    score->removeSpanner(spanners[0]);
+    checkSpannerMap(spannerMap, lastTick);
+
+    // full rebuild gives the same result
+    spannerMap.update();
+    checkSpannerMap(spannerMap, lastTick);
+
+    delete spanners[0];
+    delete spanners[3];
+    delete score;
+}
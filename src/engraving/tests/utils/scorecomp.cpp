@@ -22,6 +22,9 @@
 
 #include "scorecomp.h"
 
+#include <iomanip>
+#include <sstream>
+
 #include <QProcess>
 #include <QTextStream>
 
@@ -76,3 +79,21 @@ bool ScoreComp::compareFiles(const String& fullPath1, const String& fullPath2)
 
     return true;
 }
+
+static void writeLayoutData(void* data, EngravingItem* item)
+{
+    std::stringstream& stream = *static_cast<std::stringstream*>(data);
+    const PointF pos = item->pagePos();
+    const RectF& bbox = item->ldata()->bbox(LD_ACCESS::MAYBE_NOTINITED);
+    stream << item->typeName() << ' ' << pos.x() << ' ' << pos.y() << ' '
+           << bbox.x() << ' ' << bbox.y() << ' ' << bbox.width() << ' ' << bbox.height() << '\n';
+}
+
+String ScoreComp::layoutData(Score* score)
+{
+    std::stringstream stream;
+    stream << std::setprecision(17);
+    score->scanElements(&stream, writeLayoutData, true);
+    return String::fromStdString(stream.str());
+}
+
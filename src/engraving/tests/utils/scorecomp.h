@@ -33,6 +33,9 @@ public:
     static bool saveCompareScore(Score*, const String& saveName, const String& compareWithLocalPath);
     static bool saveCompareMimeData(mu::ByteArray mimeData, const String& saveName, const String& compareWithLocalPath);
     static bool compareFiles(const String& fullPath1, const String& fullPath2);
+
+    //! NOTE Type, page position and bounding box of every item, in scan order; to compare layouts
+    static String layoutData(Score* score);
 };
 }
 
@@ -21,12 +21,86 @@
  */
 #include "propertyvalue.h"
 
+#include <cstring>
+
 #include "realfn.h"
 
 #include "log.h"
 
 using namespace mu::engraving;
 
+PropertyValue::PropertyValue(const PropertyValue& other)
+{
+    copyFrom(other);
+}
+
+PropertyValue::PropertyValue(PropertyValue&& other) noexcept
+{
+    moveFrom(other);
+}
+
+PropertyValue::~PropertyValue()
+{
+    reset();
+}
+
+PropertyValue& PropertyValue::operator=(const PropertyValue& other)
+{
+    if (this != &other) {
+        reset();
+        copyFrom(other);
+    }
+    return *this;
+}
+
+PropertyValue& PropertyValue::operator=(PropertyValue&& other) noexcept
+{
+    if (this != &other) {
+        reset();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+void PropertyValue::copyFrom(const PropertyValue& other)
+{
+    m_type = other.m_type;
+    m_isShared = other.m_isShared;
+    if (m_isShared) {
+        new (&m_storage.shared) std::shared_ptr<void>(other.m_storage.shared);
+    } else {
+        std::memcpy(m_storage.inlined, other.m_storage.inlined, INLINE_SIZE);
+    }
+}
+
+void PropertyValue::moveFrom(PropertyValue& other)
+{
+    m_type = other.m_type;
+    m_isShared = other.m_isShared;
+    if (m_isShared) {
+        new (&m_storage.shared) std::shared_ptr<void>(std::move(other.m_storage.shared));
+    } else {
+        std::memcpy(m_storage.inlined, other.m_storage.inlined, INLINE_SIZE);
+    }
+    other.reset();
+}
+
+void PropertyValue::reset()
+{
+    if (m_isShared) {
+        m_storage.shared.~shared_ptr();
+        m_isShared = false;
+    }
+    std::memset(m_storage.inlined, 0, INLINE_SIZE);
+    m_type = P_TYPE::UNDEFINED;
+}
+
+void PropertyValue::logTypeMismatch(P_TYPE requested) const
+{
+    LOGE() << "requested type does not match the stored type, stored: " << static_cast<int>(m_type)
+           << ", requested: " << static_cast<int>(requested);
+}
+
 bool PropertyValue::isValid() const
 {
     return m_type != P_TYPE::UNDEFINED;
@@ -69,17 +143,153 @@ bool PropertyValue::operator ==(const PropertyValue& v) const
         return RealIsEqual(v.value<double>(), value<double>());
     }
 
-    assert(m_data);
-    if (!m_data) {
+    if (v.m_type != m_type) {
         return false;
     }
 
-    assert(v.m_data);
-    if (!v.m_data) {
-        return false;
+    switch (m_type) {
+    case P_TYPE::UNDEFINED: return true;
+    case P_TYPE::BOOL: return get<bool>() == v.get<bool>();
+    case P_TYPE::INT: return get<int>() == v.get<int>();
+    case P_TYPE::INT_VEC: return get<std::vector<int> >() == v.get<std::vector<int> >();
+    case P_TYPE::SIZE_T: return get<size_t>() == v.get<size_t>();
+    case P_TYPE::REAL: return get<double>() == v.get<double>();
+    case P_TYPE::STRING: return get<String>() == v.get<String>();
+    case P_TYPE::POINT: return get<PointF>() == v.get<PointF>();
+    case P_TYPE::SIZE: return get<SizeF>() == v.get<SizeF>();
+    case P_TYPE::DRAW_PATH: return get<PainterPath>() == v.get<PainterPath>();
+    case P_TYPE::SCALE: return get<ScaleF>() == v.get<ScaleF>();
+    case P_TYPE::SPATIUM: return get<Spatium>() == v.get<Spatium>();
+    case P_TYPE::MILLIMETRE: return get<Millimetre>() == v.get<Millimetre>();
+    case P_TYPE::PAIR_REAL: return get<PairF>() == v.get<PairF>();
+    case P_TYPE::SYMID: return get<SymId>() == v.get<SymId>();
+    case P_TYPE::COLOR: return get<Color>() == v.get<Color>();
+    case P_TYPE::ORNAMENT_STYLE: return get<OrnamentStyle>() == v.get<OrnamentStyle>();
+    case P_TYPE::ORNAMENT_INTERVAL: return get<OrnamentInterval>() == v.get<OrnamentInterval>();
+    case P_TYPE::ORNAMENT_SHOW_ACCIDENTAL: return get<OrnamentShowAccidental>() == v.get<OrnamentShowAccidental>();
+    case P_TYPE::GLISS_STYLE: return get<GlissandoStyle>() == v.get<GlissandoStyle>();
+    case P_TYPE::ALIGN: return get<Align>() == v.get<Align>();
+    case P_TYPE::PLACEMENT_V: return get<PlacementV>() == v.get<PlacementV>();
+    case P_TYPE::PLACEMENT_H: return get<PlacementH>() == v.get<PlacementH>();
+    case P_TYPE::TEXT_PLACE: return get<TextPlace>() == v.get<TextPlace>();
+    case P_TYPE::DIRECTION_V: return get<DirectionV>() == v.get<DirectionV>();
+    case P_TYPE::DIRECTION_H: return get<DirectionH>() == v.get<DirectionH>();
+    case P_TYPE::ORIENTATION: return get<Orientation>() == v.get<Orientation>();
+    case P_TYPE::BEAM_MODE: return get<BeamMode>() == v.get<BeamMode>();
+    case P_TYPE::ACCIDENTAL_ROLE: return get<AccidentalRole>() == v.get<AccidentalRole>();
+    case P_TYPE::TIE_PLACEMENT: return get<TiePlacement>() == v.get<TiePlacement>();
+    case P_TYPE::FRACTION: return get<Fraction>() == v.get<Fraction>();
+    case P_TYPE::DURATION_TYPE_WITH_DOTS: return get<DurationTypeWithDots>() == v.get<DurationTypeWithDots>();
+    case P_TYPE::CHANGE_METHOD: return get<ChangeMethod>() == v.get<ChangeMethod>();
+    case P_TYPE::PITCH_VALUES: return get<PitchValues>() == v.get<PitchValues>();
+    case P_TYPE::TEMPO: return get<BeatsPerSecond>() == v.get<BeatsPerSecond>();
+    case P_TYPE::LAYOUTBREAK_TYPE: return get<LayoutBreakType>() == v.get<LayoutBreakType>();
+    case P_TYPE::VELO_TYPE: return get<VeloType>() == v.get<VeloType>();
+    case P_TYPE::BARLINE_TYPE: return get<BarLineType>() == v.get<BarLineType>();
+    case P_TYPE::NOTEHEAD_TYPE: return get<NoteHeadType>() == v.get<NoteHeadType>();
+    case P_TYPE::NOTEHEAD_SCHEME: return get<NoteHeadScheme>() == v.get<NoteHeadScheme>();
+    case P_TYPE::NOTEHEAD_GROUP: return get<NoteHeadGroup>() == v.get<NoteHeadGroup>();
+    case P_TYPE::CLEF_TYPE: return get<ClefType>() == v.get<ClefType>();
+    case P_TYPE::CLEF_TO_BARLINE_POS: return get<ClefToBarlinePosition>() == v.get<ClefToBarlinePosition>();
+    case P_TYPE::DYNAMIC_TYPE: return get<DynamicType>() == v.get<DynamicType>();
+    case P_TYPE::DYNAMIC_RANGE: return get<DynamicRange>() == v.get<DynamicRange>();
+    case P_TYPE::DYNAMIC_SPEED: return get<DynamicSpeed>() == v.get<DynamicSpeed>();
+    case P_TYPE::LINE_TYPE: return get<LineType>() == v.get<LineType>();
+    case P_TYPE::HOOK_TYPE: return get<HookType>() == v.get<HookType>();
+    case P_TYPE::KEY_MODE: return get<KeyMode>() == v.get<KeyMode>();
+    case P_TYPE::TEXT_STYLE: return get<TextStyleType>() == v.get<TextStyleType>();
+    case P_TYPE::PLAYTECH_TYPE: return get<PlayingTechniqueType>() == v.get<PlayingTechniqueType>();
+    case P_TYPE::TEMPOCHANGE_TYPE: return get<GradualTempoChangeType>() == v.get<GradualTempoChangeType>();
+    case P_TYPE::SLUR_STYLE_TYPE: return get<SlurStyleType>() == v.get<SlurStyleType>();
+    case P_TYPE::GROUPS: return get<GroupNodes>() == v.get<GroupNodes>();
+    }
+
+    return false;
+}
+
+bool PropertyValue::isEnum() const
+{
+    switch (m_type) {
+    case P_TYPE::SYMID:
+    case P_TYPE::ORNAMENT_STYLE:
+    case P_TYPE::ORNAMENT_SHOW_ACCIDENTAL:
+    case P_TYPE::GLISS_STYLE:
+    case P_TYPE::PLACEMENT_V:
+    case P_TYPE::PLACEMENT_H:
+    case P_TYPE::TEXT_PLACE:
+    case P_TYPE::DIRECTION_V:
+    case P_TYPE::DIRECTION_H:
+    case P_TYPE::ORIENTATION:
+    case P_TYPE::BEAM_MODE:
+    case P_TYPE::ACCIDENTAL_ROLE:
+    case P_TYPE::TIE_PLACEMENT:
+    case P_TYPE::CHANGE_METHOD:
+    case P_TYPE::LAYOUTBREAK_TYPE:
+    case P_TYPE::VELO_TYPE:
+    case P_TYPE::BARLINE_TYPE:
+    case P_TYPE::NOTEHEAD_TYPE:
+    case P_TYPE::NOTEHEAD_SCHEME:
+    case P_TYPE::NOTEHEAD_GROUP:
+    case P_TYPE::CLEF_TYPE:
+    case P_TYPE::CLEF_TO_BARLINE_POS:
+    case P_TYPE::DYNAMIC_TYPE:
+    case P_TYPE::DYNAMIC_RANGE:
+    case P_TYPE::DYNAMIC_SPEED:
+    case P_TYPE::LINE_TYPE:
+    case P_TYPE::HOOK_TYPE:
+    case P_TYPE::KEY_MODE:
+    case P_TYPE::TEXT_STYLE:
+    case P_TYPE::PLAYTECH_TYPE:
+    case P_TYPE::TEMPOCHANGE_TYPE:
+    case P_TYPE::SLUR_STYLE_TYPE:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+int PropertyValue::enumToInt() const
+{
+    switch (m_type) {
+    case P_TYPE::SYMID: return static_cast<int>(get<SymId>());
+    case P_TYPE::ORNAMENT_STYLE: return static_cast<int>(get<OrnamentStyle>());
+    case P_TYPE::ORNAMENT_SHOW_ACCIDENTAL: return static_cast<int>(get<OrnamentShowAccidental>());
+    case P_TYPE::GLISS_STYLE: return static_cast<int>(get<GlissandoStyle>());
+    case P_TYPE::PLACEMENT_V: return static_cast<int>(get<PlacementV>());
+    case P_TYPE::PLACEMENT_H: return static_cast<int>(get<PlacementH>());
+    case P_TYPE::TEXT_PLACE: return static_cast<int>(get<TextPlace>());
+    case P_TYPE::DIRECTION_V: return static_cast<int>(get<DirectionV>());
+    case P_TYPE::DIRECTION_H: return static_cast<int>(get<DirectionH>());
+    case P_TYPE::ORIENTATION: return static_cast<int>(get<Orientation>());
+    case P_TYPE::BEAM_MODE: return static_cast<int>(get<BeamMode>());
+    case P_TYPE::ACCIDENTAL_ROLE: return static_cast<int>(get<AccidentalRole>());
+    case P_TYPE::TIE_PLACEMENT: return static_cast<int>(get<TiePlacement>());
+    case P_TYPE::CHANGE_METHOD: return static_cast<int>(get<ChangeMethod>());
+    case P_TYPE::LAYOUTBREAK_TYPE: return static_cast<int>(get<LayoutBreakType>());
+    case P_TYPE::VELO_TYPE: return static_cast<int>(get<VeloType>());
+    case P_TYPE::BARLINE_TYPE: return static_cast<int>(get<BarLineType>());
+    case P_TYPE::NOTEHEAD_TYPE: return static_cast<int>(get<NoteHeadType>());
+    case P_TYPE::NOTEHEAD_SCHEME: return static_cast<int>(get<NoteHeadScheme>());
+    case P_TYPE::NOTEHEAD_GROUP: return static_cast<int>(get<NoteHeadGroup>());
+    case P_TYPE::CLEF_TYPE: return static_cast<int>(get<ClefType>());
+    case P_TYPE::CLEF_TO_BARLINE_POS: return static_cast<int>(get<ClefToBarlinePosition>());
+    case P_TYPE::DYNAMIC_TYPE: return static_cast<int>(get<DynamicType>());
+    case P_TYPE::DYNAMIC_RANGE: return static_cast<int>(get<DynamicRange>());
+    case P_TYPE::DYNAMIC_SPEED: return static_cast<int>(get<DynamicSpeed>());
+    case P_TYPE::LINE_TYPE: return static_cast<int>(get<LineType>());
+    case P_TYPE::HOOK_TYPE: return static_cast<int>(get<HookType>());
+    case P_TYPE::KEY_MODE: return static_cast<int>(get<KeyMode>());
+    case P_TYPE::TEXT_STYLE: return static_cast<int>(get<TextStyleType>());
+    case P_TYPE::PLAYTECH_TYPE: return static_cast<int>(get<PlayingTechniqueType>());
+    case P_TYPE::TEMPOCHANGE_TYPE: return static_cast<int>(get<GradualTempoChangeType>());
+    case P_TYPE::SLUR_STYLE_TYPE: return static_cast<int>(get<SlurStyleType>());
+    default:
+        break;
     }
 
-    return v.m_type == m_type && v.m_data->equal(m_data.get());
+    return -1;
 }
 
 #ifndef NO_QT_SUPPORT
@@ -22,10 +22,12 @@
 #ifndef MU_ENGRAVING_PROPERTYVALUE_H
 #define MU_ENGRAVING_PROPERTYVALUE_H
 
-#include <any>
-#include <string>
-#include <memory>
 #include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
 
 #include "types/string.h"
 #include "types/types.h"
@@ -111,178 +113,242 @@ enum class P_TYPE {
     GROUPS,
 };
 
+//! NOTE Maps a stored C++ type to its P_TYPE, so that typed access is a tag check
+template<typename T> struct PropertyValueTypeOf {
+    static constexpr P_TYPE value = P_TYPE::UNDEFINED;
+};
+template<> struct PropertyValueTypeOf<bool> { static constexpr P_TYPE value = P_TYPE::BOOL; };
+template<> struct PropertyValueTypeOf<int> { static constexpr P_TYPE value = P_TYPE::INT; };
+template<> struct PropertyValueTypeOf<std::vector<int> > { static constexpr P_TYPE value = P_TYPE::INT_VEC; };
+template<> struct PropertyValueTypeOf<size_t> { static constexpr P_TYPE value = P_TYPE::SIZE_T; };
+template<> struct PropertyValueTypeOf<double> { static constexpr P_TYPE value = P_TYPE::REAL; };
+template<> struct PropertyValueTypeOf<String> { static constexpr P_TYPE value = P_TYPE::STRING; };
+template<> struct PropertyValueTypeOf<PointF> { static constexpr P_TYPE value = P_TYPE::POINT; };
+template<> struct PropertyValueTypeOf<PairF> { static constexpr P_TYPE value = P_TYPE::PAIR_REAL; };
+template<> struct PropertyValueTypeOf<SizeF> { static constexpr P_TYPE value = P_TYPE::SIZE; };
+template<> struct PropertyValueTypeOf<PainterPath> { static constexpr P_TYPE value = P_TYPE::DRAW_PATH; };
+template<> struct PropertyValueTypeOf<ScaleF> { static constexpr P_TYPE value = P_TYPE::SCALE; };
+template<> struct PropertyValueTypeOf<Spatium> { static constexpr P_TYPE value = P_TYPE::SPATIUM; };
+template<> struct PropertyValueTypeOf<Millimetre> { static constexpr P_TYPE value = P_TYPE::MILLIMETRE; };
+template<> struct PropertyValueTypeOf<SymId> { static constexpr P_TYPE value = P_TYPE::SYMID; };
+template<> struct PropertyValueTypeOf<Color> { static constexpr P_TYPE value = P_TYPE::COLOR; };
+template<> struct PropertyValueTypeOf<OrnamentStyle> { static constexpr P_TYPE value = P_TYPE::ORNAMENT_STYLE; };
+template<> struct PropertyValueTypeOf<GlissandoStyle> { static constexpr P_TYPE value = P_TYPE::GLISS_STYLE; };
+template<> struct PropertyValueTypeOf<Align> { static constexpr P_TYPE value = P_TYPE::ALIGN; };
+template<> struct PropertyValueTypeOf<PlacementV> { static constexpr P_TYPE value = P_TYPE::PLACEMENT_V; };
+template<> struct PropertyValueTypeOf<PlacementH> { static constexpr P_TYPE value = P_TYPE::PLACEMENT_H; };
+template<> struct PropertyValueTypeOf<TextPlace> { static constexpr P_TYPE value = P_TYPE::TEXT_PLACE; };
+template<> struct PropertyValueTypeOf<DirectionV> { static constexpr P_TYPE value = P_TYPE::DIRECTION_V; };
+template<> struct PropertyValueTypeOf<DirectionH> { static constexpr P_TYPE value = P_TYPE::DIRECTION_H; };
+template<> struct PropertyValueTypeOf<Orientation> { static constexpr P_TYPE value = P_TYPE::ORIENTATION; };
+template<> struct PropertyValueTypeOf<BeamMode> { static constexpr P_TYPE value = P_TYPE::BEAM_MODE; };
+template<> struct PropertyValueTypeOf<AccidentalRole> { static constexpr P_TYPE value = P_TYPE::ACCIDENTAL_ROLE; };
+template<> struct PropertyValueTypeOf<TiePlacement> { static constexpr P_TYPE value = P_TYPE::TIE_PLACEMENT; };
+template<> struct PropertyValueTypeOf<Fraction> { static constexpr P_TYPE value = P_TYPE::FRACTION; };
+template<> struct PropertyValueTypeOf<DurationTypeWithDots> { static constexpr P_TYPE value = P_TYPE::DURATION_TYPE_WITH_DOTS; };
+template<> struct PropertyValueTypeOf<ChangeMethod> { static constexpr P_TYPE value = P_TYPE::CHANGE_METHOD; };
+template<> struct PropertyValueTypeOf<PitchValues> { static constexpr P_TYPE value = P_TYPE::PITCH_VALUES; };
+template<> struct PropertyValueTypeOf<BeatsPerSecond> { static constexpr P_TYPE value = P_TYPE::TEMPO; };
+template<> struct PropertyValueTypeOf<LayoutBreakType> { static constexpr P_TYPE value = P_TYPE::LAYOUTBREAK_TYPE; };
+template<> struct PropertyValueTypeOf<VeloType> { static constexpr P_TYPE value = P_TYPE::VELO_TYPE; };
+template<> struct PropertyValueTypeOf<BarLineType> { static constexpr P_TYPE value = P_TYPE::BARLINE_TYPE; };
+template<> struct PropertyValueTypeOf<NoteHeadType> { static constexpr P_TYPE value = P_TYPE::NOTEHEAD_TYPE; };
+template<> struct PropertyValueTypeOf<NoteHeadScheme> { static constexpr P_TYPE value = P_TYPE::NOTEHEAD_SCHEME; };
+template<> struct PropertyValueTypeOf<NoteHeadGroup> { static constexpr P_TYPE value = P_TYPE::NOTEHEAD_GROUP; };
+template<> struct PropertyValueTypeOf<ClefType> { static constexpr P_TYPE value = P_TYPE::CLEF_TYPE; };
+template<> struct PropertyValueTypeOf<ClefToBarlinePosition> { static constexpr P_TYPE value = P_TYPE::CLEF_TO_BARLINE_POS; };
+template<> struct PropertyValueTypeOf<DynamicType> { static constexpr P_TYPE value = P_TYPE::DYNAMIC_TYPE; };
+template<> struct PropertyValueTypeOf<DynamicRange> { static constexpr P_TYPE value = P_TYPE::DYNAMIC_RANGE; };
+template<> struct PropertyValueTypeOf<DynamicSpeed> { static constexpr P_TYPE value = P_TYPE::DYNAMIC_SPEED; };
+template<> struct PropertyValueTypeOf<LineType> { static constexpr P_TYPE value = P_TYPE::LINE_TYPE; };
+template<> struct PropertyValueTypeOf<HookType> { static constexpr P_TYPE value = P_TYPE::HOOK_TYPE; };
+template<> struct PropertyValueTypeOf<KeyMode> { static constexpr P_TYPE value = P_TYPE::KEY_MODE; };
+template<> struct PropertyValueTypeOf<TextStyleType> { static constexpr P_TYPE value = P_TYPE::TEXT_STYLE; };
+template<> struct PropertyValueTypeOf<PlayingTechniqueType> { static constexpr P_TYPE value = P_TYPE::PLAYTECH_TYPE; };
+template<> struct PropertyValueTypeOf<GradualTempoChangeType> { static constexpr P_TYPE value = P_TYPE::TEMPOCHANGE_TYPE; };
+template<> struct PropertyValueTypeOf<SlurStyleType> { static constexpr P_TYPE value = P_TYPE::SLUR_STYLE_TYPE; };
+template<> struct PropertyValueTypeOf<GroupNodes> { static constexpr P_TYPE value = P_TYPE::GROUPS; };
+template<> struct PropertyValueTypeOf<OrnamentInterval> { static constexpr P_TYPE value = P_TYPE::ORNAMENT_INTERVAL; };
+template<> struct PropertyValueTypeOf<OrnamentShowAccidental> { static constexpr P_TYPE value = P_TYPE::ORNAMENT_SHOW_ACCIDENTAL; };
+
 class PropertyValue
 {
 public:
     PropertyValue() = default;
+    PropertyValue(const PropertyValue& other);
+    PropertyValue(PropertyValue&& other) noexcept;
+    ~PropertyValue();
+
+    PropertyValue& operator=(const PropertyValue& other);
+    PropertyValue& operator=(PropertyValue&& other) noexcept;
 
     // Base
     PropertyValue(bool v)
-        : m_type(P_TYPE::BOOL), m_data(make_data<bool>(v)) {}
+        : m_type(P_TYPE::BOOL) { store<bool>(v); }
 
     PropertyValue(int v)
-        : m_type(P_TYPE::INT), m_data(make_data<int>(v)) {}
+        : m_type(P_TYPE::INT) { store<int>(v); }
 
     PropertyValue(const std::vector<int>& v)
-        : m_type(P_TYPE::INT_VEC), m_data(make_data<std::vector<int> >(v)) {}
+        : m_type(P_TYPE::INT_VEC) { store<std::vector<int> >(v); }
 
     PropertyValue(size_t v)
-        : m_type(P_TYPE::SIZE_T), m_data(make_data<size_t>(v)) {}
+        : m_type(P_TYPE::SIZE_T) { store<size_t>(v); }
 
     PropertyValue(double v)
-        : m_type(P_TYPE::REAL), m_data(make_data<double>(v)) {}
+        : m_type(P_TYPE::REAL) { store<double>(v); }
 
     PropertyValue(const char* v)
-        : m_type(P_TYPE::STRING), m_data(make_data<String>(String::fromUtf8(v))) {}
+        : m_type(P_TYPE::STRING) { store<String>(String::fromUtf8(v)); }
 
     PropertyValue(const String& v)
-        : m_type(P_TYPE::STRING), m_data(make_data<String>(v)) {}
+        : m_type(P_TYPE::STRING) { store<String>(v); }
 
 #ifndef NO_QT_SUPPORT
     PropertyValue(const QString& v)
-        : m_type(P_TYPE::STRING), m_data(make_data<String>(String::fromQString(v))) {}
+        : m_type(P_TYPE::STRING) { store<String>(String::fromQString(v)); }
 #endif
 
     // Geometry
     PropertyValue(const PointF& v)
-        : m_type(P_TYPE::POINT), m_data(make_data<PointF>(v)) {}
+        : m_type(P_TYPE::POINT) { store<PointF>(v); }
 
     PropertyValue(const PairF& v)
-        : m_type(P_TYPE::PAIR_REAL), m_data(make_data<PairF>(v)) {}
+        : m_type(P_TYPE::PAIR_REAL) { store<PairF>(v); }
 
     PropertyValue(const SizeF& v)
-        : m_type(P_TYPE::SIZE), m_data(make_data<SizeF>(v)) {}
+        : m_type(P_TYPE::SIZE) { store<SizeF>(v); }
 
     PropertyValue(const PainterPath& v)
-        : m_type(P_TYPE::DRAW_PATH), m_data(make_data<PainterPath>(v)) {}
+        : m_type(P_TYPE::DRAW_PATH) { store<PainterPath>(v); }
 
     PropertyValue(const ScaleF& v)
-        : m_type(P_TYPE::SCALE), m_data(make_data<ScaleF>(v)) {}
+        : m_type(P_TYPE::SCALE) { store<ScaleF>(v); }
 
     PropertyValue(const Spatium& v)
-        : m_type(P_TYPE::SPATIUM), m_data(make_data<Spatium>(v)) {}
+        : m_type(P_TYPE::SPATIUM) { store<Spatium>(v); }
 
     PropertyValue(const Millimetre& v)
-        : m_type(P_TYPE::MILLIMETRE), m_data(make_data<Millimetre>(v)) {}
+        : m_type(P_TYPE::MILLIMETRE) { store<Millimetre>(v); }
 
     // Draw
     PropertyValue(SymId v)
-        : m_type(P_TYPE::SYMID), m_data(make_data<SymId>(v)) {}
+        : m_type(P_TYPE::SYMID) { store<SymId>(v); }
 
     PropertyValue(const Color& v)
-        : m_type(P_TYPE::COLOR), m_data(make_data<Color>(v)) {}
+        : m_type(P_TYPE::COLOR) { store<Color>(v); }
 
     PropertyValue(OrnamentStyle v)
-        : m_type(P_TYPE::ORNAMENT_STYLE), m_data(make_data<OrnamentStyle>(v)) {}
+        : m_type(P_TYPE::ORNAMENT_STYLE) { store<OrnamentStyle>(v); }
 
     PropertyValue(GlissandoStyle v)
-        : m_type(P_TYPE::GLISS_STYLE), m_data(make_data<GlissandoStyle>(v)) {}
+        : m_type(P_TYPE::GLISS_STYLE) { store<GlissandoStyle>(v); }
 
     // Layout
     PropertyValue(Align v)
-        : m_type(P_TYPE::ALIGN), m_data(make_data<Align>(v)) {}
+        : m_type(P_TYPE::ALIGN) { store<Align>(v); }
 
     PropertyValue(PlacementV v)
-        : m_type(P_TYPE::PLACEMENT_V), m_data(make_data<PlacementV>(v)) {}
+        : m_type(P_TYPE::PLACEMENT_V) { store<PlacementV>(v); }
     PropertyValue(PlacementH v)
-        : m_type(P_TYPE::PLACEMENT_H), m_data(make_data<PlacementH>(v)) {}
+        : m_type(P_TYPE::PLACEMENT_H) { store<PlacementH>(v); }
 
     PropertyValue(TextPlace v)
-        : m_type(P_TYPE::TEXT_PLACE), m_data(make_data<TextPlace>(v)) {}
+        : m_type(P_TYPE::TEXT_PLACE) { store<TextPlace>(v); }
 
     PropertyValue(DirectionV v)
-        : m_type(P_TYPE::DIRECTION_V), m_data(make_data<DirectionV>(v)) {}
+        : m_type(P_TYPE::DIRECTION_V) { store<DirectionV>(v); }
     PropertyValue(DirectionH v)
-        : m_type(P_TYPE::DIRECTION_H), m_data(make_data<DirectionH>(v)) {}
+        : m_type(P_TYPE::DIRECTION_H) { store<DirectionH>(v); }
 
     PropertyValue(Orientation v)
-        : m_type(P_TYPE::ORIENTATION), m_data(make_data<Orientation>(v)) {}
+        : m_type(P_TYPE::ORIENTATION) { store<Orientation>(v); }
 
     PropertyValue(BeamMode v)
-        : m_type(P_TYPE::BEAM_MODE), m_data(make_data<BeamMode>(v)) {}
+        : m_type(P_TYPE::BEAM_MODE) { store<BeamMode>(v); }
 
     PropertyValue(const AccidentalRole& v)
-        : m_type(P_TYPE::ACCIDENTAL_ROLE), m_data(make_data<AccidentalRole>(v)) {}
+        : m_type(P_TYPE::ACCIDENTAL_ROLE) { store<AccidentalRole>(v); }
 
     PropertyValue(TiePlacement v)
-        : m_type(P_TYPE::TIE_PLACEMENT), m_data(make_data<TiePlacement>(v)) {}
+        : m_type(P_TYPE::TIE_PLACEMENT) { store<TiePlacement>(v); }
 
     // Sound
     PropertyValue(const Fraction& v)
-        : m_type(P_TYPE::FRACTION), m_data(make_data<Fraction>(v)) {}
+        : m_type(P_TYPE::FRACTION) { store<Fraction>(v); }
     PropertyValue(const DurationTypeWithDots& v)
-        : m_type(P_TYPE::DURATION_TYPE_WITH_DOTS), m_data(make_data<DurationTypeWithDots>(v)) {}
+        : m_type(P_TYPE::DURATION_TYPE_WITH_DOTS) { store<DurationTypeWithDots>(v); }
     PropertyValue(ChangeMethod v)
-        : m_type(P_TYPE::CHANGE_METHOD), m_data(make_data<ChangeMethod>(v)) {}
+        : m_type(P_TYPE::CHANGE_METHOD) { store<ChangeMethod>(v); }
     PropertyValue(const PitchValues& v)
-        : m_type(P_TYPE::PITCH_VALUES), m_data(make_data<PitchValues>(v)) {}
+        : m_type(P_TYPE::PITCH_VALUES) { store<PitchValues>(v); }
     PropertyValue(const BeatsPerSecond& v)
-        : m_type(P_TYPE::TEMPO), m_data(make_data<BeatsPerSecond>(v)) {}
+        : m_type(P_TYPE::TEMPO) { store<BeatsPerSecond>(v); }
 
     // Types
     PropertyValue(LayoutBreakType v)
-        : m_type(P_TYPE::LAYOUTBREAK_TYPE), m_data(make_data<LayoutBreakType>(v)) {}
+        : m_type(P_TYPE::LAYOUTBREAK_TYPE) { store<LayoutBreakType>(v); }
 
     PropertyValue(VeloType v)
-        : m_type(P_TYPE::VELO_TYPE), m_data(make_data<VeloType>(v)) {}
+        : m_type(P_TYPE::VELO_TYPE) { store<VeloType>(v); }
 
     PropertyValue(BarLineType v)
-        : m_type(P_TYPE::BARLINE_TYPE), m_data(make_data<BarLineType>(v)) {}
+        : m_type(P_TYPE::BARLINE_TYPE) { store<BarLineType>(v); }
 
     PropertyValue(NoteHeadType v)
-        : m_type(P_TYPE::NOTEHEAD_TYPE), m_data(make_data<NoteHeadType>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_TYPE) { store<NoteHeadType>(v); }
     PropertyValue(NoteHeadScheme v)
-        : m_type(P_TYPE::NOTEHEAD_SCHEME), m_data(make_data<NoteHeadScheme>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_SCHEME) { store<NoteHeadScheme>(v); }
     PropertyValue(NoteHeadGroup v)
-        : m_type(P_TYPE::NOTEHEAD_GROUP), m_data(make_data<NoteHeadGroup>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_GROUP) { store<NoteHeadGroup>(v); }
 
     PropertyValue(ClefType v)
-        : m_type(P_TYPE::CLEF_TYPE), m_data(make_data<ClefType>(v)) {}
+        : m_type(P_TYPE::CLEF_TYPE) { store<ClefType>(v); }
 
     PropertyValue(ClefToBarlinePosition v)
-        : m_type(P_TYPE::CLEF_TO_BARLINE_POS), m_data(make_data<ClefToBarlinePosition>(v)) {}
+        : m_type(P_TYPE::CLEF_TO_BARLINE_POS) { store<ClefToBarlinePosition>(v); }
 
     PropertyValue(DynamicType v)
-        : m_type(P_TYPE::DYNAMIC_TYPE), m_data(make_data<DynamicType>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_TYPE) { store<DynamicType>(v); }
     PropertyValue(DynamicRange v)
-        : m_type(P_TYPE::DYNAMIC_RANGE), m_data(make_data<DynamicRange>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_RANGE) { store<DynamicRange>(v); }
     PropertyValue(DynamicSpeed v)
-        : m_type(P_TYPE::DYNAMIC_SPEED), m_data(make_data<DynamicSpeed>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_SPEED) { store<DynamicSpeed>(v); }
 
     PropertyValue(LineType v)
-        : m_type(P_TYPE::LINE_TYPE), m_data(make_data<LineType>(v)) {}
+        : m_type(P_TYPE::LINE_TYPE) { store<LineType>(v); }
     PropertyValue(HookType v)
-        : m_type(P_TYPE::HOOK_TYPE), m_data(make_data<HookType>(v)) {}
+        : m_type(P_TYPE::HOOK_TYPE) { store<HookType>(v); }
 
     PropertyValue(KeyMode v)
-        : m_type(P_TYPE::KEY_MODE), m_data(make_data<KeyMode>(v)) {}
+        : m_type(P_TYPE::KEY_MODE) { store<KeyMode>(v); }
 
     PropertyValue(TextStyleType v)
-        : m_type(P_TYPE::TEXT_STYLE), m_data(make_data<TextStyleType>(v)) {}
+        : m_type(P_TYPE::TEXT_STYLE) { store<TextStyleType>(v); }
 
     PropertyValue(PlayingTechniqueType v)
-        : m_type(P_TYPE::PLAYTECH_TYPE), m_data(make_data<PlayingTechniqueType>(v)) {}
+        : m_type(P_TYPE::PLAYTECH_TYPE) { store<PlayingTechniqueType>(v); }
 
     PropertyValue(GradualTempoChangeType v)
-        : m_type(P_TYPE::TEMPOCHANGE_TYPE), m_data(make_data<GradualTempoChangeType>(v)) {}
+        : m_type(P_TYPE::TEMPOCHANGE_TYPE) { store<GradualTempoChangeType>(v); }
 
     PropertyValue(SlurStyleType v)
-        : m_type(P_TYPE::SLUR_STYLE_TYPE), m_data(make_data<SlurStyleType>(v)) {}
+        : m_type(P_TYPE::SLUR_STYLE_TYPE) { store<SlurStyleType>(v); }
 
     // Other
     PropertyValue(const GroupNodes& v)
-        : m_type(P_TYPE::GROUPS), m_data(make_data<GroupNodes>(v)) {}
+        : m_type(P_TYPE::GROUPS) { store<GroupNodes>(v); }
 
     PropertyValue(const OrnamentInterval& v)
-        : m_type(P_TYPE::ORNAMENT_INTERVAL), m_data(make_data<OrnamentInterval>(v)) {}
+        : m_type(P_TYPE::ORNAMENT_INTERVAL) { store<OrnamentInterval>(v); }
 
     PropertyValue(const OrnamentShowAccidental& v)
-        : m_type(P_TYPE::ORNAMENT_SHOW_ACCIDENTAL), m_data(make_data<OrnamentShowAccidental>(v)) {}
+        : m_type(P_TYPE::ORNAMENT_SHOW_ACCIDENTAL) { store<OrnamentShowAccidental>(v); }
 
     bool isValid() const;
 
     P_TYPE type() const;
-    bool isEnum() const { return m_data ? m_data->isEnum() : false; }
+    bool isEnum() const;
 
     template<typename T>
     T value() const
@@ -291,105 +357,94 @@ public:
             return T();
         }
 
-        assert(m_data);
-        if (!m_data) {
-            return T();
+        if (m_type == PropertyValueTypeOf<T>::value) {
+            return get<T>();
         }
 
-        Arg<T>* at = get<T>();
-        if (!at) {
-            //! HACK Temporary hack for int to enum
-            if constexpr (std::is_enum<T>::value) {
-                if (P_TYPE::INT == m_type) {
-                    return static_cast<T>(value<int>());
-                }
+        //! HACK Temporary hack for int to enum
+        if constexpr (std::is_enum<T>::value) {
+            if (P_TYPE::INT == m_type) {
+                return static_cast<T>(get<int>());
             }
+        }
 
-            //! HACK Temporary hack for enum to int
-            if constexpr (std::is_same<T, int>::value) {
-                if (m_data->isEnum()) {
-                    return m_data->enumToInt();
-                }
+        //! HACK Temporary hack for enum to int
+        if constexpr (std::is_same<T, int>::value) {
+            if (isEnum()) {
+                return enumToInt();
             }
+        }
 
-            //! HACK Temporary hack for bool to int
-            if constexpr (std::is_same<T, int>::value) {
-                if (P_TYPE::BOOL == m_type) {
-                    return value<bool>();
-                }
+        //! HACK Temporary hack for bool to int
+        if constexpr (std::is_same<T, int>::value) {
+            if (P_TYPE::BOOL == m_type) {
+                return get<bool>();
             }
+        }
 
-            //! HACK Temporary hack for int to bool
-            if constexpr (std::is_same<T, bool>::value) {
-                return value<int>();
-            }
+        //! HACK Temporary hack for int to bool
+        if constexpr (std::is_same<T, bool>::value) {
+            return value<int>();
+        }
 
-            //! HACK Temporary hack for int to size_t
-            if constexpr (std::is_same<T, int>::value) {
-                if (P_TYPE::SIZE_T == m_type) {
-                    return static_cast<int>(value<size_t>());
-                }
+        //! HACK Temporary hack for int to size_t
+        if constexpr (std::is_same<T, int>::value) {
+            if (P_TYPE::SIZE_T == m_type) {
+                return static_cast<int>(get<size_t>());
             }
+        }
 
-            //! HACK Temporary hack for real to Spatium
-            if constexpr (std::is_same<T, Spatium>::value) {
-                if (P_TYPE::REAL == m_type) {
-                    Arg<double>* srv = get<double>();
-                    assert(srv);
-                    return srv ? Spatium(srv->v) : Spatium();
-                }
+        //! HACK Temporary hack for real to Spatium
+        if constexpr (std::is_same<T, Spatium>::value) {
+            if (P_TYPE::REAL == m_type) {
+                return Spatium(get<double>());
             }
+        }
 
-            //! HACK Temporary hack for Spatium to real
-            if constexpr (std::is_same<T, double>::value) {
-                if (P_TYPE::SPATIUM == m_type) {
-                    return value<Spatium>().val();
-                }
+        //! HACK Temporary hack for Spatium to real
+        if constexpr (std::is_same<T, double>::value) {
+            if (P_TYPE::SPATIUM == m_type) {
+                return get<Spatium>().val();
             }
+        }
 
-            //! HACK Temporary hack for real to Millimetre
-            if constexpr (std::is_same<T, Millimetre>::value) {
-                if (P_TYPE::REAL == m_type) {
-                    Arg<double>* mrv = get<double>();
-                    assert(mrv);
-                    return mrv ? Millimetre(mrv->v) : Millimetre();
-                }
+        //! HACK Temporary hack for real to Millimetre
+        if constexpr (std::is_same<T, Millimetre>::value) {
+            if (P_TYPE::REAL == m_type) {
+                return Millimetre(get<double>());
             }
+        }
 
-            //! HACK Temporary hack for Spatium to real
-            if constexpr (std::is_same<T, double>::value) {
-                if (P_TYPE::MILLIMETRE == m_type) {
-                    return value<Millimetre>().val();
-                }
+        //! HACK Temporary hack for Spatium to real
+        if constexpr (std::is_same<T, double>::value) {
+            if (P_TYPE::MILLIMETRE == m_type) {
+                return get<Millimetre>().val();
             }
+        }
 
-            if constexpr (std::is_same<T, String>::value) {
-                //! HACK Temporary hack for Fraction to String
-                if (P_TYPE::FRACTION == m_type) {
-                    return value<Fraction>().toString();
-                }
+        if constexpr (std::is_same<T, String>::value) {
+            //! HACK Temporary hack for Fraction to String
+            if (P_TYPE::FRACTION == m_type) {
+                return get<Fraction>().toString();
             }
+        }
 
 #ifndef NO_QT_SUPPORT
-            if constexpr (std::is_same<T, QString>::value) {
-                //! HACK Temporary hack for Fraction to String
-                if (P_TYPE::FRACTION == m_type) {
-                    return value<Fraction>().toString();
-                }
-
-                //! HACK Temporary hack for String to QString
-                if (P_TYPE::STRING == m_type) {
-                    return value<String>().toQString();
-                }
+        if constexpr (std::is_same<T, QString>::value) {
+            //! HACK Temporary hack for Fraction to String
+            if (P_TYPE::FRACTION == m_type) {
+                return get<Fraction>().toString();
             }
-#endif
-        }
 
-        assert(at);
-        if (!at) {
-            return T();
+            //! HACK Temporary hack for String to QString
+            if (P_TYPE::STRING == m_type) {
+                return get<String>().toQString();
+            }
         }
-        return at->v;
+#endif
+
+        logTypeMismatch(PropertyValueTypeOf<T>::value);
+        return T();
     }
 
     bool toBool() const { return value<bool>(); }
@@ -410,60 +465,70 @@ public:
 #endif
 
 private:
-    struct IArg {
-        virtual ~IArg() = default;
-
-        virtual bool equal(const IArg* a) const = 0;
-
-        virtual bool isEnum() const = 0;
-        virtual int enumToInt() const = 0;
-    };
+    //! NOTE Small values (scalars, enums, points, pairs, fractions, colors...) are stored inline,
+    //! only large payloads such as strings and vectors are shared on the heap
+    static constexpr size_t INLINE_SIZE = 16;
 
     template<typename T>
-    struct Arg : public IArg {
-        T v;
-        Arg(const T& v)
-            : IArg(), v(v) {}
-
-        bool equal(const IArg* a) const override
-        {
-            assert(a);
-            const Arg<T>* at = dynamic_cast<const Arg<T>*>(a);
-            assert(at);
-            return at ? at->v == v : false;
-        }
-
-        //! HACK Temporary hack for enum to int
-        bool isEnum() const override
-        {
-            return std::is_enum<T>::value;
-        }
-
-        int enumToInt() const override
-        {
-            if constexpr (std::is_enum<T>::value) {
-                return static_cast<int>(v);
-            } else {
-                return -1;
-            }
-        }
-    };
+    static constexpr bool isInline()
+    {
+        return sizeof(T) <= INLINE_SIZE && alignof(T) <= alignof(double)
+               && std::is_trivially_copy_constructible<T>::value && std::is_trivially_destructible<T>::value;
+    }
 
     template<typename T>
-    inline std::shared_ptr<IArg> make_data(const T& v) const
+    inline void store(const T& v)
     {
-        return std::shared_ptr<IArg>(new Arg<T>(v));
+        if constexpr (isInline<T>()) {
+            new (m_storage.inlined) T(v);
+        } else {
+            new (&m_storage.shared) std::shared_ptr<void>(std::make_shared<T>(v));
+            m_isShared = true;
+        }
     }
 
+    //! NOTE The caller must make sure that m_type matches T
     template<typename T>
-    inline Arg<T>* get() const
+    inline const T& get() const
     {
-        return dynamic_cast<Arg<T>*>(m_data.get());
+        if constexpr (isInline<T>()) {
+            return *std::launder(reinterpret_cast<const T*>(m_storage.inlined));
+        } else {
+            if (!m_isShared || !m_storage.shared) {
+                static const T dummy = T();
+                logTypeMismatch(PropertyValueTypeOf<T>::value);
+                return dummy;
+            }
+            return *static_cast<const T*>(m_storage.shared.get());
+        }
     }
 
+    void copyFrom(const PropertyValue& other);
+    void moveFrom(PropertyValue& other);
+    void reset();
+
+    void logTypeMismatch(P_TYPE requested) const;
+    int enumToInt() const;
+
+    //! NOTE Only one of the storages is alive at a time, `m_isShared` tells which one
+    union Storage {
+        alignas(double) unsigned char inlined[INLINE_SIZE];
+        std::shared_ptr<void> shared;
+
+        Storage()
+            : inlined{} {}
+        ~Storage() {}
+    };
+
     P_TYPE m_type = P_TYPE::UNDEFINED;
-    std::shared_ptr<IArg> m_data = nullptr;
+    bool m_isShared = false;
+    Storage m_storage;
 };
+
+static_assert(sizeof(PropertyValue) <= 24, "PropertyValue must not be larger than a tagged shared pointer");
+
+static_assert(sizeof(PointF) <= 16 && sizeof(Fraction) <= 16 && sizeof(Color) <= 16,
+              "small property values are expected to be stored inline");
 }
 
 inline mu::logger::Stream& operator<<(mu::logger::Stream& s, const mu::engraving::PropertyValue&)
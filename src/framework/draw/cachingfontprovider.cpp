@@ -0,0 +1,255 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "cachingfontprovider.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+static void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+bool CachingFontProvider::FontKey::operator==(const FontKey& k) const
+{
+    return family == k.family
+           && pointSize == k.pointSize
+           && pixelSize == k.pixelSize
+           && weight == k.weight
+           && style == k.style
+           && noFontMerging == k.noFontMerging
+           && hinting == k.hinting;
+}
+
+bool CachingFontProvider::Key::operator==(const Key& k) const
+{
+    return query == k.query
+           && font == k.font
+           && text == k.text
+           && ucs4 == k.ucs4
+           && rect == k.rect
+           && flags == k.flags
+           && dpi == k.dpi;
+}
+
+size_t CachingFontProvider::KeyHash::operator()(const Key& k) const
+{
+    size_t seed = std::hash<String>()(k.text);
+    hashCombine(seed, static_cast<size_t>(k.query));
+    hashCombine(seed, std::hash<String>()(k.font.family));
+    hashCombine(seed, std::hash<double>()(k.font.pointSize));
+    hashCombine(seed, static_cast<size_t>(k.font.pixelSize));
+    hashCombine(seed, static_cast<size_t>(k.font.weight));
+    hashCombine(seed, static_cast<size_t>(k.font.style));
+    hashCombine(seed, static_cast<size_t>(k.font.noFontMerging));
+    hashCombine(seed, static_cast<size_t>(k.font.hinting));
+    hashCombine(seed, static_cast<size_t>(k.ucs4));
+    hashCombine(seed, static_cast<size_t>(k.flags));
+    hashCombine(seed, std::hash<double>()(k.dpi));
+    return seed;
+}
+
+CachingFontProvider::CachingFontProvider(std::shared_ptr<IFontProvider> provider)
+    : m_provider(provider)
+{
+}
+
+CachingFontProvider::Key CachingFontProvider::makeKey(Query query, const Font& f)
+{
+    Key key;
+    key.query = query;
+    key.font.family = f.family();
+    key.font.pointSize = f.pointSizeF();
+    key.font.pixelSize = f.pixelSize();
+    key.font.weight = static_cast<int>(f.weight());
+    key.font.style = (f.bold() ? 1 : 0) | (f.italic() ? 2 : 0) | (f.underline() ? 4 : 0) | (f.strike() ? 8 : 0);
+    key.font.noFontMerging = f.noFontMerging();
+    key.font.hinting = static_cast<int>(f.hinting());
+    return key;
+}
+
+template<typename T, typename Compute>
+T CachingFontProvider::cached(Cache<T>& cache, Key&& key, const Compute& compute) const
+{
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        ++m_hits;
+        return it->second;
+    }
+    ++m_misses;
+
+    T value = compute();
+
+    if (m_values.size() + m_rects.size() + m_flags.size() >= MAX_ENTRIES) {
+        m_values.clear();
+        m_rects.clear();
+        m_flags.clear();
+        m_memoryUsage = 0;
+    }
+
+    size_t textSize = (key.text.size() + key.font.family.size()) * sizeof(char16_t);
+    if (cache.emplace(std::move(key), value).second) {
+        // the node, its bucket and the texts of the key
+        m_memoryUsage += sizeof(typename Cache<T>::value_type) + 3 * sizeof(void*) + textSize;
+    }
+
+    return value;
+}
+
+CachingFontProvider::Stats CachingFontProvider::stats() const
+{
+    Stats s;
+    s.hits = m_hits;
+    s.misses = m_misses;
+    s.entries = m_values.size() + m_rects.size() + m_flags.size();
+    s.memoryUsage = m_memoryUsage;
+    return s;
+}
+
+void CachingFontProvider::clear()
+{
+    m_values.clear();
+    m_rects.clear();
+    m_flags.clear();
+    m_memoryUsage = 0;
+}
+
+//! NOTE Added fonts and substitutions may change how a font is resolved
+
+int CachingFontProvider::addSymbolFont(const String& family, const io::path_t& path)
+{
+    int ret = m_provider->addSymbolFont(family, path);
+    clear();
+    return ret;
+}
+
+int CachingFontProvider::addTextFont(const io::path_t& path)
+{
+    int ret = m_provider->addTextFont(path);
+    clear();
+    return ret;
+}
+
+void CachingFontProvider::insertSubstitution(const String& familyName, const String& substituteName)
+{
+    m_provider->insertSubstitution(familyName, substituteName);
+    clear();
+}
+
+double CachingFontProvider::lineSpacing(const Font& f) const
+{
+    return cached(m_values, makeKey(Query::LineSpacing, f), [&]() { return m_provider->lineSpacing(f); });
+}
+
+double CachingFontProvider::xHeight(const Font& f) const
+{
+    return cached(m_values, makeKey(Query::XHeight, f), [&]() { return m_provider->xHeight(f); });
+}
+
+double CachingFontProvider::height(const Font& f) const
+{
+    return cached(m_values, makeKey(Query::Height, f), [&]() { return m_provider->height(f); });
+}
+
+double CachingFontProvider::ascent(const Font& f) const
+{
+    return cached(m_values, makeKey(Query::Ascent, f), [&]() { return m_provider->ascent(f); });
+}
+
+double CachingFontProvider::descent(const Font& f) const
+{
+    return cached(m_values, makeKey(Query::Descent, f), [&]() { return m_provider->descent(f); });
+}
+
+bool CachingFontProvider::inFont(const Font& f, Char ch) const
+{
+    Key key = makeKey(Query::InFont, f);
+    key.ucs4 = ch.unicode();
+    return cached(m_flags, std::move(key), [&]() { return m_provider->inFont(f, ch); });
+}
+
+bool CachingFontProvider::inFontUcs4(const Font& f, char32_t ucs4) const
+{
+    Key key = makeKey(Query::InFontUcs4, f);
+    key.ucs4 = ucs4;
+    return cached(m_flags, std::move(key), [&]() { return m_provider->inFontUcs4(f, ucs4); });
+}
+
+double CachingFontProvider::horizontalAdvance(const Font& f, const String& string) const
+{
+    Key key = makeKey(Query::StringAdvance, f);
+    key.text = string;
+    return cached(m_values, std::move(key), [&]() { return m_provider->horizontalAdvance(f, string); });
+}
+
+double CachingFontProvider::horizontalAdvance(const Font& f, const Char& ch) const
+{
+    Key key = makeKey(Query::CharAdvance, f);
+    key.ucs4 = ch.unicode();
+    return cached(m_values, std::move(key), [&]() { return m_provider->horizontalAdvance(f, ch); });
+}
+
+RectF CachingFontProvider::boundingRect(const Font& f, const String& string) const
+{
+    Key key = makeKey(Query::StringBoundingRect, f);
+    key.text = string;
+    return cached(m_rects, std::move(key), [&]() { return m_provider->boundingRect(f, string); });
+}
+
+RectF CachingFontProvider::boundingRect(const Font& f, const Char& ch) const
+{
+    Key key = makeKey(Query::CharBoundingRect, f);
+    key.ucs4 = ch.unicode();
+    return cached(m_rects, std::move(key), [&]() { return m_provider->boundingRect(f, ch); });
+}
+
+RectF CachingFontProvider::boundingRect(const Font& f, const RectF& r, int flags, const String& string) const
+{
+    Key key = makeKey(Query::StringBoundingRectIn, f);
+    key.text = string;
+    key.rect = r;
+    key.flags = flags;
+    return cached(m_rects, std::move(key), [&]() { return m_provider->boundingRect(f, r, flags, string); });
+}
+
+RectF CachingFontProvider::tightBoundingRect(const Font& f, const String& string) const
+{
+    Key key = makeKey(Query::TightBoundingRect, f);
+    key.text = string;
+    return cached(m_rects, std::move(key), [&]() { return m_provider->tightBoundingRect(f, string); });
+}
+
+RectF CachingFontProvider::symBBox(const Font& f, char32_t ucs4, double DPI_F) const
+{
+    Key key = makeKey(Query::SymBBox, f);
+    key.ucs4 = ucs4;
+    key.dpi = DPI_F;
+    return cached(m_rects, std::move(key), [&]() { return m_provider->symBBox(f, ucs4, DPI_F); });
+}
+
+double CachingFontProvider::symAdvance(const Font& f, char32_t ucs4, double DPI_F) const
+{
+    Key key = makeKey(Query::SymAdvance, f);
+    key.ucs4 = ucs4;
+    key.dpi = DPI_F;
+    return cached(m_values, std::move(key), [&]() { return m_provider->symAdvance(f, ucs4, DPI_F); });
+}
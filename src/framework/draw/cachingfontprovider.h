@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_DRAW_CACHINGFONTPROVIDER_H
+#define MU_DRAW_CACHINGFONTPROVIDER_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "ifontprovider.h"
+
+namespace mu::draw {
+//---------------------------------------------------------
+//   CachingFontProvider
+//    Remembers the metrics answered by another font provider,
+//    per font and string or character, so that measuring the
+//    same syllable or chord name again is a hash lookup.
+//    Shared by the whole process, used from one thread
+//    like any font provider (see IFontProvider).
+//---------------------------------------------------------
+
+class CachingFontProvider : public IFontProvider
+{
+public:
+    CachingFontProvider(std::shared_ptr<IFontProvider> provider);
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t entries = 0;
+        size_t memoryUsage = 0;     // bytes, approximately
+
+        double hitRate() const { return (hits + misses) ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    Stats stats() const;
+    void clear();
+
+    int addSymbolFont(const String& family, const io::path_t& path) override;
+    int addTextFont(const io::path_t& path) override;
+    void insertSubstitution(const String& familyName, const String& substituteName) override;
+
+    double lineSpacing(const Font& f) const override;
+    double xHeight(const Font& f) const override;
+    double height(const Font& f) const override;
+    double ascent(const Font& f) const override;
+    double descent(const Font& f) const override;
+
+    bool inFont(const Font& f, Char ch) const override;
+    bool inFontUcs4(const Font& f, char32_t ucs4) const override;
+
+    // Text
+    double horizontalAdvance(const Font& f, const String& string) const override;
+    double horizontalAdvance(const Font& f, const Char& ch) const override;
+
+    RectF boundingRect(const Font& f, const String& string) const override;
+    RectF boundingRect(const Font& f, const Char& ch) const override;
+    RectF boundingRect(const Font& f, const RectF& r, int flags, const String& string) const override;
+    RectF tightBoundingRect(const Font& f, const String& string) const override;
+
+    // Score symbols
+    RectF symBBox(const Font& f, char32_t ucs4, double DPI_F) const override;
+    double symAdvance(const Font& f, char32_t ucs4, double DPI_F) const override;
+
+private:
+    enum class Query : uint8_t {
+        LineSpacing,
+        XHeight,
+        Height,
+        Ascent,
+        Descent,
+        InFont,
+        InFontUcs4,
+        StringAdvance,
+        CharAdvance,
+        StringBoundingRect,
+        CharBoundingRect,
+        StringBoundingRectIn,
+        TightBoundingRect,
+        SymBBox,
+        SymAdvance
+    };
+
+    //! NOTE The font as it is resolved by the provider
+    struct FontKey {
+        String family;
+        double pointSize = -1.0;
+        int pixelSize = -1;
+        int weight = 0;
+        int style = 0;
+        bool noFontMerging = false;
+        int hinting = 0;
+
+        bool operator==(const FontKey& k) const;
+    };
+
+    struct Key {
+        Query query = Query::LineSpacing;
+        FontKey font;
+        String text;
+        char32_t ucs4 = 0;
+        RectF rect;
+        int flags = 0;
+        double dpi = 0.0;
+
+        bool operator==(const Key& k) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const;
+    };
+
+    static Key makeKey(Query query, const Font& f);
+
+    template<typename T>
+    using Cache = std::unordered_map<Key, T, KeyHash>;
+
+    template<typename T, typename Compute>
+    T cached(Cache<T>& cache, Key&& key, const Compute& compute) const;
+
+    //! NOTE A long session with many texts should not grow without bound
+    static constexpr size_t MAX_ENTRIES = 200000;
+
+    std::shared_ptr<IFontProvider> m_provider;
+
+    mutable Cache<double> m_values;
+    mutable Cache<RectF> m_rects;
+    mutable Cache<bool> m_flags;
+    mutable uint64_t m_hits = 0;
+    mutable uint64_t m_misses = 0;
+    mutable size_t m_memoryUsage = 0;
+};
+}
+
+#endif // MU_DRAW_CACHINGFONTPROVIDER_H
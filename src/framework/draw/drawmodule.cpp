@@ -23,11 +23,15 @@
 
 #include "modularity/ioc.h"
 
+#include "cachingfontprovider.h"
+
 #ifndef DRAW_NO_INTERNAL
 #include "internal/qfontprovider.h"
 #include "internal/qimageprovider.h"
 #endif
 
+#include "log.h"
+
 using namespace mu::draw;
 
 std::string DrawModule::moduleName() const
@@ -38,7 +42,21 @@ std::string DrawModule::moduleName() const
 void DrawModule::registerExports()
 {
 #ifndef DRAW_NO_INTERNAL
-    mu::modularity::ioc()->registerExport<draw::IFontProvider>(moduleName(), new QFontProvider());
+    m_fontProvider = std::make_shared<CachingFontProvider>(std::make_shared<QFontProvider>());
+
+    mu::modularity::ioc()->registerExport<draw::IFontProvider>(moduleName(), m_fontProvider);
     mu::modularity::ioc()->registerExport<draw::IImageProvider>(moduleName(), new QImageProvider());
 #endif
 }
+
+void DrawModule::onDeinit()
+{
+    if (!m_fontProvider) {
+        return;
+    }
+
+    CachingFontProvider::Stats stats = m_fontProvider->stats();
+    LOGI() << "font metrics cache: hits: " << stats.hits << ", misses: " << stats.misses
+           << ", hit rate: " << stats.hitRate() << ", entries: " << stats.entries
+           << ", memory: " << stats.memoryUsage / 1024 << " KB";
+}
@@ -22,14 +22,21 @@
 #ifndef MU_DRAW_DRAWMODULE_H
 #define MU_DRAW_DRAWMODULE_H
 
+#include <memory>
+
 #include "modularity/imodulesetup.h"
 
 namespace mu::draw {
+class CachingFontProvider;
 class DrawModule : public modularity::IModuleSetup
 {
 public:
     std::string moduleName() const override;
     void registerExports() override;
+    void onDeinit() override;
+
+private:
+    std::shared_ptr<CachingFontProvider> m_fontProvider;
 };
 }
 
@@ -31,6 +31,15 @@
 #include "types/geometry.h"
 
 namespace mu::draw {
+//! NOTE Threading: the font provider is not thread safe. It is used from the thread
+//! that lays out the scores, which is the main thread:
+//!   - the scores of a master score are laid out one after another on that thread
+//!     (Score::update)
+//!   - the layout passes that run on worker threads leave every item that measures
+//!     text or other fonts to the calling thread (PassLayoutIndependentItems)
+//!   - painting on other threads, such as the PNG export pool, goes through the painter
+//!     and its own font handling, never through this interface
+//! Implementations and wrappers rely on this and do not lock.
 class IFontProvider : MODULE_EXPORT_INTERFACE
 {
     INTERFACE_ID(mu::draw::IFontProvider)
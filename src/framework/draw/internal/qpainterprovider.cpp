@@ -29,6 +29,9 @@
 #include <QPixmapCache>
 #include <QStaticText>
 #include <QPainterPath>
+#include <QImage>
+
+#include "runtime.h"
 
 #include "draw/utils/drawlogger.h"
 #include "types/transform.h"
@@ -303,7 +306,8 @@ void QPainterProvider::drawTextWorkaround(const Font& f, const PointF& pos, cons
 
 void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 {
-    static QHash<char32_t, QString> cache;
+    //! NOTE Pages may be painted on several threads at once (see PngWriter::writePages)
+    thread_local QHash<char32_t, QString> cache;
     if (!cache.contains(ucs4Code)) {
         cache[ucs4Code] = QString::fromUcs4(&ucs4Code, 1);
     }
@@ -311,8 +315,25 @@ void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
     drawText(point, cache.value(ucs4Code));
 }
 
+//! NOTE QPixmap and QPixmapCache may only be used on the main thread,
+//! the other threads paint into images and decode the pixmaps every time
+static bool isPixmapThread()
+{
+    return std::this_thread::get_id() == runtime::mainThreadId();
+}
+
+static QImage imageFromPixmap(const Pixmap& pm)
+{
+    return QImage::fromData(pm.data().toQByteArrayNoCopy());
+}
+
 void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
 {
+    if (!isPixmapThread()) {
+        m_painter->drawImage(QPointF(point.x(), point.y()), imageFromPixmap(pm));
+        return;
+    }
+
     QString key = QString::number(pm.key());
     QPixmap pixmap;
     if (!QPixmapCache::find(key, &pixmap)) {
@@ -325,6 +346,15 @@ void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
 
 void QPainterProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
+    if (!isPixmapThread()) {
+        // the brush pattern starts at the brush origin, that is the offset into the pixmap at the top left of the rect
+        m_painter->save();
+        m_painter->setBrushOrigin(rect.topLeft().toQPointF() - QPointF(offset.x(), offset.y()));
+        m_painter->fillRect(rect.toQRectF(), QBrush(imageFromPixmap(pm)));
+        m_painter->restore();
+        return;
+    }
+
     QString key = QString::number(pm.key());
     QPixmap pixmap;
     if (!QPixmapCache::find(key, &pixmap)) {
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "draw/cachingfontprovider.h"
+
+#include "mocks/fontprovidermock.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::draw;
+
+class Draw_CachingFontProviderTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_provider = std::make_shared<FontProviderMock>();
+        m_cache = std::make_shared<CachingFontProvider>(m_provider);
+    }
+
+protected:
+    std::shared_ptr<FontProviderMock> m_provider;
+    std::shared_ptr<CachingFontProvider> m_cache;
+};
+
+TEST_F(Draw_CachingFontProviderTests, SameStringAsksOnce)
+{
+    //! GIVEN A font
+    Font font(u"Edwin", Font::Type::Text);
+    font.setPointSizeF(10.0);
+
+    //! CHECK The provider is asked once for each string
+    EXPECT_CALL(*m_provider, horizontalAdvance(_, String(u"la"))).Times(1).WillOnce(Return(12.0));
+    EXPECT_CALL(*m_provider, horizontalAdvance(_, String(u"lu"))).Times(1).WillOnce(Return(13.0));
+
+    //! DO Measure repeated syllables
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(m_cache->horizontalAdvance(font, String(u"la")), 12.0);
+        EXPECT_EQ(m_cache->horizontalAdvance(font, String(u"lu")), 13.0);
+    }
+
+    CachingFontProvider::Stats stats = m_cache->stats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_GT(stats.memoryUsage, 0u);
+}
+
+TEST_F(Draw_CachingFontProviderTests, FontIsPartOfKey)
+{
+    //! GIVEN Two fonts that differ only in the size
+    Font small(u"Edwin", Font::Type::Text);
+    small.setPointSizeF(10.0);
+    Font big = small;
+    big.setPointSizeF(20.0);
+
+    //! CHECK The provider is asked for both
+    EXPECT_CALL(*m_provider, ascent(_)).Times(2).WillOnce(Return(8.0)).WillOnce(Return(16.0));
+
+    EXPECT_EQ(m_cache->ascent(small), 8.0);
+    EXPECT_EQ(m_cache->ascent(big), 16.0);
+    EXPECT_EQ(m_cache->ascent(small), 8.0);
+    EXPECT_EQ(m_cache->ascent(big), 16.0);
+}
+
+TEST_F(Draw_CachingFontProviderTests, AddedFontClears)
+{
+    Font font(u"Edwin", Font::Type::Text);
+
+    EXPECT_CALL(*m_provider, boundingRect(_, Char(u'A'))).Times(2).WillRepeatedly(Return(RectF(0, -7, 6, 7)));
+    EXPECT_CALL(*m_provider, addTextFont(_)).Times(1).WillOnce(Return(0));
+
+    EXPECT_EQ(m_cache->boundingRect(font, Char(u'A')), RectF(0, -7, 6, 7));
+    EXPECT_EQ(m_cache->boundingRect(font, Char(u'A')), RectF(0, -7, 6, 7));
+
+    //! DO Add a font, it may change how fonts are resolved
+    m_cache->addTextFont("Edwin-Roman.otf");
+
+    EXPECT_EQ(m_cache->stats().entries, 0u);
+    EXPECT_EQ(m_cache->boundingRect(font, Char(u'A')), RectF(0, -7, 6, 7));
+}
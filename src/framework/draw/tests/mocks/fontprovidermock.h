@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_DRAW_FONTPROVIDERMOCK_H
+#define MU_DRAW_FONTPROVIDERMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "framework/draw/ifontprovider.h"
+
+namespace mu::draw {
+class FontProviderMock : public IFontProvider
+{
+public:
+    MOCK_METHOD(int, addSymbolFont, (const String&, const io::path_t&), (override));
+    MOCK_METHOD(int, addTextFont, (const io::path_t&), (override));
+    MOCK_METHOD(void, insertSubstitution, (const String&, const String&), (override));
+
+    MOCK_METHOD(double, lineSpacing, (const Font&), (const, override));
+    MOCK_METHOD(double, xHeight, (const Font&), (const, override));
+    MOCK_METHOD(double, height, (const Font&), (const, override));
+    MOCK_METHOD(double, ascent, (const Font&), (const, override));
+    MOCK_METHOD(double, descent, (const Font&), (const, override));
+
+    MOCK_METHOD(bool, inFont, (const Font&, Char), (const, override));
+    MOCK_METHOD(bool, inFontUcs4, (const Font&, char32_t), (const, override));
+
+    MOCK_METHOD(double, horizontalAdvance, (const Font&, const String&), (const, override));
+    MOCK_METHOD(double, horizontalAdvance, (const Font&, const Char&), (const, override));
+
+    MOCK_METHOD(RectF, boundingRect, (const Font&, const String&), (const, override));
+    MOCK_METHOD(RectF, boundingRect, (const Font&, const Char&), (const, override));
+    MOCK_METHOD(RectF, boundingRect, (const Font&, const RectF&, int, const String&), (const, override));
+    MOCK_METHOD(RectF, tightBoundingRect, (const Font&, const String&), (const, override));
+
+    MOCK_METHOD(RectF, symBBox, (const Font&, char32_t, double), (const, override));
+    MOCK_METHOD(double, symAdvance, (const Font&, char32_t, double), (const, override));
+};
+}
+
+#endif // MU_DRAW_FONTPROVIDERMOCK_H
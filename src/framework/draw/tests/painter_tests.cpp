@@ -25,6 +25,8 @@
 #include <QImage>
 
 #include "draw/painter.h"
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
 
 #include "draw/internal/qpainterprovider.h"
 
@@ -156,3 +158,35 @@ TEST_F(Draw_PainterTests, Painter_SaveRestore)
 
     EXPECT_EQ(painter.provider()->transform(), worldTransform * expectedViewTransform);
 }
+
+TEST_F(Draw_PainterTests, DrawDataPaint_PaintOnTop)
+{
+    //! GIVEN Draw data recorded with a translation
+    std::shared_ptr<BufferedPaintProvider> recorder = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter painter(recorder, "record");
+        painter.translate(10.0, 20.0);
+        painter.fillRect(RectF(0.0, 0.0, 4.0, 4.0), Brush(Color::BLACK));
+        painter.endDraw();
+    }
+    DrawDataPtr data = recorder->drawData();
+
+    //! GIVEN Painter with a transform of its own
+    QImage pd(100, 100, QImage::Format_ARGB32_Premultiplied);
+    pd.fill(Qt::transparent);
+    QPainter qp(&pd);
+    Painter painter(&qp, "test");
+
+    Transform base(2.0, 0.0, 0.0, 2.0, 5.0, 5.0);
+    painter.setWorldTransform(base);
+
+    //! DO Replay the data on top of it
+    DrawDataPaint::paintOnTop(&painter, data);
+
+    //! CHECK The transform of the painter is kept
+    EXPECT_EQ(painter.provider()->transform(), base);
+
+    //! CHECK The recorded transform is applied after the transform of the painter, from (25, 45) to (33, 53)
+    EXPECT_EQ(qAlpha(pd.pixel(29, 49)), 255);
+    EXPECT_EQ(qAlpha(pd.pixel(12, 22)), 0);
+}
@@ -18,11 +18,6 @@ Color::Color()
     m_isValid = false;
 }
 
-Color::Color(const Color& other)
-    : m_rgba(other.m_rgba), m_isValid(other.m_isValid)
-{
-}
-
 Color::Color(int r, int g, int b, int a)
     : m_rgba(rgba(r, g, b, a)), m_isValid(isRgbaValid(r, g, b, a))
 {
@@ -41,13 +36,6 @@ Color::Color(const QColor& color)
 
 #endif
 
-Color& Color::operator=(const Color& other)
-{
-    m_rgba = other.m_rgba;
-    m_isValid = other.m_isValid;
-    return *this;
-}
-
 #ifndef NO_QT_SUPPORT
 Color& Color::operator=(const QColor& other)
 {
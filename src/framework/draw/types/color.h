@@ -36,7 +36,7 @@ class Color
 {
 public:
     Color();
-    Color(const Color& other);
+    Color(const Color& other) = default;
     Color(int red, int green, int blue, int alpha = DEFAULT_ALPHA);
     Color(const char* color);
 
@@ -46,7 +46,7 @@ public:
 
     ~Color() = default;
 
-    Color& operator=(const Color& other);
+    Color& operator=(const Color& other) = default;
 #ifndef NO_QT_SUPPORT
     Color& operator=(const QColor& other);
 #endif
@@ -27,7 +27,7 @@ using namespace mu;
 using namespace mu::draw;
 
 static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, const std::map<int, DrawData::State>& states,
-                     const Color& overlay)
+                     const Color& overlay, const Transform* base)
 {
     // first draw obj itself
     for (const DrawData::Data& d : item.datas) {
@@ -40,7 +40,7 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
         provider->setPen(st.pen);
         provider->setBrush(st.brush);
         provider->setFont(st.font);
-        provider->setTransform(st.transform);
+        provider->setTransform(base ? st.transform * (*base) : st.transform);
         provider->setAntialiasing(st.isAntialiasing);
         provider->setCompositionMode(st.compositionMode);
 
@@ -76,12 +76,20 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
 
     // second draw chilren
     for (const DrawData::Item& ch : item.chilren) {
-        drawItem(provider, ch, states, overlay);
+        drawItem(provider, ch, states, overlay, base);
     }
 }
 
 void DrawDataPaint::paint(Painter* painter, const DrawDataPtr& data, const Color& overlay)
 {
     IPaintProviderPtr provider = painter->provider();
-    drawItem(provider, data->item, data->states, overlay);
+    drawItem(provider, data->item, data->states, overlay, nullptr);
+}
+
+void DrawDataPaint::paintOnTop(Painter* painter, const DrawDataPtr& data)
+{
+    IPaintProviderPtr provider = painter->provider();
+    const Transform base = provider->transform();
+    drawItem(provider, data->item, data->states, Color(), &base);
+    provider->setTransform(base);
 }
@@ -32,6 +32,10 @@ public:
     DrawDataPaint() = default;
 
     static void paint(Painter* painter, const DrawDataPtr& data, const Color& overlay = Color());
+
+    //! NOTE The recorded transforms are applied on top of the current transform of the painter,
+    //! so data recorded once can be replayed under any view transform
+    static void paintOnTop(Painter* painter, const DrawDataPtr& data);
 };
 }
 
@@ -21,9 +21,18 @@
  */
 #include "allocator.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 #include "stringutils.h"
 #include "log.h"
@@ -78,6 +87,8 @@ const char* ObjectAllocator::name() const
 
 void* ObjectAllocator::alloc(size_t size)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     size = align(size);
 
     if (!m_chunkSize) {
@@ -109,6 +120,8 @@ void* ObjectAllocator::alloc(size_t size)
 
 void ObjectAllocator::free(void* chunk)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     // The freed chunk's next pointer points to the
     // current allocation pointer:
     reinterpret_cast<Chunk*>(chunk)->next = m_free;
@@ -122,6 +135,8 @@ void ObjectAllocator::free(void* chunk)
 
 void ObjectAllocator::cleanup()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     if (m_blocks.empty()) {
         return;
     }
@@ -196,6 +211,8 @@ void* ObjectAllocator::not_supported(const char* info)
 
 ObjectAllocator::Info ObjectAllocator::stateInfo() const
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     Info info;
     info.module = m_module;
     info.name = m_name;
@@ -217,21 +234,545 @@ ObjectAllocator::Info ObjectAllocator::stateInfo() const
     return info;
 }
 
+// ============================================
+// ObjectArena
+// ============================================
+namespace {
+constexpr size_t GRANULE = 16;
+constexpr size_t SIZE_CLASS_COUNT = ObjectArena::MAX_OBJECT_SIZE / GRANULE;
+constexpr size_t BLOCK_HEADER_SIZE = 64; // keeps chunks aligned to GRANULE
+
+// Blocks are registered in a two-level bitmap indexed by their address,
+// so `operator delete` can tell arena chunks from any other memory without locking
+constexpr size_t BLOCK_SHIFT = 16;
+constexpr size_t ADDRESS_BITS = sizeof(void*) == 8 ? 48 : 32;
+constexpr size_t INDEX_BITS = ADDRESS_BITS - BLOCK_SHIFT;
+constexpr size_t LEAF_BITS = INDEX_BITS / 2;
+constexpr size_t ROOT_BITS = INDEX_BITS - LEAF_BITS;
+
+static_assert((size_t(1) << BLOCK_SHIFT) == ObjectArena::BLOCK_SIZE);
+static_assert(ObjectArena::MAX_OBJECT_SIZE % GRANULE == 0);
+
+struct PageMapLeaf {
+    std::atomic<uint64_t> words[(size_t(1) << LEAF_BITS) / 64];
+};
+
+std::atomic<PageMapLeaf*> s_pageMap[size_t(1) << ROOT_BITS];
+
+bool pageMapIndex(const void* ptr, size_t& root, size_t& bit)
+{
+    const uintptr_t index = reinterpret_cast<uintptr_t>(ptr) >> BLOCK_SHIFT;
+    if (index >> INDEX_BITS) {
+        return false;
+    }
+
+    root = static_cast<size_t>(index >> LEAF_BITS);
+    bit = static_cast<size_t>(index & ((uintptr_t(1) << LEAF_BITS) - 1));
+    return true;
+}
+
+bool pageMapSet(const void* block, bool value)
+{
+    size_t root = 0;
+    size_t bit = 0;
+    if (!pageMapIndex(block, root, bit)) {
+        return false;
+    }
+
+    PageMapLeaf* leaf = s_pageMap[root].load(std::memory_order_acquire);
+    if (!leaf) {
+        PageMapLeaf* newLeaf = new PageMapLeaf();
+        if (s_pageMap[root].compare_exchange_strong(leaf, newLeaf, std::memory_order_acq_rel)) {
+            leaf = newLeaf;
+        } else {
+            delete newLeaf;
+        }
+    }
+
+    const uint64_t mask = uint64_t(1) << (bit % 64);
+    if (value) {
+        leaf->words[bit / 64].fetch_or(mask, std::memory_order_release);
+    } else {
+        leaf->words[bit / 64].fetch_and(~mask, std::memory_order_release);
+    }
+    return true;
+}
+
+bool pageMapGet(const void* ptr)
+{
+    size_t root = 0;
+    size_t bit = 0;
+    if (!pageMapIndex(ptr, root, bit)) {
+        return false;
+    }
+
+    const PageMapLeaf* leaf = s_pageMap[root].load(std::memory_order_acquire);
+    if (!leaf) {
+        return false;
+    }
+
+    return leaf->words[bit / 64].load(std::memory_order_acquire) & (uint64_t(1) << (bit % 64));
+}
+
+void* allocateAlignedBlock()
+{
+#ifdef _WIN32
+    return _aligned_malloc(ObjectArena::BLOCK_SIZE, ObjectArena::BLOCK_SIZE);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, ObjectArena::BLOCK_SIZE, ObjectArena::BLOCK_SIZE) != 0) {
+        return nullptr;
+    }
+    return ptr;
+#endif
+}
+
+void freeAlignedBlock(void* ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+struct Chunk {
+    Chunk* next = nullptr;
+};
+
+thread_local ObjectArena* t_currentArena = nullptr;
+
+//! NOTE Identifies the owner thread of a heap; unlike std::thread::id, never shared with a thread that is still alive
+thread_local char t_threadToken = 0;
+}
+
+struct ObjectArena::Impl
+{
+    struct Heap;
+
+    //! NOTE `state` holds the number of live chunks and the RELEASED flag in one word,
+    //! so exactly one of `release` and the last `free` gets to release the block
+    struct Block {
+        static constexpr uint32_t RELEASED = uint32_t(1) << 31;
+        static constexpr uint32_t LIVE_MASK = RELEASED - 1;
+
+        Impl* arena = nullptr;
+        Heap* heap = nullptr;
+        size_t sizeClass = 0;
+        std::atomic<uint32_t> state = 0;
+
+        uint32_t liveCount() const { return state.load(std::memory_order_relaxed) & LIVE_MASK; }
+    };
+
+    static_assert(sizeof(Block) <= BLOCK_HEADER_SIZE);
+
+    //! NOTE Pools of one thread; only the owner thread allocates from them,
+    //! chunks freed by other threads are collected in `remoteFree`.
+    //! When the owner thread exits, the heap is orphaned and adopted by the next thread
+    //! that allocates from the arena, so remote frees are never lost
+    struct Heap {
+        struct Pool {
+            Chunk* free = nullptr;
+            uint8_t* pos = nullptr;
+            uint8_t* end = nullptr;
+        };
+
+        std::atomic<const void*> owner = nullptr;
+        Pool pools[SIZE_CLASS_COUNT];
+
+        std::mutex remoteMutex;
+        Chunk* remoteFree[SIZE_CLASS_COUNT] = {};
+        std::atomic<bool> hasRemoteFree = false;
+
+        std::atomic<uint64_t> totalAllocatedCount = 0;
+        std::atomic<uint64_t> totalFreeCount = 0;
+
+        void collectRemoteFree()
+        {
+            std::lock_guard<std::mutex> lock(remoteMutex);
+            for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i) {
+                while (Chunk* chunk = remoteFree[i]) {
+                    remoteFree[i] = chunk->next;
+                    chunk->next = pools[i].free;
+                    pools[i].free = chunk;
+                }
+            }
+            hasRemoteFree.store(false, std::memory_order_relaxed);
+        }
+    };
+
+    //! NOTE Heaps owned by the current thread, handed back to their arenas when the thread exits,
+    //! or, for arenas released in the meantime, the next time the thread looks up a new heap.
+    //! Each entry keeps its arena alive (see `threadCount`)
+    struct ThreadHeaps {
+        struct Entry {
+            Impl* arena = nullptr;
+            Heap* heap = nullptr;
+        };
+
+        std::vector<Entry> entries;
+        Entry last;
+
+        void dropReleased()
+        {
+            for (auto it = entries.begin(); it != entries.end();) {
+                if (!it->arena->released.load(std::memory_order_acquire)) {
+                    ++it;
+                    continue;
+                }
+
+                if (it->arena->orphanHeap(it->heap)) {
+                    delete it->arena;
+                }
+                it = entries.erase(it);
+            }
+            last = Entry();
+        }
+
+        ~ThreadHeaps()
+        {
+            for (const Entry& e : entries) {
+                if (e.arena->orphanHeap(e.heap)) {
+                    delete e.arena;
+                }
+            }
+        }
+    };
+
+    static ThreadHeaps& threadHeaps()
+    {
+        static thread_local ThreadHeaps heaps;
+        return heaps;
+    }
+
+    static Block* blockOf(const void* ptr)
+    {
+        return reinterpret_cast<Block*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t(BLOCK_SIZE) - 1));
+    }
+
+    std::string name;
+
+    //! NOTE Guards `heaps`, `blocks` and `threadCount`.
+    //! The arena is deleted once it is released, has no blocks left and no thread owns one of its heaps
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Heap> > heaps;
+    std::unordered_set<Block*> blocks;
+    size_t threadCount = 0;
+    std::atomic<bool> released = false;
+
+    bool isDisposable() const
+    {
+        return released.load(std::memory_order_relaxed) && blocks.empty() && threadCount == 0;
+    }
+
+    Heap* heapForCurrentThread()
+    {
+        ThreadHeaps& th = threadHeaps();
+        if (th.last.arena == this) {
+            return th.last.heap;
+        }
+
+        th.dropReleased();
+
+        auto it = std::find_if(th.entries.begin(), th.entries.end(), [this](const ThreadHeaps::Entry& e) { return e.arena == this; });
+        if (it != th.entries.end()) {
+            th.last = *it;
+            return th.last.heap;
+        }
+
+        Heap* heap = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto orphan = std::find_if(heaps.begin(), heaps.end(), [](const std::unique_ptr<Heap>& h) {
+                return h->owner.load(std::memory_order_relaxed) == nullptr;
+            });
+
+            if (orphan != heaps.end()) {
+                heap = orphan->get();
+            } else {
+                heaps.push_back(std::make_unique<Heap>());
+                heap = heaps.back().get();
+            }
+
+            heap->owner.store(&t_threadToken, std::memory_order_release);
+            ++threadCount;
+        }
+
+        th.entries.push_back({ this, heap });
+        th.last = th.entries.back();
+        return heap;
+    }
+
+    //! NOTE Called on thread exit; returns true if the arena can be deleted
+    bool orphanHeap(Heap* heap)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        //! NOTE Chunks of a released arena may belong to blocks that are already gone
+        if (!released.load(std::memory_order_relaxed)) {
+            heap->collectRemoteFree();
+        }
+        heap->owner.store(nullptr, std::memory_order_release);
+        --threadCount;
+
+        return isDisposable();
+    }
+
+    bool newBlock(Heap* heap, size_t sizeClass)
+    {
+        void* mem = allocateAlignedBlock();
+        if (!mem) {
+            return false;
+        }
+
+        if (!pageMapSet(mem, true)) {
+            freeAlignedBlock(mem);
+            return false;
+        }
+
+        Block* block = new (mem) Block();
+        block->arena = this;
+        block->heap = heap;
+        block->sizeClass = sizeClass;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            blocks.insert(block);
+        }
+
+        Heap::Pool& pool = heap->pools[sizeClass];
+        pool.pos = reinterpret_cast<uint8_t*>(mem) + BLOCK_HEADER_SIZE;
+        pool.end = reinterpret_cast<uint8_t*>(mem) + BLOCK_SIZE;
+        return true;
+    }
+
+    static void releaseBlock(Block* block)
+    {
+        pageMapSet(block, false);
+        block->~Block();
+        freeAlignedBlock(block);
+    }
+
+    //! NOTE Called when the owner is gone; returns true if the arena can be deleted.
+    //! The heaps are kept, blocks with live objects still refer to them
+    bool release()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        released.store(true, std::memory_order_release);
+
+        for (auto it = blocks.begin(); it != blocks.end();) {
+            const uint32_t prev = (*it)->state.fetch_or(Block::RELEASED, std::memory_order_acq_rel);
+            if ((prev & Block::LIVE_MASK) == 0) {
+                releaseBlock(*it);
+                it = blocks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        return isDisposable();
+    }
+
+    //! NOTE Called by the free that emptied a released block; returns true if the arena can be deleted
+    bool releaseEmptyBlock(Block* block)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        blocks.erase(block);
+        releaseBlock(block);
+
+        return isDisposable();
+    }
+};
+
+ObjectArena::ObjectArena(const std::string& name)
+    : m_impl(new Impl())
+{
+    m_impl->name = name;
+    AllocatorsRegister::instance()->reg(this);
+}
+
+ObjectArena::~ObjectArena()
+{
+    AllocatorsRegister::instance()->unreg(this);
+
+    if (m_impl->release()) {
+        delete m_impl;
+    }
+}
+
+std::string ObjectArena::name() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->name;
+}
+
+void ObjectArena::setName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->name = name;
+}
+
+ObjectArena::Scope::Scope(ObjectArena* arena)
+    : m_prev(t_currentArena)
+{
+    t_currentArena = arena;
+}
+
+ObjectArena::Scope::~Scope()
+{
+    t_currentArena = m_prev;
+}
+
+ObjectArena* ObjectArena::current()
+{
+    return t_currentArena;
+}
+
+void* ObjectArena::alloc(size_t size)
+{
+    if (size == 0 || size > MAX_OBJECT_SIZE) {
+        return nullptr;
+    }
+
+    const size_t sizeClass = (size - 1) / GRANULE;
+    const size_t chunkSize = (sizeClass + 1) * GRANULE;
+
+    Impl::Heap* heap = m_impl->heapForCurrentThread();
+    Impl::Heap::Pool& pool = heap->pools[sizeClass];
+
+    if (!pool.free && heap->hasRemoteFree.load(std::memory_order_relaxed)) {
+        heap->collectRemoteFree();
+    }
+
+    void* ptr = nullptr;
+    if (pool.free) {
+        ptr = pool.free;
+        pool.free = pool.free->next;
+    } else {
+        if (static_cast<size_t>(pool.end - pool.pos) < chunkSize) {
+            if (!m_impl->newBlock(heap, sizeClass)) {
+                return nullptr;
+            }
+        }
+
+        ptr = pool.pos;
+        pool.pos += chunkSize;
+    }
+
+    Impl::blockOf(ptr)->state.fetch_add(1, std::memory_order_relaxed);
+    heap->totalAllocatedCount.fetch_add(1, std::memory_order_relaxed);
+
+    return ptr;
+}
+
+void* ObjectArena::currentAlloc(size_t size)
+{
+    ObjectArena* arena = t_currentArena;
+    return arena ? arena->alloc(size) : nullptr;
+}
+
+bool ObjectArena::contains(const void* ptr)
+{
+    return ptr && pageMapGet(ptr);
+}
+
+void ObjectArena::free(void* ptr)
+{
+    //! NOTE The block holds at least this chunk, so it, its arena and its heap stay alive
+    //! until the live count is decremented below; after that only the free that empties
+    //! a released block may touch them, the arena can't go away before that block is released
+    Impl::Block* block = Impl::blockOf(ptr);
+    Impl* arena = block->arena;
+    Impl::Heap* heap = block->heap;
+    Chunk* chunk = reinterpret_cast<Chunk*>(ptr);
+
+    if (heap->owner.load(std::memory_order_acquire) == &t_threadToken) {
+        Impl::Heap::Pool& pool = heap->pools[block->sizeClass];
+        chunk->next = pool.free;
+        pool.free = chunk;
+    } else {
+        std::lock_guard<std::mutex> lock(heap->remoteMutex);
+        chunk->next = heap->remoteFree[block->sizeClass];
+        heap->remoteFree[block->sizeClass] = chunk;
+        heap->hasRemoteFree.store(true, std::memory_order_relaxed);
+    }
+
+    heap->totalFreeCount.fetch_add(1, std::memory_order_relaxed);
+
+    const uint32_t prev = block->state.fetch_sub(1, std::memory_order_acq_rel);
+    if (prev == (Impl::Block::RELEASED | 1)) {
+        if (arena->releaseEmptyBlock(block)) {
+            delete arena;
+        }
+    }
+}
+
+ObjectArena::Info ObjectArena::stateInfo() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+
+    Info info;
+    info.name = m_impl->name;
+    info.heapCount = m_impl->heaps.size();
+    info.blockCount = m_impl->blocks.size();
+
+    for (const Impl::Block* block : m_impl->blocks) {
+        info.usedChunks += block->liveCount();
+    }
+
+    for (const auto& heap : m_impl->heaps) {
+        info.totalAllocatedCount += heap->totalAllocatedCount.load(std::memory_order_relaxed);
+        info.totalFreeCount += heap->totalFreeCount.load(std::memory_order_relaxed);
+    }
+
+    return info;
+}
+
 // ============================================
 // AllocatorsRegister
 // ============================================
 void AllocatorsRegister::reg(ObjectAllocator* a)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     m_allocators.push_back(a);
 }
 
 void AllocatorsRegister::unreg(ObjectAllocator* a)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     m_allocators.remove(a);
 }
 
+void AllocatorsRegister::reg(ObjectArena* a)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_arenas.push_back(a);
+}
+
+void AllocatorsRegister::unreg(ObjectArena* a)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_arenas.remove(a);
+}
+
+std::vector<ObjectArena::Info> AllocatorsRegister::arenasInfo() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    std::vector<ObjectArena::Info> infos;
+    for (const ObjectArena* a : m_arenas) {
+        infos.push_back(a->stateInfo());
+    }
+    return infos;
+}
+
 void AllocatorsRegister::cleanupAll(const std::string& module)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     for (ObjectAllocator* a : m_allocators) {
         if (a->module() == module) {
             a->cleanup();
@@ -245,6 +786,8 @@ void AllocatorsRegister::cleanupAll(const std::string& module)
 
 void AllocatorsRegister::printStatistic(const std::string& title)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     std::stringstream stream;
     stream << "\n\n";
     stream << title << "\n";
@@ -274,11 +817,30 @@ void AllocatorsRegister::printStatistic(const std::string& title)
     stream << FORMAT("Total", 20) << VALUE(totalAllocatedCount) << VALUE(totalFreeCount) << VALUE(totalUsedCount) << "\n";
     stream << "Total allocated: " << totalBytes << " bytes\n";
 
+    if (!m_arenas.empty()) {
+        stream << "\narenas: " << m_arenas.size() << '\n';
+        stream << TITLE("Arena") << TITLE("Total alloc") << TITLE("Total free") << TITLE("Used") << TITLE("Threads")
+               << TITLE("allocatedBytes") << "\n";
+
+        for (const ObjectArena* a : m_arenas) {
+            ObjectArena::Info info = a->stateInfo();
+            stream << FORMAT(info.name, 20)
+                   << VALUE(info.totalAllocatedCount)
+                   << VALUE(info.totalFreeCount)
+                   << VALUE(info.usedChunks)
+                   << VALUE(info.heapCount)
+                   << VALUE(info.allocatedBytes())
+                   << "\n";
+        }
+    }
+
     LOGD() << stream.str() << '\n';
 }
 
 void AllocatorsRegister::printState(const std::string& title)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     std::stringstream stream;
     stream << "\n\n";
     stream << title << "\n";
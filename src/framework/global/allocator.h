@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <vector>
 #include <list>
+#include <mutex>
 #include <string>
 
 namespace mu {
@@ -35,10 +36,15 @@ public: \
         return a; \
     } \
     static void* operator new(size_t sz) { \
+        if (void* ptr = ObjectArena::currentAlloc(sz)) { \
+            return ptr; \
+        } \
         return ObjectAllocator::enabled() ? allocator().alloc(sz) : ::operator new(sz); \
     } \
     static void operator delete(void* ptr) { \
-        if (ObjectAllocator::enabled()) { \
+        if (ObjectArena::contains(ptr)) { \
+            ObjectArena::free(ptr); \
+        } else if (ObjectAllocator::enabled()) { \
             allocator().free(ptr); \
         } else { \
             ::operator delete(ptr); \
@@ -144,6 +150,72 @@ private:
     };
 
     Statistic m_statistic;
+    mutable std::recursive_mutex m_mutex;
+};
+
+//! NOTE Scoped arena for objects declared with OBJECT_ALLOCATOR.
+//! While a Scope is active on a thread, such objects are allocated from the arena
+//! (each thread gets its own heap of size-class pools, so no locking on that path;
+//! when a thread exits, its heap is handed over to the next thread allocating from the arena).
+//! Objects may be deleted on any thread at any time, also after the arena itself was destroyed:
+//! the destruction releases all blocks that don't contain live objects anymore, the remaining
+//! ones are released as soon as they become empty.
+//! The arena must not be destroyed while another thread still allocates from it.
+class ObjectArena
+{
+public:
+    explicit ObjectArena(const std::string& name = std::string());
+    ~ObjectArena();
+
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    static constexpr size_t BLOCK_SIZE = 1024 * 64;     // 64 kB, blocks are aligned to their size
+    static constexpr size_t MAX_OBJECT_SIZE = 1024 * 2; // bigger objects are not taken from arenas
+
+    std::string name() const;
+    void setName(const std::string& name);
+
+    class Scope
+    {
+    public:
+        explicit Scope(ObjectArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ObjectArena* m_prev = nullptr;
+    };
+
+    static ObjectArena* current();
+
+    //! NOTE Returns nullptr if the size is not served by arenas
+    void* alloc(size_t size);
+    static void* currentAlloc(size_t size);
+
+    static bool contains(const void* ptr);
+    static void free(void* ptr);
+
+    struct Info
+    {
+        std::string name;
+        size_t heapCount = 0;
+        size_t blockCount = 0;
+        size_t usedChunks = 0;
+
+        uint64_t totalAllocatedCount = 0;
+        uint64_t totalFreeCount = 0;
+
+        uint64_t allocatedBytes() const { return blockCount * BLOCK_SIZE; }
+    };
+
+    Info stateInfo() const;
+
+private:
+    struct Impl;
+    Impl* m_impl = nullptr;
 };
 
 class AllocatorsRegister
@@ -159,6 +231,11 @@ public:
     void reg(ObjectAllocator* a);
     void unreg(ObjectAllocator* a);
 
+    void reg(ObjectArena* a);
+    void unreg(ObjectArena* a);
+
+    std::vector<ObjectArena::Info> arenasInfo() const;
+
     void cleanupAll(const std::string& module);
 
     void printStatistic(const std::string& title);
@@ -166,6 +243,8 @@ public:
 
 private:
     std::list<ObjectAllocator*> m_allocators;
+    std::list<ObjectArena*> m_arenas;
+    mutable std::recursive_mutex m_mutex;
 };
 }
 
@@ -30,6 +30,7 @@
 #include <mutex>
 #include <atomic>
 #include <queue>
+#include <set>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -114,15 +115,7 @@ public:
 
     const std::set<std::thread::id>& threadIdSet() const
     {
-        static std::set<std::thread::id> result;
-
-        if (result.empty()) {
-            for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
-                result.insert(m_threadPool[i].get_id());
-            }
-        }
-
-        return result;
+        return m_threadIdSet;
     }
 
     bool containsThread(const std::thread::id& id) const
@@ -137,6 +130,7 @@ private:
         m_isActive = true;
         for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
             m_threadPool[i] = std::thread(&TaskScheduler::th_workerLoop, this);
+            m_threadIdSet.insert(m_threadPool[i].get_id());
         }
     }
 
@@ -199,6 +193,7 @@ private:
 
     thread_pool_size_t m_threadPoolSize = 0;
     std::unique_ptr<std::thread[]> m_threadPool = nullptr;
+    std::set<std::thread::id> m_threadIdSet;
 };
 }
 
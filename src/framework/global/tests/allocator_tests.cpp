@@ -21,6 +21,11 @@
  */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
 #include "allocator.h"
 
 #include "log.h"
@@ -196,3 +201,233 @@ TEST_F(Global_AllocatorTests, Many_NewCleanup)
     EXPECT_EQ(info.totalChunks, 12); // DEFAULT_BLOCK_SIZE * 3
     EXPECT_EQ(info.freeChunks, 12);
 }
+
+TEST_F(Global_AllocatorTests, Arena_ScopeNewDelete)
+{
+    //! GIVEN An arena
+    ObjectArena arena("test");
+
+    //! DO Create Items inside and outside of the arena scope
+    ItemBase* outside = new Item13(1);
+    ItemBase* inside = nullptr;
+    {
+        ObjectArena::Scope scope(&arena);
+        EXPECT_EQ(ObjectArena::current(), &arena);
+        inside = new Item13(2);
+    }
+    EXPECT_EQ(ObjectArena::current(), nullptr);
+
+    //! CHECK
+    EXPECT_TRUE(inside->alive());
+    EXPECT_TRUE(ObjectArena::contains(inside));
+    EXPECT_FALSE(ObjectArena::contains(outside));
+
+    ObjectArena::Info info = arena.stateInfo();
+    EXPECT_EQ(info.name, "test");
+    EXPECT_EQ(info.usedChunks, 1);
+    EXPECT_EQ(info.blockCount, 1);
+    EXPECT_EQ(info.heapCount, 1);
+
+    //! DO Destroy Items
+    delete inside;
+    delete outside;
+
+    //! CHECK Arena state
+    info = arena.stateInfo();
+    EXPECT_EQ(info.usedChunks, 0);
+    EXPECT_EQ(info.totalAllocatedCount, 1);
+    EXPECT_EQ(info.totalFreeCount, 1);
+
+    //! CHECK The freed chunk is reused
+    {
+        ObjectArena::Scope scope(&arena);
+        ItemBase* again = new Item13(3);
+        EXPECT_EQ(again, inside);
+        delete again;
+    }
+}
+
+TEST_F(Global_AllocatorTests, Arena_Threads)
+{
+    //! GIVEN An arena
+    ObjectArena arena("test");
+
+    //! DO Create Items on several threads, destroy them on this one
+    constexpr size_t THREADS = 4;
+    constexpr size_t ITEMS = 200;
+    std::vector<std::vector<ItemBase*> > items(THREADS);
+    std::vector<std::thread> threads;
+    std::atomic<size_t> done = 0;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&arena, &items, &done, t]() {
+            ObjectArena::Scope scope(&arena);
+            for (size_t i = 0; i < ITEMS; ++i) {
+                items[t].push_back(new Item8(static_cast<uint8_t>(i)));
+            }
+
+            //! NOTE Keep all threads alive until everyone allocated, otherwise heaps are handed over
+            ++done;
+            while (done < THREADS) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! CHECK
+    ObjectArena::Info info = arena.stateInfo();
+    EXPECT_EQ(info.heapCount, THREADS);
+    EXPECT_EQ(info.usedChunks, THREADS * ITEMS);
+
+    for (const std::vector<ItemBase*>& list : items) {
+        for (ItemBase* item : list) {
+            EXPECT_TRUE(ObjectArena::contains(item));
+            delete item;
+        }
+    }
+
+    //! CHECK Arena state
+    info = arena.stateInfo();
+    EXPECT_EQ(info.usedChunks, 0);
+    EXPECT_EQ(info.totalAllocatedCount, THREADS * ITEMS);
+    EXPECT_EQ(info.totalFreeCount, THREADS * ITEMS);
+}
+
+TEST_F(Global_AllocatorTests, Arena_DestroyWithLiveItems)
+{
+    //! GIVEN An arena with items
+    std::unique_ptr<ObjectArena> arena = std::make_unique<ObjectArena>("test");
+
+    std::vector<ItemBase*> items;
+    {
+        ObjectArena::Scope scope(arena.get());
+        for (size_t i = 0; i < 10; ++i) {
+            items.push_back(new Item131(static_cast<uint8_t>(i)));
+        }
+        items.push_back(new Item3(10));
+        delete items.back();
+        items.pop_back();
+    }
+
+    //! DO Destroy the arena
+    arena.reset();
+
+    //! CHECK Items are still alive and can be destroyed
+    for (ItemBase* item : items) {
+        EXPECT_TRUE(ObjectArena::contains(item));
+        EXPECT_TRUE(item->alive());
+        item->str.clear();
+        delete item;
+    }
+
+    //! CHECK The memory was released
+    for (const ItemBase* item : items) {
+        EXPECT_FALSE(ObjectArena::contains(item));
+    }
+}
+
+TEST_F(Global_AllocatorTests, Arena_HeapOfExitedThread)
+{
+    //! GIVEN Items allocated on a thread that exited
+    ObjectArena arena("test");
+
+    std::vector<ItemBase*> items;
+    std::thread([&arena, &items]() {
+        ObjectArena::Scope scope(&arena);
+        for (size_t i = 0; i < 100; ++i) {
+            items.push_back(new Item8(static_cast<uint8_t>(i)));
+        }
+    }).join();
+
+    //! DO Destroy them on this thread
+    for (ItemBase* item : items) {
+        delete item;
+    }
+
+    ObjectArena::Info info = arena.stateInfo();
+    EXPECT_EQ(info.usedChunks, 0);
+    EXPECT_EQ(info.heapCount, 1);
+
+    //! DO Allocate again on another thread
+    std::vector<ItemBase*> again;
+    std::thread([&arena, &again]() {
+        ObjectArena::Scope scope(&arena);
+        for (size_t i = 0; i < 100; ++i) {
+            again.push_back(new Item8(static_cast<uint8_t>(i)));
+        }
+    }).join();
+
+    //! CHECK The heap of the exited thread and the chunks freed into it are reused
+    info = arena.stateInfo();
+    EXPECT_EQ(info.heapCount, 1);
+    EXPECT_EQ(info.blockCount, 1);
+    EXPECT_EQ(info.usedChunks, 100);
+
+    std::sort(items.begin(), items.end());
+    for (ItemBase* item : again) {
+        EXPECT_TRUE(std::binary_search(items.begin(), items.end(), item));
+        delete item;
+    }
+}
+
+TEST_F(Global_AllocatorTests, Arena_FreeWhileDestroying)
+{
+    constexpr size_t THREADS = 4;
+    constexpr size_t ITEMS = 2000;
+
+    for (int run = 0; run < 10; ++run) {
+        //! GIVEN Items allocated on several threads
+        std::unique_ptr<ObjectArena> arena = std::make_unique<ObjectArena>("test");
+
+        std::vector<std::vector<ItemBase*> > items(THREADS);
+        std::atomic<size_t> allocated = 0;
+        std::atomic<bool> destroy = false;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&, t]() {
+                {
+                    ObjectArena::Scope scope(arena.get());
+                    for (size_t i = 0; i < ITEMS; ++i) {
+                        items[t].push_back(new Item13(static_cast<uint8_t>(i)));
+                    }
+                }
+
+                ++allocated;
+                while (!destroy) {
+                    std::this_thread::yield();
+                }
+
+                //! DO Destroy the items of this and of the next thread, while the arena is destroyed
+                const std::vector<ItemBase*>& own = items[t];
+                const std::vector<ItemBase*>& other = items[(t + 1) % THREADS];
+                for (size_t i = 0; i < ITEMS; ++i) {
+                    if (i % 2 == 0) {
+                        delete own[i];
+                    } else {
+                        delete other[i];
+                    }
+                }
+            });
+        }
+
+        while (allocated < THREADS) {
+            std::this_thread::yield();
+        }
+
+        destroy = true;
+        arena.reset();
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        //! CHECK All memory was released
+        for (const std::vector<ItemBase*>& list : items) {
+            for (const ItemBase* item : list) {
+                EXPECT_FALSE(ObjectArena::contains(item));
+            }
+        }
+    }
+}
@@ -895,3 +895,117 @@ TEST_F(Global_Types_StringTests, String_Remove)
     //! CHECK
     EXPECT_EQ(s, "13abc");
 }
+
+TEST_F(Global_Types_StringTests, String_InlineAndShared)
+{
+    //! GIVEN A short (inline) and a long (shared) string
+    String shortStr(u"abc");
+    String longStr(u"a rather long string value");
+
+    //! DO Modify copies
+    String longCopy = longStr;
+    longCopy += u"!";
+    String shortCopy = shortStr;
+    shortCopy += u"defghijklmnop";
+
+    //! CHECK The originals are not affected
+    EXPECT_EQ(longStr, String(u"a rather long string value"));
+    EXPECT_EQ(longCopy, String(u"a rather long string value!"));
+    EXPECT_EQ(shortStr, String(u"abc"));
+    EXPECT_EQ(shortCopy, String(u"abcdefghijklmnop"));
+
+    //! DO Move
+    String moved = std::move(shortCopy);
+
+    //! CHECK
+    EXPECT_EQ(moved, String(u"abcdefghijklmnop"));
+    EXPECT_EQ(String(u"x").prepend(String(u"ab")), String(u"abx"));
+    EXPECT_EQ(String(u"x").prepend(Char(u'a')), String(u"ax"));
+    EXPECT_EQ(String(u"hello").hash(), String(u"hello world").left(5).hash());
+}
+
+TEST_F(Global_Types_StringTests, String_Interned)
+{
+    //! GIVEN Two interned strings with the same text
+    String s1 = String::interned(String::fromUtf8("wind.reed.clarinet.bass"));
+    String s2 = String::interned(String::fromUtf8("wind.reed.clarinet.bass"));
+    EXPECT_EQ(s1, s2);
+
+    //! DO Modify one of them
+    s2.replace(u'.', u'-');
+
+    //! CHECK The other one is not affected
+    EXPECT_EQ(s1, String(u"wind.reed.clarinet.bass"));
+    EXPECT_EQ(s2, String(u"wind-reed-clarinet-bass"));
+    EXPECT_EQ(String::interned(String::fromUtf8("wind.reed.clarinet.bass")), s1);
+}
+
+TEST_F(Global_Types_StringTests, String_InlineTransitions)
+{
+    //! GIVEN A short string
+    String s(u"ab");
+
+    //! DO Grow it past the inline capacity, then shrink it back
+    String copy = s;
+    for (int i = 0; i < 20; ++i) {
+        s += u'c';
+    }
+    EXPECT_EQ(s.size(), 22);
+    EXPECT_EQ(copy, String(u"ab"));
+
+    String longCopy = s;
+    s.truncate(3);
+
+    //! CHECK
+    EXPECT_EQ(s, String(u"abc"));
+    EXPECT_EQ(longCopy.size(), 22);
+    EXPECT_TRUE(longCopy.startsWith(u"abccc"));
+
+    //! DO Write through the non-const operator[] on short and long strings
+    String shortStr(u"xyz");
+    String shortCopy = shortStr;
+    shortStr[1] = u'Y';
+    longCopy[0] = u'A';
+
+    //! CHECK The copies are not affected
+    EXPECT_EQ(shortStr, String(u"xYz"));
+    EXPECT_EQ(shortCopy, String(u"xyz"));
+    EXPECT_EQ(longCopy.at(0), Char(u'A'));
+    EXPECT_EQ(s, String(u"abc"));
+
+    //! DO Move from a long string and reuse it
+    String moved = std::move(longCopy);
+    longCopy = u"reused";
+
+    //! CHECK
+    EXPECT_EQ(moved.size(), 22);
+    EXPECT_EQ(longCopy, String(u"reused"));
+
+    //! DO Self assignment
+    const String& self = moved;
+    moved = self;
+
+    //! CHECK
+    EXPECT_EQ(moved.size(), 22);
+}
+
+TEST_F(Global_Types_StringTests, String_InternedBounded)
+{
+    //! GIVEN More distinct interned strings than the table holds, none of them kept
+    for (int i = 0; i < 10000; ++i) {
+        String::interned(String(u"interned.identifier.") + String::number(i));
+    }
+    EXPECT_EQ(String::interned(String(u"interned.identifier.1")), String(u"interned.identifier.1"));
+
+    //! DO Keep a lot of them alive
+    std::vector<String> kept;
+    for (int i = 0; i < 10000; ++i) {
+        kept.push_back(String::interned(String(u"kept.identifier.") + String::number(i)));
+    }
+
+    //! CHECK Interning still returns equal strings, shared or not
+    for (int i = 0; i < 10000; ++i) {
+        String s = String::interned(String(u"kept.identifier.") + String::number(i));
+        EXPECT_EQ(s, kept.at(i));
+    }
+}
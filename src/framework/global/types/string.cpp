@@ -27,6 +27,8 @@
 #include <locale>
 #include <cctype>
 #include <iomanip>
+#include <mutex>
+#include <unordered_map>
 
 #include "global/thirdparty/utfcpp-3.2.1/utf8.h"
 
@@ -228,12 +230,11 @@ void UtfCodec::utf32to8(std::u32string_view src, std::string& dst)
 
 String::String()
 {
-    m_data = std::make_shared<std::u16string>();
 }
 
 String::String(const char16_t* str)
 {
-    m_data = std::make_shared<std::u16string>(str ? str : u"");
+    setData(std::u16string(str ? str : u""));
 #ifdef STRING_DEBUG_HACK
     updateDebugView();
 #endif
@@ -241,8 +242,8 @@ String::String(const char16_t* str)
 
 String::String(const Char& ch)
 {
-    m_data = std::make_shared<std::u16string>();
-    *m_data.get() += ch.unicode();
+    inlineChars()[0] = ch.unicode();
+    m_inlineSize = 1;
 #ifdef STRING_DEBUG_HACK
     updateDebugView();
 #endif
@@ -251,16 +252,15 @@ String::String(const Char& ch)
 String::String(const Char* unicode, size_t size)
 {
     if (!unicode) {
-        m_data = std::make_shared<std::u16string>();
         return;
     }
 
     static_assert(sizeof(Char) == sizeof(char16_t));
     const char16_t* str = reinterpret_cast<const char16_t*>(unicode);
     if (size == mu::nidx) {
-        m_data = std::make_shared<std::u16string>(str);
+        setData(std::u16string(str));
     } else {
-        m_data = std::make_shared<std::u16string>(str, size);
+        setData(std::u16string(str, size));
     }
 
 #ifdef STRING_DEBUG_HACK
@@ -268,6 +268,88 @@ String::String(const Char* unicode, size_t size)
 #endif
 }
 
+String::String(const String& s)
+{
+    *this = s;
+}
+
+String::String(String&& s) noexcept
+{
+    *this = std::move(s);
+}
+
+String::~String()
+{
+    release();
+}
+
+String& String::operator=(const String& s)
+{
+    if (this == &s) {
+        return *this;
+    }
+
+    //! NOTE Take the reference before releasing, both strings may share the same data
+    if (!s.m_isInline) {
+        s.sharedData()->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    release();
+    std::memcpy(m_storage, s.m_storage, sizeof(m_storage));
+    m_inlineSize = s.m_inlineSize;
+    m_isInline = s.m_isInline;
+
+#ifdef STRING_DEBUG_HACK
+    dview = s.dview;
+#endif
+    return *this;
+}
+
+String& String::operator=(String&& s) noexcept
+{
+    if (this == &s) {
+        return *this;
+    }
+
+    release();
+    std::memcpy(m_storage, s.m_storage, sizeof(m_storage));
+    m_inlineSize = s.m_inlineSize;
+    m_isInline = s.m_isInline;
+
+    //! NOTE The shared data (if any) now belongs to this string
+    s.m_isInline = true;
+    s.m_inlineSize = 0;
+
+#ifdef STRING_DEBUG_HACK
+    dview = std::move(s.dview);
+#endif
+    return *this;
+}
+
+//! NOTE Switches back to an empty inline string
+void String::release()
+{
+    if (!m_isInline) {
+        Data* d = sharedData();
+        if (d->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete d;
+        }
+        m_isInline = true;
+    }
+    m_inlineSize = 0;
+}
+
+void String::setData(std::u16string&& str)
+{
+    release();
+    if (str.size() <= INLINE_CAPACITY) {
+        std::copy(str.cbegin(), str.cend(), inlineChars());
+        m_inlineSize = static_cast<uint8_t>(str.size());
+    } else {
+        setSharedData(new Data(std::move(str)));
+    }
+}
+
 #ifdef STRING_DEBUG_HACK
 void String::updateDebugView()
 {
@@ -280,19 +362,26 @@ void String::updateDebugView()
 
 #endif
 
-const std::u16string& String::constStr() const
-{
-    return *m_data.get();
-}
-
+//! NOTE While the string is inline, the mutation is done on a local copy (short enough for
+//! the small string optimization of std::u16string) that is stored back when the mutator goes away,
+//! so short strings stay inline
 struct String::Mutator {
-    std::u16string& s;
     String* self = nullptr;
+    std::u16string local;
+    std::u16string& s;
 
+    Mutator(String* self)
+        : self(self), local(self->constStr()), s(local) {}
     Mutator(std::u16string& s, String* self)
-        : s(s), self(self) {}
+        : self(self), s(s) {}
+    Mutator(const Mutator&) = delete;
+    Mutator& operator=(const Mutator&) = delete;
+
     ~Mutator()
     {
+        if (&s == &local) {
+            self->setData(std::move(local));
+        }
 #ifdef STRING_DEBUG_HACK
         self->updateDebugView();
 #endif
@@ -305,25 +394,40 @@ struct String::Mutator {
     void reserve(size_t n) { s.reserve(n); }
     void resize(size_t n) { s.resize(n); }
     void clear() { s.clear(); }
-    void insert(size_t p, const std::u16string& v) { s.insert(p, v); }
+    void insert(size_t p, std::u16string_view v) { s.insert(p, v); }
     void erase(size_t p, size_t n) { s.erase(p, n); }
 
     std::u16string& operator=(const std::u16string& v) { return s.operator=(v); }
     std::u16string& operator=(const char16_t* v) { return s.operator=(v); }
     std::u16string& operator=(const char16_t v) { return s.operator=(v); }
 
-    std::u16string& operator+=(const std::u16string& v) { return s.operator+=(v); }
+    std::u16string& operator+=(std::u16string_view v) { return s.operator+=(v); }
     std::u16string& operator+=(const char16_t* v) { return s.operator+=(v); }
     std::u16string& operator+=(const char16_t v) { return s.operator+=(v); }
-    char16_t& operator[](size_t i) { return s.operator[](i); }
 };
 
 String::Mutator String::mutStr(bool do_detach)
 {
+    if (m_isInline) {
+        return Mutator(this);
+    }
+
     if (do_detach) {
         detach();
     }
-    return Mutator(*m_data.get(), this);
+    return Mutator(sharedData()->str, this);
+}
+
+//! NOTE For the callers that keep a reference to the characters, moves the string to the shared buffer
+std::u16string& String::sharedStr()
+{
+    if (m_isInline) {
+        Data* d = new Data(std::u16string(inlineChars(), m_inlineSize));
+        setSharedData(d);
+    } else {
+        detach();
+    }
+    return sharedData()->str;
 }
 
 void String::reserve(size_t i)
@@ -368,15 +472,90 @@ bool String::operator ==(const char* s) const
 
 void String::detach()
 {
-    if (!m_data) {
+    if (m_isInline) {
         return;
     }
 
-    if (m_data.use_count() == 1) {
+    Data* d = sharedData();
+    if (d->refs.load(std::memory_order_acquire) == 1) {
         return;
     }
 
-    m_data = std::make_shared<std::u16string>(*m_data);
+    Data* copy = new Data(std::u16string(d->str));
+    release();
+    setSharedData(copy);
+}
+
+//! NOTE Interned strings are meant for identifiers, so the table is expected to stay small
+static constexpr size_t MAX_INTERNED_STRINGS = 4096;
+static constexpr size_t PRUNE_INTERVAL = MAX_INTERNED_STRINGS / 4;
+
+String String::interned(const String& str)
+{
+    //! NOTE Inline strings have nothing to share
+    if (str.m_isInline) {
+        return str;
+    }
+
+    struct Table {
+        std::mutex mutex;
+        std::unordered_map<std::u16string_view, Data*> data;
+        size_t missesSincePrune = PRUNE_INTERVAL;
+
+        ~Table()
+        {
+            for (auto& entry : data) {
+                if (entry.second->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    delete entry.second;
+                }
+            }
+        }
+
+        //! NOTE Drops the entries that only the table refers to.
+        //! No one else can take a new reference to them, that is only possible through the table
+        void prune()
+        {
+            for (auto it = data.begin(); it != data.end();) {
+                if (it->second->refs.load(std::memory_order_acquire) == 1) {
+                    delete it->second;
+                    it = data.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            missesSincePrune = 0;
+        }
+    };
+
+    static Table table;
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto it = table.data.find(str.constStr());
+    if (it != table.data.end()) {
+        it->second->refs.fetch_add(1, std::memory_order_relaxed);
+        String s;
+        s.setSharedData(it->second);
+        return s;
+    }
+
+    if (table.data.size() >= MAX_INTERNED_STRINGS) {
+        //! NOTE Don't rescan a table full of live strings on every call
+        if (++table.missesSincePrune >= PRUNE_INTERVAL) {
+            table.prune();
+        }
+
+        if (table.data.size() >= MAX_INTERNED_STRINGS) {
+            return str;
+        }
+    }
+
+    //! NOTE The table keeps a reference, so the shared data is never modified in place,
+    //! any mutation of an interned string detaches it first
+    Data* d = str.sharedData();
+    d->refs.fetch_add(1, std::memory_order_relaxed);
+    table.data.emplace(std::u16string_view(d->str), d);
+    return str;
 }
 
 String& String::operator=(const char16_t* str)
@@ -398,7 +577,7 @@ char16_t String::operator [](size_t i) const
 
 char16_t& String::operator [](size_t i)
 {
-    return mutStr()[i];
+    return sharedStr()[i];
 }
 
 String& String::append(Char ch)
@@ -415,13 +594,14 @@ String& String::append(const String& s)
 
 String& String::prepend(Char ch)
 {
-    mutStr() = ch.unicode() + constStr();
+    const char16_t c = ch.unicode();
+    mutStr().insert(0, std::u16string_view(&c, 1));
     return *this;
 }
 
 String& String::prepend(const String& s)
 {
-    mutStr() = s.constStr() + constStr();
+    mutStr().insert(0, s.constStr());
     return *this;
 }
 
@@ -430,8 +610,10 @@ String String::fromUtf8(const char* str)
     if (!str) {
         return String();
     }
+    std::u16string u16;
+    UtfCodec::utf8to16(std::string_view(str), u16);
     String s;
-    UtfCodec::utf8to16(std::string_view(str), s.mutStr());
+    s.setData(std::move(u16));
     return s;
 }
 
@@ -454,12 +636,13 @@ String String::fromAscii(const char* str, size_t size)
     }
 
     size = (size == mu::nidx) ? std::strlen(str) : size;
-    String s;
-    std::u16string& data = s.mutStr();
+    std::u16string data;
     data.resize(size);
     for (size_t i = 0; i < size; ++i) {
         data[i] = Char::fromAscii(str[i]).unicode();
     }
+    String s;
+    s.setData(std::move(data));
     return s;
 }
 
@@ -485,8 +668,10 @@ ByteArray String::toAscii(bool* ok) const
 
 String String::fromStdString(const std::string& str)
 {
+    std::u16string u16;
+    UtfCodec::utf8to16(std::string_view(str), u16);
     String s;
-    UtfCodec::utf8to16(std::string_view(str), s.mutStr());
+    s.setData(std::move(u16));
     return s;
 }
 
@@ -499,7 +684,7 @@ std::string String::toStdString() const
 
 std::u16string String::toStdU16String() const
 {
-    return constStr();
+    return std::u16string(constStr());
 }
 
 String String::fromUcs4(const char32_t* str, size_t size)
@@ -514,8 +699,10 @@ String String::fromUcs4(const char32_t* str, size_t size)
     std::string s8;
     UtfCodec::utf32to8(v32, s8);
 
+    std::u16string u16;
+    UtfCodec::utf8to16(s8, u16);
     String s;
-    UtfCodec::utf8to16(s8, s.mutStr());
+    s.setData(std::move(u16));
     return s;
 }
 
@@ -541,7 +728,7 @@ String String::fromQString(const QString& str)
     const char16_t* u = reinterpret_cast<const char16_t*>(qu);
 
     String s;
-    s.mutStr() = std::u16string(u, u + str.size());
+    s.setData(std::u16string(u, u + str.size()));
     return s;
 }
 
@@ -586,9 +773,9 @@ bool String::contains(const String& str, CaseSensitivity cs) const
     if (cs == CaseSensitivity::CaseSensitive) {
         return constStr().find(str.constStr()) != std::u16string::npos;
     } else {
-        std::u16string self = constStr();
+        std::u16string self(constStr());
         std::transform(self.begin(), self.end(), self.begin(), [](char16_t c){ return Char::toLower(c); });
-        std::u16string other = str.constStr();
+        std::u16string other(str.constStr());
         std::transform(other.begin(), other.end(), other.begin(), [](char16_t c){ return Char::toLower(c); });
         return self.find(other) != std::u16string::npos;
     }
@@ -885,8 +1072,7 @@ void String::doArgs(std::u16string& out, const std::vector<std::u16string_view>&
         size_t argIdxToInsertAfter = mu::nidx;
     };
 
-    const std::u16string& str = constStr();
-    const std::u16string_view view(str);
+    const std::u16string_view view = constStr();
     std::vector<Part> parts;
 
     {
@@ -976,7 +1162,7 @@ String String::mid(size_t pos, size_t count) const
     if (pos > size()) {
         return s;
     }
-    s.mutStr() = constStr().substr(pos, count);
+    s.setData(std::u16string(constStr().substr(pos, count)));
     return s;
 }
 
@@ -1051,7 +1237,8 @@ String String::toLower() const
     return String::fromQString(qs.toLower());
 #else
     String s = *this;
-    std::u16string& us = s.mutStr();
+    Mutator h = s.mutStr();
+    std::u16string& us = h.s;
     std::transform(us.begin(), us.end(), us.begin(), [](char16_t c){ return Char::toLower(c); });
     return s;
 #endif
@@ -1065,7 +1252,8 @@ String String::toUpper() const
     return String::fromQString(qs.toUpper());
 #else
     String s = *this;
-    std::u16string& us = s.mutStr();
+    Mutator h = s.mutStr();
+    std::u16string& us = h.s;
     std::transform(us.begin(), us.end(), us.begin(), [](char16_t c){ return Char::toUpper(c); });
     return s;
 #endif
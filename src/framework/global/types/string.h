@@ -22,6 +22,7 @@
 #ifndef MU_GLOBAL_STRING_H
 #define MU_GLOBAL_STRING_H
 
+#include <atomic>
 #include <memory>
 #include <cstring>
 #include <vector>
@@ -197,6 +198,13 @@ public:
     String(const Char& ch);
     String(const Char* unicode, size_t size = mu::nidx);
 
+    String(const String& s);
+    String(String&& s) noexcept;
+    ~String();
+
+    String& operator=(const String& s);
+    String& operator=(String&& s) noexcept;
+
 #ifndef NO_QT_SUPPORT
     String(const QString& str) { *this = fromQString(str); }
     operator QString() const {
@@ -336,16 +344,61 @@ public:
     static String number(size_t n);
     static String number(double n, int prec = 6);
 
-    inline size_t hash() const { return std::hash<std::u16string> {}(constStr()); }
+    inline size_t hash() const { return std::hash<std::u16string_view> {}(constStr()); }
+
+    //! NOTE Returns a string sharing its data with every other interned string of the same text.
+    //! Meant for identifiers that are repeated many times (style values, instrument ids...).
+    //! The table is bounded: entries that are no longer used anywhere else are dropped when it is full,
+    //! and if it is still full the string is returned as is
+    static String interned(const String& str);
 
 private:
     struct Mutator;
-    const std::u16string& constStr() const;
+
+    //! NOTE Copy-on-write buffer of the strings that don't fit inline
+    struct Data {
+        explicit Data(std::u16string&& s)
+            : str(std::move(s)) {}
+
+        std::atomic<int> refs = 1;
+        std::u16string str;
+    };
+
+    inline const char16_t* inlineChars() const { return reinterpret_cast<const char16_t*>(m_storage); }
+    inline char16_t* inlineChars() { return reinterpret_cast<char16_t*>(m_storage); }
+
+    inline Data* sharedData() const
+    {
+        Data* d = nullptr;
+        std::memcpy(&d, m_storage, sizeof(d));
+        return d;
+    }
+
+    inline void setSharedData(Data* d)
+    {
+        std::memcpy(m_storage, &d, sizeof(d));
+        m_isInline = false;
+    }
+
+    inline std::u16string_view constStr() const
+    {
+        return m_isInline ? std::u16string_view(inlineChars(), m_inlineSize) : std::u16string_view(sharedData()->str);
+    }
+
     Mutator mutStr(bool do_detach = true);
+    std::u16string& sharedStr();
     void detach();
+    void setData(std::u16string&& str);
+    void release();
     void doArgs(std::u16string& out, const std::vector<std::u16string_view>& args) const;
 
-    std::shared_ptr<std::u16string> m_data;
+    //! NOTE Short strings are stored inline, without heap allocation, in the bytes that otherwise hold
+    //! the pointer to the shared buffer, so a String is not larger than two pointers
+    static constexpr size_t INLINE_CAPACITY = (2 * sizeof(void*) - 2) / sizeof(char16_t);
+
+    alignas(void*) unsigned char m_storage[INLINE_CAPACITY * sizeof(char16_t)] = {};
+    uint8_t m_inlineSize = 0;
+    bool m_isInline = true;
 
 #ifdef STRING_DEBUG_HACK
     //! HACK On MacOS with clang there are problems with debugging - the value of the std::u16string is not visible.
@@ -355,6 +408,10 @@ private:
 #endif
 };
 
+#ifndef STRING_DEBUG_HACK
+static_assert(sizeof(String) <= 2 * sizeof(void*), "String must stay as small as a shared pointer");
+#endif
+
 class StringList : public std::vector<String>
 {
 public:
@@ -21,6 +21,8 @@
  */
 #include "abstractimagewriter.h"
 
+#include <QBuffer>
+
 #include "log.h"
 
 using namespace mu::iex::imagesexport;
@@ -68,6 +70,42 @@ mu::Ret AbstractImageWriter::writeList(const INotationPtrList&, QIODevice&, cons
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret AbstractImageWriter::writePages(INotationPtr notation, const PageWritten& onPageWritten, const Options& options)
+{
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (!supportsUnitType(UnitType::PER_PAGE)) {
+        NOT_SUPPORTED;
+        return Ret(Ret::Code::NotSupported);
+    }
+
+    const size_t pageCount = notation->elements()->pages().size();
+    for (size_t i = 0; i < pageCount; ++i) {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+
+        Options pageOptions = options;
+        pageOptions[OptionKey::PAGE_NUMBER] = Val(static_cast<int>(i));
+
+        Ret ret = write(notation, buffer, pageOptions);
+        if (!ret) {
+            return ret;
+        }
+
+        buffer.close();
+
+        ret = onPageWritten(i, data);
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 INotationWriter::UnitType AbstractImageWriter::unitTypeFromOptions(const Options& options) const
 {
     std::vector<UnitType> supported = supportedUnitTypes();
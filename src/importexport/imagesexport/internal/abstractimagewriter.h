@@ -34,6 +34,9 @@ public:
     Ret write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options& options = Options()) override;
     Ret writeList(const notation::INotationPtrList& notations, QIODevice& destinationDevice, const Options& options = Options()) override;
 
+    //! NOTE Writes the pages one after another with write()
+    Ret writePages(notation::INotationPtr notation, const PageWritten& onPageWritten, const Options& options = Options()) override;
+
 protected:
     UnitType unitTypeFromOptions(const Options& options) const;
 };
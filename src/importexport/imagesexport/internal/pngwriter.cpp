@@ -22,16 +22,57 @@
 
 #include "pngwriter.h"
 
+#include <algorithm>
 #include <cmath>
+#include <deque>
+#include <future>
+#include <thread>
+
+#include <QBuffer>
 #include <QImage>
+#include <QPainter>
+
+#include "concurrency/taskscheduler.h"
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
 
 #include "log.h"
 
+using namespace mu;
 using namespace mu::iex::imagesexport;
 using namespace mu::project;
 using namespace mu::notation;
 using namespace mu::io;
 
+//! NOTE Rasterizing and compressing the pages, a pool of its own so that an export
+//! neither waits behind nor delays the audio and layout pools
+static TaskScheduler* exportScheduler()
+{
+    static TaskScheduler s(std::max(std::thread::hardware_concurrency(), 1u));
+    return &s;
+}
+
+static QImage createImage(int width, int height, float dpi, bool transparentBackground)
+{
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    image.setDotsPerMeterX(std::lrint((dpi * 1000) / mu::engraving::INCH));
+    image.setDotsPerMeterY(std::lrint((dpi * 1000) / mu::engraving::INCH));
+    image.fill(transparentBackground ? Qt::transparent : Qt::white);
+
+    return image;
+}
+
+static QByteArray encodePng(const QImage& image)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "png");
+
+    return data;
+}
+
 std::vector<INotationWriter::UnitType> PngWriter::supportedUnitTypes() const
 {
     return { UnitType::PER_PAGE };
@@ -57,12 +98,8 @@ mu::Ret PngWriter::write(INotationPtr notation, QIODevice& destinationDevice, co
     int width = std::lrint(pageSizeInch.width() * CANVAS_DPI);
     int height = std::lrint(pageSizeInch.height() * CANVAS_DPI);
 
-    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
-    image.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / mu::engraving::INCH));
-    image.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / mu::engraving::INCH));
-
     const bool TRANSPARENT_BACKGROUND = options.value(OptionKey::TRANSPARENT_BACKGROUND, Val(false)).toBool();
-    image.fill(TRANSPARENT_BACKGROUND ? Qt::transparent : Qt::white);
+    QImage image = createImage(width, height, CANVAS_DPI, TRANSPARENT_BACKGROUND);
 
     mu::draw::Painter painter(&image, "pngwriter");
 
@@ -72,3 +109,82 @@ mu::Ret PngWriter::write(INotationPtr notation, QIODevice& destinationDevice, co
 
     return true;
 }
+
+//---------------------------------------------------------
+//   writePages
+//    The score may only be read on the calling thread, so the
+//    pages are recorded there one after another, while the
+//    recorded pages are rasterized and compressed on the
+//    export pool. At most MAX_PENDING_PER_THREAD pages per
+//    thread wait for being written, which bounds the memory
+//    of long exports.
+//---------------------------------------------------------
+
+mu::Ret PngWriter::writePages(INotationPtr notation, const PageWritten& onPageWritten, const Options& options)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
+    const bool TRANSPARENT_BACKGROUND = options.value(OptionKey::TRANSPARENT_BACKGROUND, Val(false)).toBool();
+
+    const size_t pageCount = notation->elements()->pages().size();
+    const size_t maxPending = exportScheduler()->threadPoolSize() * MAX_PENDING_PER_THREAD;
+
+    std::deque<std::future<QByteArray> > pending;
+    size_t writtenCount = 0;
+    Ret ret = make_ret(Ret::Code::Ok);
+
+    auto writeFront = [&]() {
+        QByteArray data = pending.front().get();
+        pending.pop_front();
+        ret = onPageWritten(writtenCount++, data);
+    };
+
+    for (size_t i = 0; i < pageCount && ret; ++i) {
+        INotationPainting::Options opt;
+        opt.fromPage = static_cast<int>(i);
+        opt.toPage = opt.fromPage;
+        opt.trimMarginPixelSize = configuration()->trimMarginPixelSize();
+        opt.deviceDpi = CANVAS_DPI;
+        opt.printPageBackground = false; // Printed by us using image.fill
+
+        const SizeF pageSizeInch = notation->painting()->pageSizeInch(opt);
+        int width = std::lrint(pageSizeInch.width() * CANVAS_DPI);
+        int height = std::lrint(pageSizeInch.height() * CANVAS_DPI);
+
+        std::shared_ptr<draw::BufferedPaintProvider> provider = std::make_shared<draw::BufferedPaintProvider>();
+        {
+            draw::Painter painter(provider, "pngwriter");
+            notation->painting()->paintPng(&painter, opt);
+            painter.endDraw();
+        }
+        draw::DrawDataPtr data = provider->drawData();
+
+        pending.push_back(exportScheduler()->submit([data, width, height, CANVAS_DPI, TRANSPARENT_BACKGROUND]() {
+            QImage image = createImage(width, height, CANVAS_DPI, TRANSPARENT_BACKGROUND);
+            {
+                QPainter qp(&image);
+                draw::Painter painter(&qp, "pngwriter");
+                draw::DrawDataPaint::paint(&painter, data);
+                painter.endDraw();
+            }
+
+            return encodePng(image);
+        }));
+
+        if (pending.size() >= maxPending) {
+            writeFront();
+        }
+    }
+
+    // after a failure the pages still being rendered are not written
+    while (!pending.empty() && ret) {
+        writeFront();
+    }
+
+    return ret;
+}
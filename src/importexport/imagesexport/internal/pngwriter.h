@@ -36,6 +36,10 @@ class PngWriter : public AbstractImageWriter
 public:
     std::vector<project::INotationWriter::UnitType> supportedUnitTypes() const override;
     Ret write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(notation::INotationPtr notation, const PageWritten& onPageWritten, const Options& options = Options()) override;
+
+private:
+    static constexpr size_t MAX_PENDING_PER_THREAD = 2;
 };
 }
 
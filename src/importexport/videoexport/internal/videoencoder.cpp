@@ -365,7 +365,8 @@ bool VideoEncoder::encodeImage(const QImage& img)
         av_init_packet(&m_ffmpeg->pkt);
         ret = avcodec_receive_packet(m_ffmpeg->codecCtx, &m_ffmpeg->pkt);
         if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-            return 0;
+            // all the packets available so far are written, the encoder needs more frames
+            return true;
         } else if (ret < 0) {
             LOGE() << "error during encoding";
             return false;
@@ -385,7 +386,8 @@ bool VideoEncoder::encodeImage(const QImage& img)
         m_ffmpeg->pkt = av_packet_alloc();
         ret = avcodec_receive_packet(m_ffmpeg->codecCtx, m_ffmpeg->pkt);
         if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-            return 0;
+            // all the packets available so far are written, the encoder needs more frames
+            return true;
         } else if (ret < 0) {
             LOGE() << "error during encoding";
             return false;
@@ -37,6 +37,8 @@ public:
     bool open(const io::path_t& fileName, unsigned width, unsigned height, unsigned bitrate, unsigned gop, unsigned fps);
     void close();
 
+    //! NOTE Returns false only on an error. The encoder may hold the frame back
+    //! until it gets the next ones, that is not an error.
     bool encodeImage(const QImage& img);
 
 private:
@@ -21,6 +21,12 @@
  */
 #include "videowriter.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "videoencoder.h"
 
 #include "engraving/dom/page.h"
@@ -36,6 +42,66 @@ using namespace mu::iex::videoexport;
 using namespace mu::project;
 using namespace mu::notation;
 
+//---------------------------------------------------------
+//   FrameQueue
+//    The frames prepared on the calling thread, waiting for
+//    the encoder thread. Bounded, so that a slow encoder
+//    holds the preparation back instead of piling up frames.
+//---------------------------------------------------------
+
+namespace mu::iex::videoexport {
+class FrameQueue
+{
+public:
+    explicit FrameQueue(size_t capacity)
+        : m_capacity(capacity) {}
+
+    void push(const QImage& frame)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_frames.size() < m_capacity || m_closed; });
+        if (m_closed) {
+            return;
+        }
+
+        m_frames.push_back(frame);
+        m_notEmpty.notify_one();
+    }
+
+    //! NOTE Returns false once the queue is closed and empty
+    bool pop(QImage& frame)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return !m_frames.empty() || m_closed; });
+        if (m_frames.empty()) {
+            return false;
+        }
+
+        frame = std::move(m_frames.front());
+        m_frames.pop_front();
+        m_notFull.notify_one();
+
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+private:
+    const size_t m_capacity = 0;
+    bool m_closed = false;
+    std::deque<QImage> m_frames;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+};
+}
+
 std::vector<IProjectWriter::UnitType> VideoWriter::supportedUnitTypes() const
 {
     return { UnitType::PER_PART };
@@ -172,19 +238,40 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
     score->update();
 
     // Setup painting
-    QImage frame(config.width, config.height, QImage::Format_RGB32);
-    frame.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
-    frame.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
+    //! NOTE Each page is rasterized once, a frame is a copy of the raster of its page with the cursor on top
+    QImage pageImage(config.width, config.height, QImage::Format_RGB32);
+    pageImage.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
+    pageImage.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
+    RectF frameRect = RectF::fromQRectF(QRectF(pageImage.rect()));
 
-    QPainter qp(&frame);
-    qp.setRenderHint(QPainter::Antialiasing, true);
-    qp.setRenderHint(QPainter::TextAntialiasing, true);
-    RectF frameRect = RectF::fromQRectF(QRectF(frame.rect()));
-
-    draw::Painter painter(&qp, "video_writer");
+    const Page* rasterPage = nullptr;
+    uint64_t rasterLayoutGeneration = 0;
+    draw::Transform pageTransform; // page coordinates to frame pixels
 
     auto painting = masterNotation->notation()->painting();
 
+    auto rasterizePage = [&](const Page* page) {
+        QPainter qp(&pageImage);
+        qp.setRenderHint(QPainter::Antialiasing, true);
+        qp.setRenderHint(QPainter::TextAntialiasing, true);
+
+        draw::Painter painter(&qp, "video_writer");
+        painter.fillRect(frameRect, draw::Color::WHITE);
+
+        INotationPainting::Options opt;
+        opt.fromPage = page->no();
+        opt.toPage = opt.fromPage;
+        opt.deviceDpi = CANVAS_DPI;
+
+        painting->paintPrint(&painter, opt);
+
+        pageTransform = painter.provider()->transform();
+        painter.endDraw();
+
+        rasterPage = page;
+        rasterLayoutGeneration = page->layoutGeneration();
+    };
+
     // Setup duration
     INotationPlaybackPtr playback = masterNotation->playback();
     float totalPlayTimeSec = playback->totalPlayTime() / 1000.0;
@@ -210,7 +297,26 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
     PlaybackCursor cursor;
     cursor.setNotation(masterNotation->notation());
 
-    for (int f = 0; f < frameCount; f++) {
+    // the frames are encoded on a thread of their own while the next ones are prepared
+    FrameQueue frames(MAX_QUEUED_FRAMES);
+    std::atomic<bool> encodeFailed = false;
+    int framesQueued = 0;
+    int framesEncoded = 0;
+
+    std::thread encoderThread([&frames, &encoder, &encodeFailed, &framesEncoded]() {
+        QImage frame;
+        while (frames.pop(frame)) {
+            if (!encoder.encodeImage(frame)) {
+                encodeFailed = true;
+                frames.close();
+                break;
+            }
+
+            ++framesEncoded;
+        }
+    });
+
+    for (int f = 0; f < frameCount && !encodeFailed; f++) {
         float currentTimeSec = (qreal)f / config.fps;
         currentTimeSec -= config.leadingSec;
         if (currentTimeSec <= 0) {
@@ -227,14 +333,9 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
             break;
         }
 
-        INotationPainting::Options opt;
-        opt.fromPage = page->no();
-        opt.toPage = opt.fromPage;
-        opt.deviceDpi = CANVAS_DPI;
-
-        painter.fillRect(frameRect, draw::Color::WHITE);
-
-        painting->paintPrint(&painter, opt);
+        if (page != rasterPage || page->layoutGeneration() != rasterLayoutGeneration) {
+            rasterizePage(page);
+        }
 
         cursor.move(tick);
 
@@ -242,12 +343,37 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
         PointF pagePos = page->pos();
         RectF cursorAbsRect = cursorRect.translated(-pagePos);
 
-        painter.fillRect(cursorAbsRect, CURSOR_COLOR);
+        QImage frame = pageImage;
+        {
+            QPainter qp(&frame);
+            qp.setRenderHint(QPainter::Antialiasing, true);
 
-        encoder.encodeImage(frame);
+            draw::Painter painter(&qp, "video_writer");
+            painter.setWorldTransform(pageTransform);
+            painter.fillRect(cursorAbsRect, CURSOR_COLOR);
+            painter.endDraw();
+        }
+
+        frames.push(frame);
+        ++framesQueued;
     }
 
+    frames.close();
+    encoderThread.join();
+
     encoder.close();
 
+    if (encodeFailed) {
+        LOGE() << "failed encode frame";
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (framesEncoded != framesQueued) {
+        LOGE() << "encoded " << framesEncoded << " of " << framesQueued << " frames";
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    LOGI() << "encoded frames: " << framesEncoded;
+
     return make_ok();
 }
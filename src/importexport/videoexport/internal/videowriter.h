@@ -41,6 +41,9 @@ public:
 
 private:
 
+    //! NOTE The frames prepared ahead of the encoder
+    static constexpr size_t MAX_QUEUED_FRAMES = 4;
+
     struct Config
     {
         int width = 1920;
@@ -46,6 +46,14 @@ public:
     virtual SizeF pageSizeInch(const Options& opt) const = 0;
 
     virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+
+    //! NOTE The parts of paintView, for views that cache the painted score content:
+    //! the layout of the pages coming into view, the score content itself, and
+    //! the interaction state painted on top of it (edit grips, lasso, drop targets...)
+    virtual void layoutView(const RectF& frameRect) = 0;
+    virtual void paintViewContent(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+    virtual void paintViewOverlay(draw::Painter* painter, bool isPrinting) = 0;
+
     virtual void paintPdf(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(draw::Painter* painter, const Options& opt) = 0;
@@ -599,7 +599,7 @@ void MasterNotation::setExcerptIsOpen(const INotationPtr excerptNotation, bool o
     excerptNotation->setIsOpen(open);
 
     if (open) {
-        excerptNotation->elements()->msScore()->doLayout();
+        excerptNotation->elements()->msScore()->layoutIfNeeded();
     }
 }
 
@@ -90,6 +90,8 @@ Notation::Notation(mu::engraving::Score* score)
     configuration()->canvasOrientation().ch.onReceive(this, [this](framework::Orientation) {
         if (m_score && m_score->autoLayoutEnabled()) {
             m_score->doLayout();
+        } else if (m_score) {
+            m_score->setNeedsLayout();
         }
     });
 
@@ -24,6 +24,8 @@
 #include <QScreen>
 
 #include "engraving/dom/score.h"
+#include "engraving/dom/page.h"
+#include "engraving/dom/undo.h"
 
 #include "notation.h"
 #include "notationinteraction.h"
@@ -35,9 +37,25 @@ using namespace mu::notation;
 using namespace mu::engraving;
 using namespace mu::draw;
 
+//! NOTE Pages laid out per event loop iteration while a progressive layout is pending
+static constexpr size_t LAYOUT_CHUNK_PAGES = 4;
+
 NotationPainting::NotationPainting(Notation* notation)
     : m_notation(notation)
 {
+    m_layoutTimer.setSingleShot(true);
+    m_layoutTimer.setInterval(0);
+    QObject::connect(&m_layoutTimer, &QTimer::timeout, [this]() { continueLayout(); });
+
+    m_notation->scoreInited().onNotify(this, [this]() {
+        scheduleLayout();
+    });
+
+    // edits either keep the pending layout or restart it,
+    // in both cases the next chunk starts from the current state
+    m_notation->notationChanged().onNotify(this, [this]() {
+        scheduleLayout();
+    });
 }
 
 mu::engraving::Score* NotationPainting::score() const
@@ -45,6 +63,66 @@ mu::engraving::Score* NotationPainting::score() const
     return m_notation->score();
 }
 
+void NotationPainting::scheduleLayout()
+{
+    if (score() && score()->layoutPending()) {
+        m_layoutTimer.start();
+    } else {
+        m_layoutTimer.stop();
+    }
+}
+
+void NotationPainting::continueLayout()
+{
+    if (!score() || !score()->layoutPending()) {
+        return;
+    }
+
+    // don't lay out in the middle of a command, its end schedules the layout again
+    if (score()->undoStack()->active()) {
+        return;
+    }
+
+    score()->continueLayout(LAYOUT_CHUNK_PAGES);
+
+    // updates the page count and the navigator, and schedules the next chunk
+    m_notation->notifyAboutNotationChanged();
+}
+
+//---------------------------------------------------------
+//   layoutView
+//    lay out the pages coming into view
+//    before the background layout reaches them
+//---------------------------------------------------------
+
+void NotationPainting::layoutView(const RectF& frameRect)
+{
+    if (!score()) {
+        return;
+    }
+
+    // a score that changed while it was not open is laid out when it is painted
+    if (score()->needsLayout() && !score()->undoStack()->active()) {
+        score()->layoutIfNeeded();
+    }
+
+    while (score()->layoutPending() && !score()->pages().empty()) {
+        const RectF lastPageRect = score()->pages().back()->canvasBoundingRect();
+        const bool covered = MScore::verticalOrientation()
+                             ? lastPageRect.bottom() >= frameRect.bottom()
+                             : lastPageRect.right() >= frameRect.right();
+        if (covered) {
+            break;
+        }
+
+        const size_t npages = score()->npages();
+        score()->continueLayout(1);
+        if (score()->npages() <= npages) {
+            break;
+        }
+    }
+}
+
 void NotationPainting::setViewMode(const ViewMode& viewMode)
 {
     if (!score()) {
@@ -124,10 +202,6 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
     };
 
     scoreRenderer()->paintScore(painter, score(), myopt);
-
-    if (!myopt.isPrinting) {
-        static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
-    }
 }
 
 void NotationPainting::paintPageSheet(Painter* painter, const Page* page, const RectF& pageRect, bool printPageBackground) const
@@ -179,6 +253,13 @@ void NotationPainting::paintPageSheet(Painter* painter, const Page* page, const
 }
 
 void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting)
+{
+    layoutView(frameRect);
+    paintViewContent(painter, frameRect, isPrinting);
+    paintViewOverlay(painter, isPrinting);
+}
+
+void NotationPainting::paintViewContent(Painter* painter, const RectF& frameRect, bool isPrinting)
 {
     Options opt;
     opt.isSetViewport = false;
@@ -186,9 +267,19 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     opt.frameRect = frameRect;
     opt.deviceDpi = uiConfiguration()->logicalDpi();
     opt.isPrinting = isPrinting;
+    opt.useDisplayList = true;
     doPaint(painter, opt);
 }
 
+void NotationPainting::paintViewOverlay(Painter* painter, bool isPrinting)
+{
+    if (!score() || isPrinting) {
+        return;
+    }
+
+    static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
+}
+
 void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
 {
     Q_ASSERT(opt.deviceDpi > 0);
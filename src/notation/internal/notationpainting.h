@@ -22,8 +22,11 @@
 #ifndef MU_NOTATION_NOTATIONPAINTING_H
 #define MU_NOTATION_NOTATIONPAINTING_H
 
+#include <QTimer>
+
 #include "../inotationpainting.h"
 
+#include "async/asyncable.h"
 #include "modularity/ioc.h"
 #include "../inotationconfiguration.h"
 #include "engraving/iengravingconfiguration.h"
@@ -37,7 +40,7 @@ class Page;
 
 namespace mu::notation {
 class Notation;
-class NotationPainting : public INotationPainting
+class NotationPainting : public INotationPainting, public async::Asyncable
 {
     INJECT(INotationConfiguration, configuration)
     INJECT(engraving::IEngravingConfiguration, engravingConfiguration)
@@ -56,6 +59,9 @@ public:
     SizeF pageSizeInch(const Options& opt) const override;
 
     void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    void layoutView(const RectF& frameRect) override;
+    void paintViewContent(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    void paintViewOverlay(draw::Painter* painter, bool isPrinting) override;
     void paintPdf(draw::Painter* painter, const Options& opt) override;
     void paintPrint(draw::Painter* painter, const Options& opt) override;
     void paintPng(draw::Painter* painter, const Options& opt) override;
@@ -63,6 +69,9 @@ public:
 private:
     mu::engraving::Score* score() const;
 
+    void scheduleLayout();
+    void continueLayout();
+
     bool isPaintPageBorder() const;
     void doPaint(draw::Painter* painter, const Options& opt);
     void paintPageBorder(draw::Painter* painter, const mu::engraving::Page* page) const;
@@ -71,6 +80,8 @@ private:
     Notation* m_notation = nullptr;
 
     async::Notification m_viewModeChanged;
+
+    QTimer m_layoutTimer;
 };
 }
 
@@ -0,0 +1,208 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QImage>
+#include <QPainter>
+
+#include "notation/view/notationtilecache.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/dom/factory.h"
+#include "engraving/dom/masterscore.h"
+#include "engraving/dom/page.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::engraving;
+
+//! NOTE At the identity view matrix the tiles are 256 logical units wide,
+//! this frame covers the columns 0..3 and the rows 0..1
+static const RectF FRAME_RECT(1.0, 1.0, 1021.0, 509.0);
+static constexpr size_t FRAME_TILES = 8;
+static constexpr size_t TILE_BYTES = 256 * 256 * 4;
+
+class Notation_NotationTileCacheTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_score = compat::ScoreAccess::createMasterScore();
+
+        // the first page is under the columns 0 and 1, the second one under the columns 2 and 3
+        m_page1 = createPage(PointF(0.0, 0.0));
+        m_page2 = createPage(PointF(600.0, 0.0));
+    }
+
+    void TearDown() override
+    {
+        delete m_page1;
+        delete m_page2;
+        delete m_score;
+    }
+
+    Page* createPage(const PointF& pos)
+    {
+        Page* page = Factory::createPage(m_score->rootItem());
+        page->mutldata()->setBbox(0.0, 0.0, 400.0, 500.0);
+        page->setPos(pos);
+        page->markLayoutChanged();
+
+        return page;
+    }
+
+    //! NOTE Returns the number of tiles rendered
+    size_t paint(NotationTileCache& cache, const RectF& frameRect = FRAME_RECT)
+    {
+        size_t rendered = 0;
+
+        QPainter qp(&m_target);
+        cache.paint(&qp, frameRect, draw::Transform(), 1.0, false, [&rendered](draw::Painter*, const RectF&) {
+            ++rendered;
+        });
+
+        return rendered;
+    }
+
+    MasterScore* m_score = nullptr;
+    Page* m_page1 = nullptr;
+    Page* m_page2 = nullptr;
+
+    QImage m_target = QImage(1024, 512, QImage::Format_ARGB32_Premultiplied);
+};
+
+TEST_F(Notation_NotationTileCacheTests, PaintRendersTilesOnce)
+{
+    NotationTileCache cache;
+
+    EXPECT_EQ(paint(cache), FRAME_TILES);
+    EXPECT_EQ(cache.tilesCount(), FRAME_TILES);
+    EXPECT_EQ(cache.memoryUsage(), FRAME_TILES * TILE_BYTES);
+
+    // [THEN] Painting again only blits the tiles
+    EXPECT_EQ(paint(cache), 0u);
+
+    // [THEN] A rect invalidates only the tiles under it
+    cache.invalidate(RectF(10.0, 10.0, 20.0, 20.0));
+    EXPECT_EQ(paint(cache), 1u);
+
+    cache.invalidate();
+    EXPECT_EQ(cache.tilesCount(), 0u);
+    EXPECT_EQ(paint(cache), FRAME_TILES);
+}
+
+TEST_F(Notation_NotationTileCacheTests, InvalidateChangedPages)
+{
+    NotationTileCache cache;
+
+    // [GIVEN] The pages are known to the cache and the frame is painted
+    EXPECT_TRUE(cache.invalidateChangedPages({ m_page1, m_page2 }));
+    EXPECT_EQ(paint(cache), FRAME_TILES);
+
+    // [THEN] Nothing changed, nothing is painted again
+    EXPECT_FALSE(cache.invalidateChangedPages({ m_page1, m_page2 }));
+    EXPECT_EQ(paint(cache), 0u);
+
+    // [WHEN] The second page is laid out again
+    m_page2->markLayoutChanged();
+
+    // [THEN] Only its tiles are painted again
+    EXPECT_TRUE(cache.invalidateChangedPages({ m_page1, m_page2 }));
+    EXPECT_EQ(paint(cache), 4u);
+
+    // [WHEN] The first page moves
+    m_page1->setPos(0.0, -10.0);
+
+    // [THEN] The tiles under its old and new position are painted again
+    EXPECT_TRUE(cache.invalidateChangedPages({ m_page1, m_page2 }));
+    EXPECT_EQ(paint(cache), 4u);
+
+    // [WHEN] The second page is removed
+    EXPECT_TRUE(cache.invalidateChangedPages({ m_page1 }));
+    EXPECT_EQ(paint(cache), 4u);
+
+    // [WHEN] It is added back
+    EXPECT_TRUE(cache.invalidateChangedPages({ m_page1, m_page2 }));
+    EXPECT_EQ(paint(cache), 4u);
+
+    EXPECT_FALSE(cache.invalidateChangedPages({ m_page1, m_page2 }));
+    EXPECT_EQ(paint(cache), 0u);
+}
+
+TEST_F(Notation_NotationTileCacheTests, InvalidateSelection)
+{
+    NotationTileCache cache;
+    EXPECT_EQ(paint(cache), FRAME_TILES);
+
+    // [WHEN] An item in the tile (0, 0) is selected
+    cache.invalidateSelection(RectF(10.0, 10.0, 20.0, 20.0));
+    EXPECT_EQ(cache.selectionRect(), RectF(10.0, 10.0, 20.0, 20.0));
+    EXPECT_EQ(paint(cache), 1u);
+
+    // [WHEN] An item in the tile (2, 1) is selected instead
+    // [THEN] The tiles of both the previous and the new selection are painted again
+    cache.invalidateSelection(RectF(700.0, 300.0, 20.0, 20.0));
+    EXPECT_EQ(paint(cache), 2u);
+
+    // [WHEN] The selected items were laid out again, so their tiles are already invalid
+    cache.setSelectionRect(RectF(300.0, 10.0, 20.0, 20.0));
+    EXPECT_EQ(paint(cache), 0u);
+
+    // [WHEN] The selection is cleared
+    // [THEN] Only the tile (1, 0) of the remembered selection is painted again
+    cache.invalidateSelection(RectF());
+    EXPECT_TRUE(cache.selectionRect().isEmpty());
+    EXPECT_EQ(paint(cache), 1u);
+
+    // [THEN] A selection across tiles invalidates all of them
+    cache.invalidateSelection(RectF(200.0, 200.0, 100.0, 100.0));
+    EXPECT_EQ(paint(cache), 4u);
+}
+
+TEST_F(Notation_NotationTileCacheTests, MemoryBound)
+{
+    EXPECT_EQ(NotationTileCache().maxMemory(), NotationTileCache::DEFAULT_MAX_MEMORY);
+
+    // [GIVEN] A cache that holds 4 tiles
+    NotationTileCache cache(4 * TILE_BYTES);
+
+    // [WHEN] More tiles are visible
+    EXPECT_EQ(paint(cache), FRAME_TILES);
+
+    // [THEN] The least recently used ones are dropped
+    EXPECT_EQ(cache.tilesCount(), 4u);
+    EXPECT_LE(cache.memoryUsage(), cache.maxMemory());
+
+    // [THEN] The tiles of the row 1 were painted last, so they are kept
+    const RectF secondRow(1.0, 257.0, 1021.0, 253.0);
+    EXPECT_EQ(paint(cache, secondRow), 0u);
+
+    // [WHEN] The row 0 is painted again
+    const RectF firstRow(1.0, 1.0, 1021.0, 253.0);
+    EXPECT_EQ(paint(cache, firstRow), 4u);
+
+    // [THEN] It replaced the row 1
+    EXPECT_EQ(cache.tilesCount(), 4u);
+    EXPECT_LE(cache.memoryUsage(), cache.maxMemory());
+    EXPECT_EQ(paint(cache, secondRow), 4u);
+}
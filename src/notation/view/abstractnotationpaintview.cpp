@@ -236,9 +236,13 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
 
     INotationInteractionPtr interaction = notationInteraction();
 
+    invalidateContent();
+    m_tileCache.setSelectionRect(selectionRect());
+
     m_notation->notationChanged().onNotify(this, [this, interaction]() {
         interaction->hideShadowNote();
         m_shadowNoteRect = RectF();
+        invalidateChangedTiles();
         scheduleRedraw();
     });
 
@@ -248,6 +252,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->selectionChanged().onNotify(this, [this]() {
+        invalidateSelectionTiles();
         scheduleRedraw();
     });
 
@@ -310,6 +315,9 @@ void AbstractNotationPaintView::onUnloadNotation(INotationPtr)
     interaction->noteInput()->stateChanged().resetOnNotify(this);
     interaction->selectionChanged().resetOnNotify(this);
 
+    invalidateContent();
+    m_tileCache.setSelectionRect(RectF());
+
     if (isMainView()) {
         m_notation->accessibility()->setMapToScreenFunc(nullptr);
         m_notation->interaction()->setGetViewRectFunc(nullptr);
@@ -575,10 +583,20 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     Transform guiScalingCompensation;
     guiScalingCompensation.scale(guiScaling, guiScaling);
 
-    painter->setWorldTransform(m_matrix * guiScalingCompensation);
-
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    RectF frameRect = toLogical(rect);
+
+    INotationPaintingPtr painting = notation()->painting();
+    painting->layoutView(frameRect);
+    invalidateChangedTiles(false);
+
+    //! NOTE The score content is blitted from cached bitmaps,
+    //! everything on top of it is painted every time
+    painter->setWorldTransform(guiScalingCompensation);
+    paintContent(qp, frameRect, m_matrix, guiScaling * qp->device()->devicePixelRatioF(), isPrinting);
+
+    painter->setWorldTransform(m_matrix * guiScalingCompensation);
+    painting->paintViewOverlay(painter, isPrinting);
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -595,6 +613,21 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     }
 }
 
+void AbstractNotationPaintView::paintContent(QPainter* painter, const RectF& frameRect, const Transform& viewMatrix, qreal pixelRatio,
+                                             bool isPrinting)
+{
+    INotationPaintingPtr painting = notation()->painting();
+    m_tileCache.paint(painter, frameRect, viewMatrix, pixelRatio, isPrinting,
+                      [painting, isPrinting](draw::Painter* tilePainter, const RectF& tileRect) {
+        painting->paintViewContent(tilePainter, tileRect, isPrinting);
+    });
+}
+
+void AbstractNotationPaintView::invalidateContent()
+{
+    m_tileCache.invalidate();
+}
+
 void AbstractNotationPaintView::onNotationSetup()
 {
     TRACEFUNC;
@@ -614,14 +647,17 @@ void AbstractNotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        invalidateContent();
         scheduleRedraw();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        invalidateContent();
         scheduleRedraw();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        invalidateContent();
         scheduleRedraw();
     });
 }
@@ -639,6 +675,54 @@ void AbstractNotationPaintView::paintBackground(const RectF& rect, draw::Painter
     }
 }
 
+//---------------------------------------------------------
+//   invalidateChangedTiles
+//    the tiles of the pages laid out again are repainted;
+//    a change of the notation without any layout (edit mode,
+//    drop targets, show invisible...) may be anywhere
+//---------------------------------------------------------
+
+void AbstractNotationPaintView::invalidateChangedTiles(bool invalidateAllIfNoLayout)
+{
+    TRACEFUNC;
+
+    const engraving::Score* score = notationElements() ? notationElements()->msScore() : nullptr;
+    if (!score) {
+        m_tileCache.invalidate();
+        return;
+    }
+
+    bool laidOut = m_tileCache.invalidateChangedPages(score->pages());
+    if (!laidOut && invalidateAllIfNoLayout) {
+        m_tileCache.invalidate();
+    }
+
+    // the selected items may have moved
+    if (laidOut) {
+        m_tileCache.setSelectionRect(selectionRect());
+    }
+}
+
+void AbstractNotationPaintView::invalidateSelectionTiles()
+{
+    m_tileCache.invalidateSelection(selectionRect());
+}
+
+RectF AbstractNotationPaintView::selectionRect() const
+{
+    INotationSelectionPtr selection = notationSelection();
+    if (!selection) {
+        return RectF();
+    }
+
+    RectF rect;
+    for (const EngravingItem* item : selection->elements()) {
+        rect.unite(item->canvasBoundingRect());
+    }
+
+    return rect;
+}
+
 PointF AbstractNotationPaintView::canvasCenter() const
 {
     TRACEFUNC;
@@ -45,6 +45,7 @@
 #include "playbackcursor.h"
 #include "loopmarker.h"
 #include "continuouspanel.h"
+#include "notationtilecache.h"
 #include "internal/abstractelementpopupmodel.h"
 
 namespace mu::notation {
@@ -176,6 +177,11 @@ protected:
     // Draw
     void paint(QPainter* painter) override;
 
+    //! NOTE Paints the score content, by default from the raster tiles
+    virtual void paintContent(QPainter* painter, const RectF& frameRect, const draw::Transform& viewMatrix, qreal pixelRatio,
+                              bool isPrinting);
+    virtual void invalidateContent();
+
     virtual void onNotationSetup();
 
     virtual void onLoadNotation(INotationPtr notation);
@@ -247,6 +253,10 @@ private:
 
     void paintBackground(const RectF& rect, draw::Painter* painter);
 
+    void invalidateChangedTiles(bool invalidateAllIfNoLayout = true);
+    void invalidateSelectionTiles();
+    RectF selectionRect() const;
+
     PointF canvasCenter() const;
     std::pair<qreal, qreal> constraintCanvas(qreal dx, qreal dy) const;
 
@@ -274,6 +284,8 @@ private:
     bool m_isContextMenuOpen = false;
 
     RectF m_shadowNoteRect;
+
+    NotationTileCache m_tileCache;
 };
 }
 
@@ -0,0 +1,246 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "navigatorthumbnailcache.h"
+
+#include <cmath>
+#include <set>
+#include <tuple>
+
+#include <QPainter>
+
+#include "async/async.h"
+#include "concurrency/taskscheduler.h"
+#include "runtime.h"
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
+#include "engraving/dom/page.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::draw;
+
+//! NOTE A thread of its own, rasterizing must neither wait behind nor delay the audio and layout pools
+static TaskScheduler* thumbnailScheduler()
+{
+    static TaskScheduler s(1);
+    return &s;
+}
+
+static QImage rasterize(const DrawDataPtr& data, const QSize& size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter qp(&image);
+    Painter painter(&qp, "NavigatorThumbnail");
+    DrawDataPaint::paint(&painter, data);
+    painter.endDraw();
+
+    return image;
+}
+
+//! NOTE Pixmaps are painted through QPixmap, which may only be used on the main thread
+static bool hasPixmaps(const DrawData::Item& item)
+{
+    for (const DrawData::Data& d : item.datas) {
+        if (!d.pixmaps.empty()) {
+            return true;
+        }
+    }
+
+    for (const DrawData::Item& ch : item.chilren) {
+        if (hasPixmaps(ch)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool NavigatorThumbnailCache::Key::operator<(const Key& other) const
+{
+    return std::tie(page, strip) < std::tie(other.page, other.strip);
+}
+
+NavigatorThumbnailCache::NavigatorThumbnailCache()
+    : m_shared(std::make_shared<Shared>())
+{
+    m_shared->cache = this;
+}
+
+NavigatorThumbnailCache::~NavigatorThumbnailCache()
+{
+    m_shared->cache = nullptr;
+}
+
+void NavigatorThumbnailCache::setOnThumbnailRendered(const std::function<void()>& func)
+{
+    m_onThumbnailRendered = func;
+}
+
+void NavigatorThumbnailCache::paint(QPainter* painter, const PageList& pages, const RectF& frameRect, const Transform& viewMatrix,
+                                    qreal pixelRatio, const RecordFunc& record)
+{
+    TRACEFUNC;
+
+    const qreal scaling = viewMatrix.m11() * pixelRatio;
+    if (scaling <= 0.0) {
+        return;
+    }
+
+    std::set<const Page*> alivePages(pages.begin(), pages.end());
+    for (auto it = m_thumbnails.begin(); it != m_thumbnails.end();) {
+        if (alivePages.find(it->first.page) == alivePages.end()) {
+            it = m_thumbnails.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const Page* page : pages) {
+        const std::vector<RectF> pageStrips = strips(page->canvasBoundingRect(), scaling);
+
+        for (size_t i = 0; i < pageStrips.size(); ++i) {
+            const RectF& rect = pageStrips.at(i);
+            if (!rect.intersects(frameRect)) {
+                continue;
+            }
+
+            Key key { page, i };
+            Thumbnail& thumbnail = m_thumbnails[key];
+
+            bool upToDate = !thumbnail.image.isNull()
+                            && thumbnail.layoutGeneration == page->layoutGeneration()
+                            && thumbnail.scaling == scaling
+                            && thumbnail.rect == rect;
+
+            // at most one request per strip, an outdated result asks again
+            if (!upToDate && !thumbnail.isPending) {
+                requestRender(key, rect, page->layoutGeneration(), scaling, record);
+            }
+
+            if (!thumbnail.image.isNull()) {
+                painter->drawImage(viewMatrix.map(thumbnail.rect).toQRectF(), thumbnail.image);
+            }
+        }
+    }
+}
+
+void NavigatorThumbnailCache::invalidate()
+{
+    // the pending requests still come back, but are not taken anymore
+    ++m_epoch;
+
+    for (auto& p : m_thumbnails) {
+        p.second.layoutGeneration = 0;
+    }
+}
+
+std::vector<RectF> NavigatorThumbnailCache::strips(const RectF& pageRect, qreal scaling) const
+{
+    const bool horizontal = pageRect.width() >= pageRect.height();
+    const qreal length = horizontal ? pageRect.width() : pageRect.height();
+    const size_t count = std::max(static_cast<size_t>(std::ceil(length * scaling / MAX_STRIP_PIXELS)), size_t(1));
+    const qreal stripLength = length / count;
+
+    std::vector<RectF> result;
+    result.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (horizontal) {
+            result.emplace_back(pageRect.x() + i * stripLength, pageRect.y(), stripLength, pageRect.height());
+        } else {
+            result.emplace_back(pageRect.x(), pageRect.y() + i * stripLength, pageRect.width(), stripLength);
+        }
+    }
+
+    return result;
+}
+
+void NavigatorThumbnailCache::requestRender(const Key& key, const RectF& rect, uint64_t layoutGeneration, qreal scaling,
+                                            const RecordFunc& record)
+{
+    TRACEFUNC;
+
+    // the score may only be read on the main thread, the recorded draw data is independent of it
+    std::shared_ptr<BufferedPaintProvider> provider = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter painter(provider, "NavigatorThumbnail");
+        painter.setWorldTransform(Transform(scaling, 0.0, 0.0, scaling, -rect.x() * scaling, -rect.y() * scaling));
+        record(&painter, rect);
+        painter.endDraw();
+    }
+
+    DrawDataPtr data = provider->drawData();
+    QSize size(std::max(static_cast<int>(std::ceil(rect.width() * scaling)), 1),
+               std::max(static_cast<int>(std::ceil(rect.height() * scaling)), 1));
+
+    if (hasPixmaps(data->item)) {
+        Thumbnail& thumbnail = m_thumbnails[key];
+        thumbnail.image = rasterize(data, size);
+        thumbnail.rect = rect;
+        thumbnail.layoutGeneration = layoutGeneration;
+        thumbnail.scaling = scaling;
+        return;
+    }
+
+    m_thumbnails[key].isPending = true;
+
+    std::shared_ptr<Shared> shared = m_shared;
+    uint64_t epoch = m_epoch;
+    thumbnailScheduler()->push([shared, epoch, key, rect, layoutGeneration, scaling, data, size]() {
+        QImage image = rasterize(data, size);
+
+        async::Async::call(nullptr, [shared, epoch, key, rect, layoutGeneration, scaling, image]() {
+            if (shared->cache) {
+                shared->cache->onRendered(epoch, key, rect, layoutGeneration, scaling, image);
+            }
+        }, runtime::mainThreadId());
+    });
+}
+
+void NavigatorThumbnailCache::onRendered(uint64_t epoch, const Key& key, const RectF& rect, uint64_t layoutGeneration, qreal scaling,
+                                         const QImage& image)
+{
+    auto it = m_thumbnails.find(key);
+    if (it == m_thumbnails.end()) {
+        return;
+    }
+
+    Thumbnail& thumbnail = it->second;
+    thumbnail.isPending = false;
+
+    if (epoch == m_epoch) {
+        thumbnail.image = image;
+        thumbnail.rect = rect;
+        thumbnail.layoutGeneration = layoutGeneration;
+        thumbnail.scaling = scaling;
+    }
+
+    if (m_onThumbnailRendered) {
+        m_onThumbnailRendered();
+    }
+}
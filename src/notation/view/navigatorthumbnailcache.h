@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NAVIGATORTHUMBNAILCACHE_H
+#define MU_NOTATION_NAVIGATORTHUMBNAILCACHE_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QImage>
+
+#include "draw/painter.h"
+#include "draw/types/geometry.h"
+#include "draw/types/transform.h"
+
+#include "notation/notationtypes.h"
+
+class QPainter;
+
+namespace mu::notation {
+//---------------------------------------------------------
+//   NavigatorThumbnailCache
+//    Bitmaps of the pages at the navigator resolution.
+//    A page is recorded on the main thread and rasterized
+//    on a thread of its own, again only after the page has
+//    been laid out again or the navigator was resized.
+//    Until then the old bitmap is shown.
+//    Pages longer than MAX_STRIP_PIXELS, like the single
+//    page of the continuous view, are split into strips.
+//---------------------------------------------------------
+
+class NavigatorThumbnailCache
+{
+public:
+    NavigatorThumbnailCache();
+    ~NavigatorThumbnailCache();
+
+    //! NOTE Paints the score content of the given logical rect, called on the main thread
+    using RecordFunc = std::function<void (draw::Painter* painter, const RectF& frameRect)>;
+
+    void setOnThumbnailRendered(const std::function<void()>& func);
+
+    //! NOTE viewMatrix maps logical coordinates to the painter coordinates,
+    //! pixelRatio is the number of device pixels per painter unit
+    void paint(QPainter* painter, const PageList& pages, const RectF& frameRect, const draw::Transform& viewMatrix, qreal pixelRatio,
+               const RecordFunc& record);
+
+    void invalidate();
+
+private:
+    static constexpr qreal MAX_STRIP_PIXELS = 2048.0;
+
+    struct Key {
+        const Page* page = nullptr;
+        size_t strip = 0;
+
+        bool operator<(const Key& other) const;
+    };
+
+    struct Thumbnail {
+        QImage image;
+        RectF rect;
+        uint64_t layoutGeneration = 0;
+        qreal scaling = 0.0;
+        bool isPending = false;
+    };
+
+    //! NOTE Outlives the cache in the rasterizing tasks, only accessed on the main thread
+    struct Shared {
+        NavigatorThumbnailCache* cache = nullptr;
+    };
+
+    std::vector<RectF> strips(const RectF& pageRect, qreal scaling) const;
+
+    void requestRender(const Key& key, const RectF& rect, uint64_t layoutGeneration, qreal scaling, const RecordFunc& record);
+    void onRendered(uint64_t epoch, const Key& key, const RectF& rect, uint64_t layoutGeneration, qreal scaling, const QImage& image);
+
+    std::map<Key, Thumbnail> m_thumbnails;
+    uint64_t m_epoch = 0;
+    std::shared_ptr<Shared> m_shared;
+    std::function<void()> m_onThumbnailRendered;
+};
+}
+
+#endif // MU_NOTATION_NAVIGATORTHUMBNAILCACHE_H
@@ -63,10 +63,15 @@ void NotationNavigator::load()
     initVisible();
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        invalidateContent();
         update();
         m_cursorRectView->update();
     });
 
+    m_thumbnails.setOnThumbnailRendered([this]() {
+        update();
+    });
+
     AbstractNotationPaintView::load();
 }
 
@@ -269,6 +274,24 @@ void NotationNavigator::paint(QPainter* painter)
     paintPageNumbers(painter);
 }
 
+//! NOTE The pages are painted from the thumbnails, so that moving the viewport
+//! or the navigator does not paint the whole score again
+void NotationNavigator::paintContent(QPainter* painter, const RectF& frameRect, const mu::draw::Transform& viewMatrix, qreal pixelRatio,
+                                     bool isPrinting)
+{
+    INotationPaintingPtr painting = notation()->painting();
+    m_thumbnails.paint(painter, pages(), frameRect, viewMatrix, pixelRatio,
+                       [painting, isPrinting](mu::draw::Painter* thumbnailPainter, const RectF& rect) {
+        painting->paintViewContent(thumbnailPainter, rect, isPrinting);
+    });
+}
+
+void NotationNavigator::invalidateContent()
+{
+    AbstractNotationPaintView::invalidateContent();
+    m_thumbnails.invalidate();
+}
+
 void NotationNavigator::onViewSizeChanged()
 {
 }
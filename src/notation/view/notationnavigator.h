@@ -35,6 +35,7 @@
 #include "ui/iuiconfiguration.h"
 #include "engraving/iengravingconfiguration.h"
 #include "abstractnotationpaintview.h"
+#include "navigatorthumbnailcache.h"
 
 namespace mu::notation {
 class NotationNavigatorCursorView : public QQuickPaintedItem
@@ -88,6 +89,9 @@ private:
     void rescale();
 
     void paint(QPainter* painter) override;
+    void paintContent(QPainter* painter, const RectF& frameRect, const draw::Transform& viewMatrix, qreal pixelRatio,
+                      bool isPrinting) override;
+    void invalidateContent() override;
     void onViewSizeChanged() override;
 
     void wheelEvent(QWheelEvent* event) override;
@@ -105,6 +109,8 @@ private:
     RectF m_cursorRect;
     NotationNavigatorCursorView* m_cursorRectView = nullptr;
     PointF m_startMove;
+
+    NavigatorThumbnailCache m_thumbnails;
 };
 }
 
@@ -0,0 +1,228 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtilecache.h"
+
+#include <cmath>
+#include <tuple>
+
+#include <QPainter>
+
+#include "engraving/dom/page.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::draw;
+
+static constexpr size_t TILE_BYTES = 4; // Format_ARGB32_Premultiplied
+
+//! NOTE Antialiasing draws a little outside of the items' bounding rects
+static constexpr qreal INVALIDATE_MARGIN_PIXELS = 2.0;
+
+NotationTileCache::NotationTileCache(size_t maxMemory)
+    : m_maxMemory(maxMemory)
+{
+}
+
+bool NotationTileCache::TileKey::operator<(const TileKey& other) const
+{
+    return std::tie(scaling, pixelRatio, isPrinting, row, col)
+           < std::tie(other.scaling, other.pixelRatio, other.isPrinting, other.row, other.col);
+}
+
+void NotationTileCache::paint(QPainter* painter, const RectF& frameRect, const Transform& viewMatrix, qreal pixelRatio, bool isPrinting,
+                              const RenderFunc& render)
+{
+    TRACEFUNC;
+
+    const qreal scaling = viewMatrix.m11() * pixelRatio;
+    if (frameRect.isEmpty() || scaling <= 0.0) {
+        return;
+    }
+
+    // the tiles are blitted at whole device pixels,
+    // so the content may be off by less than a pixel, but there are no seams between them
+    const qreal offsetX = std::round(viewMatrix.dx() * pixelRatio);
+    const qreal offsetY = std::round(viewMatrix.dy() * pixelRatio);
+
+    const int firstCol = static_cast<int>(std::floor((frameRect.left() * scaling - 1.0) / TILE_SIZE));
+    const int lastCol = static_cast<int>(std::floor((frameRect.right() * scaling + 1.0) / TILE_SIZE));
+    const int firstRow = static_cast<int>(std::floor((frameRect.top() * scaling - 1.0) / TILE_SIZE));
+    const int lastRow = static_cast<int>(std::floor((frameRect.bottom() * scaling + 1.0) / TILE_SIZE));
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int col = firstCol; col <= lastCol; ++col) {
+            TileKey key { scaling, pixelRatio, isPrinting, col, row };
+
+            auto it = m_tiles.find(key);
+            if (it == m_tiles.end()) {
+                it = m_tiles.emplace(key, Tile { renderTile(key, painter, render), 0 }).first;
+            }
+
+            it->second.lastUsed = ++m_useCounter;
+
+            QPointF pos((col * TILE_SIZE + offsetX) / pixelRatio, (row * TILE_SIZE + offsetY) / pixelRatio);
+            painter->drawImage(pos, it->second.image);
+        }
+    }
+
+    removeLeastRecentlyUsed();
+}
+
+QImage NotationTileCache::renderTile(const TileKey& key, const QPainter* target, const RenderFunc& render) const
+{
+    TRACEFUNC;
+
+    QImage image(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    {
+        QPainter qp(&image);
+        qp.setRenderHints(target->renderHints());
+
+        Painter painter(&qp, "NotationTile");
+        painter.setWorldTransform(Transform(key.scaling, 0.0, 0.0, key.scaling, -key.col * TILE_SIZE, -key.row * TILE_SIZE));
+
+        render(&painter, tileLogicalRect(key));
+    }
+
+    // blitted at its logical size, that is one image pixel to one device pixel
+    image.setDevicePixelRatio(key.pixelRatio);
+
+    return image;
+}
+
+RectF NotationTileCache::tileLogicalRect(const TileKey& key) const
+{
+    const qreal size = TILE_SIZE / key.scaling;
+    return RectF(key.col * size, key.row * size, size, size);
+}
+
+void NotationTileCache::removeLeastRecentlyUsed()
+{
+    while (memoryUsage() > m_maxMemory && !m_tiles.empty()) {
+        auto oldest = m_tiles.begin();
+        for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+            if (it->second.lastUsed < oldest->second.lastUsed) {
+                oldest = it;
+            }
+        }
+
+        m_tiles.erase(oldest);
+    }
+}
+
+void NotationTileCache::invalidate()
+{
+    m_tiles.clear();
+    m_pages.clear();
+}
+
+void NotationTileCache::invalidate(const RectF& logicalRect)
+{
+    if (logicalRect.isEmpty()) {
+        return;
+    }
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        const qreal margin = INVALIDATE_MARGIN_PIXELS / it->first.scaling;
+        if (logicalRect.adjusted(-margin, -margin, margin, margin).intersects(tileLogicalRect(it->first))) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool NotationTileCache::invalidateChangedPages(const std::vector<engraving::Page*>& pages)
+{
+    TRACEFUNC;
+
+    bool changed = false;
+
+    std::unordered_map<const engraving::Page*, PageState> states;
+    states.reserve(pages.size());
+
+    for (const engraving::Page* page : pages) {
+        PageState state { page->layoutGeneration(), page->canvasBoundingRect() };
+
+        auto it = m_pages.find(page);
+        if (it == m_pages.end()) {
+            invalidate(state.rect);
+            changed = true;
+        } else {
+            if (it->second.layoutGeneration != state.layoutGeneration || it->second.rect != state.rect) {
+                invalidate(it->second.rect);
+                invalidate(state.rect);
+                changed = true;
+            }
+
+            m_pages.erase(it);
+        }
+
+        states.emplace(page, state);
+    }
+
+    // removed pages
+    for (const auto& p : m_pages) {
+        invalidate(p.second.rect);
+        changed = true;
+    }
+
+    m_pages = std::move(states);
+
+    return changed;
+}
+
+void NotationTileCache::invalidateSelection(const RectF& selectionRect)
+{
+    invalidate(m_selectionRect);
+    invalidate(selectionRect);
+
+    m_selectionRect = selectionRect;
+}
+
+void NotationTileCache::setSelectionRect(const RectF& selectionRect)
+{
+    m_selectionRect = selectionRect;
+}
+
+const RectF& NotationTileCache::selectionRect() const
+{
+    return m_selectionRect;
+}
+
+size_t NotationTileCache::tilesCount() const
+{
+    return m_tiles.size();
+}
+
+size_t NotationTileCache::memoryUsage() const
+{
+    return m_tiles.size() * TILE_SIZE * TILE_SIZE * TILE_BYTES;
+}
+
+size_t NotationTileCache::maxMemory() const
+{
+    return m_maxMemory;
+}
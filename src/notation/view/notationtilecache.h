@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <QImage>
+
+#include "draw/painter.h"
+#include "draw/types/geometry.h"
+#include "draw/types/transform.h"
+
+class QPainter;
+
+namespace mu::engraving {
+class Page;
+}
+
+namespace mu::notation {
+//---------------------------------------------------------
+//   NotationTileCache
+//    Raster tiles of the painted score content, on a grid
+//    anchored at the canvas origin and keyed by the zoom,
+//    so that scrolling and repainting whatever is drawn on
+//    top of the score (cursors, loop markers, edit grips...)
+//    only blits them. Tiles are rendered when they come
+//    into view and dropped when the content under them
+//    changes or when they exceed the memory budget.
+//---------------------------------------------------------
+
+class NotationTileCache
+{
+public:
+    //! NOTE In bytes of tile images
+    static constexpr size_t DEFAULT_MAX_MEMORY = 128 * 1024 * 1024;
+
+    explicit NotationTileCache(size_t maxMemory = DEFAULT_MAX_MEMORY);
+
+    //! NOTE Paints the score content of the given logical rect
+    using RenderFunc = std::function<void (draw::Painter* painter, const RectF& frameRect)>;
+
+    //! NOTE viewMatrix maps logical coordinates to the painter coordinates,
+    //! pixelRatio is the number of device pixels per painter unit
+    void paint(QPainter* painter, const RectF& frameRect, const draw::Transform& viewMatrix, qreal pixelRatio, bool isPrinting,
+               const RenderFunc& render);
+
+    void invalidate();
+    void invalidate(const RectF& logicalRect);
+
+    //! NOTE Invalidates the tiles of the pages laid out again, added, moved or removed
+    //! since the last call, returns whether there were any
+    bool invalidateChangedPages(const std::vector<engraving::Page*>& pages);
+
+    //! NOTE Selected items are painted in the selection color by the score itself,
+    //! so the tiles under both the previous and the new selection are invalidated
+    void invalidateSelection(const RectF& selectionRect);
+    //! NOTE Only remembers the rect, e.g. when the selected items were laid out again
+    void setSelectionRect(const RectF& selectionRect);
+    const RectF& selectionRect() const;
+
+    size_t tilesCount() const;
+    size_t memoryUsage() const;
+    size_t maxMemory() const;
+
+private:
+    //! NOTE In device pixels
+    static constexpr int TILE_SIZE = 256;
+
+    struct TileKey {
+        qreal scaling = 0.0;        // device pixels per logical unit
+        qreal pixelRatio = 1.0;     // device pixels per painter unit
+        bool isPrinting = false;
+        int col = 0;
+        int row = 0;
+
+        bool operator<(const TileKey& other) const;
+    };
+
+    struct Tile {
+        QImage image;
+        uint64_t lastUsed = 0;
+    };
+
+    struct PageState {
+        uint64_t layoutGeneration = 0;
+        RectF rect;
+    };
+
+    RectF tileLogicalRect(const TileKey& key) const;
+    QImage renderTile(const TileKey& key, const QPainter* target, const RenderFunc& render) const;
+    void removeLeastRecentlyUsed();
+
+    size_t m_maxMemory = DEFAULT_MAX_MEMORY;
+
+    std::map<TileKey, Tile> m_tiles;
+    uint64_t m_useCounter = 0;
+
+    std::unordered_map<const engraving::Page*, PageState> m_pages;
+    RectF m_selectionRect;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
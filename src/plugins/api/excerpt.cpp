@@ -31,6 +31,10 @@ namespace mu::plugins::api {
 
 Score* Excerpt::partScore()
 {
+    // plugins may query the layout of parts that are not open
+    if (e->excerptScore()) {
+        e->excerptScore()->layoutIfNeeded();
+    }
     return wrap<Score>(e->excerptScore(), Ownership::SCORE);
 }
 
@@ -24,6 +24,8 @@
 #include <QPrinter>
 #include <QPrintDialog>
 
+#include "engraving/dom/score.h"
+
 #include "log.h"
 
 using namespace mu;
@@ -37,6 +39,8 @@ Ret PrintProvider::printNotation(INotationPtr notation)
         return make_ret(Ret::Code::InternalError);
     }
 
+    notation->elements()->msScore()->finishLayout();
+
     auto painting = notation->painting();
 
     SizeF pageSizeInch = painting->pageSizeInch();
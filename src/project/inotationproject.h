@@ -44,8 +44,11 @@ public:
     virtual QString displayName() const = 0;
     virtual async::Notification displayNameChanged() const = 0;
 
+    //! NOTE progressiveLayout is for projects opened in the notation view: only the first pages
+    //! are laid out, the view lays out the rest (see engraving::Score::setProgressiveLayout)
     virtual Ret load(const io::path_t& path,
-                     const io::path_t& stylePath = io::path_t(), bool forceMode = false, const std::string& format = "") = 0;
+                     const io::path_t& stylePath = io::path_t(), bool forceMode = false, const std::string& format = "",
+                     bool progressiveLayout = false) = 0;
     virtual Ret createNew(const ProjectCreateOptions& projectInfo) = 0;
 
     virtual bool isCloudProject() const = 0;
@@ -23,6 +23,10 @@
 #ifndef MU_PROJECT_INOTATIONWRITER_H
 #define MU_PROJECT_INOTATIONWRITER_H
 
+#include <functional>
+
+#include <QByteArray>
+
 #include "types/ret.h"
 #include "types/val.h"
 
@@ -58,6 +62,15 @@ public:
     virtual Ret write(notation::INotationPtr notation, QIODevice& device, const Options& options = Options()) = 0;
     virtual Ret writeList(const notation::INotationPtrList& notations, QIODevice& device, const Options& options = Options()) = 0;
 
+    //! NOTE Writes every page of the notation, for the PER_PAGE unit type.
+    //! The data of the pages is passed to onPageWritten in page order and on the calling thread,
+    //! though a writer may render the pages concurrently
+    using PageWritten = std::function<Ret (size_t pageIndex, const QByteArray& data)>;
+    virtual Ret writePages(notation::INotationPtr, const PageWritten&, const Options& = Options())
+    {
+        return Ret(Ret::Code::NotSupported);
+    }
+
     virtual framework::Progress* progress() { return nullptr; }
     virtual void abort() {}
 };
@@ -128,12 +128,9 @@ bool ExportProjectScenario::exportScores(const notation::INotationPtrList& notat
 
     masterNotation()->initExcerpts(excerptsToInit);
 
-    // Scores that are closed may have never been laid out, so we lay them out now
+    // Scores that are closed may have changed or never been laid out, so we lay them out now
     for (INotationPtr notation : notations) {
-        mu::engraving::Score* score = notation->elements()->msScore();
-        if (!score->autoLayoutEnabled()) {
-            score->doLayout();
-        }
+        notation->elements()->msScore()->finishLayout();
     }
 
     // Backup view modes
@@ -52,6 +52,9 @@ using namespace mu::engraving;
 using namespace mu::notation;
 using namespace mu::project;
 
+//! NOTE The pages that come into view later are laid out by NotationPainting
+static constexpr size_t PROGRESSIVE_LAYOUT_FIRST_PAGES = 2;
+
 static void setupScoreMetaTags(mu::engraving::MasterScore* masterScore, const ProjectCreateOptions& projectOptions)
 {
     if (!projectOptions.title.isEmpty()) {
@@ -93,7 +96,8 @@ void NotationProject::setupProject()
     m_projectAudioSettings = std::shared_ptr<ProjectAudioSettings>(new ProjectAudioSettings());
 }
 
-mu::Ret NotationProject::load(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format_)
+mu::Ret NotationProject::load(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format_,
+                              bool progressiveLayout)
 {
     TRACEFUNC;
 
@@ -113,7 +117,7 @@ mu::Ret NotationProject::load(const io::path_t& path, const io::path_t& stylePat
         return ret;
     }
 
-    Ret ret = doLoad(path, stylePath, forceMode, format);
+    Ret ret = doLoad(path, stylePath, forceMode, format, progressiveLayout);
     if (!ret) {
         LOGE() << "failed load, err: " << ret.toString();
         return ret;
@@ -130,7 +134,8 @@ mu::Ret NotationProject::load(const io::path_t& path, const io::path_t& stylePat
     return ret;
 }
 
-mu::Ret NotationProject::doLoad(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format)
+mu::Ret NotationProject::doLoad(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format,
+                                bool progressiveLayout)
 {
     TRACEFUNC;
 
@@ -188,6 +193,10 @@ mu::Ret NotationProject::doLoad(const io::path_t& path, const io::path_t& styleP
     }
 
     masterScore->lockUpdates(false);
+    if (progressiveLayout) {
+        // lay out the first pages only, the rest of the score is laid out in the background
+        masterScore->setProgressiveLayout(PROGRESSIVE_LAYOUT_FIRST_PAGES);
+    }
     masterScore->setLayoutAll();
     masterScore->update();
 
@@ -685,6 +694,14 @@ mu::Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection,
 {
     TRACEFUNC;
 
+    // the thumbnail and the layout dependent parts of the file need the complete layout,
+    // parts that changed while not open are saved without laying them out again
+    for (Score* score : m_engravingProject->masterScore()->scoreList()) {
+        if (!score->needsLayout()) {
+            score->finishLayout();
+        }
+    }
+
     // Create MsczWriter
     Ret ret = msczWriter.open();
     if (!ret) {
@@ -766,6 +783,8 @@ mu::Ret NotationProject::exportProject(const io::path_t& path, const std::string
         return false;
     }
 
+    m_masterNotation->masterScore()->finishLayout();
+
     Ret ret = writer->write(m_masterNotation->notation(), file);
     file.close();
 
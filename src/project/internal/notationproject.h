@@ -59,7 +59,7 @@ public:
     ~NotationProject() override;
 
     Ret load(const io::path_t& path, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
-             const std::string& format = "") override;
+             const std::string& format = "", bool progressiveLayout = false) override;
     Ret createNew(const ProjectCreateOptions& projectInfo) override;
 
     io::path_t path() const override;
@@ -103,7 +103,7 @@ private:
 
     Ret loadTemplate(const ProjectCreateOptions& projectOptions);
 
-    Ret doLoad(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format);
+    Ret doLoad(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format, bool progressiveLayout);
     Ret doImport(const io::path_t& path, const io::path_t& stylePath, bool forceMode);
 
     Ret saveScore(const io::path_t& path, const std::string& fileSuffix, bool generateBackup = true, bool createThumbnail = true);
@@ -269,7 +269,7 @@ RetVal<INotationProjectPtr> ProjectActionsController::loadProject(const io::path
     io::path_t loadPath = hasUnsavedChanges ? projectAutoSaver()->projectAutoSavePath(filePath) : filePath;
     std::string format = io::suffix(filePath);
 
-    Ret ret = project->load(loadPath, "" /*stylePath*/, false /*forceMode*/, format);
+    Ret ret = project->load(loadPath, "" /*stylePath*/, false /*forceMode*/, format, true /*progressiveLayout*/);
 
     if (!ret) {
         if (ret.code() == static_cast<int>(Ret::Code::Cancel)) {
@@ -277,7 +277,7 @@ RetVal<INotationProjectPtr> ProjectActionsController::loadProject(const io::path
         }
 
         if (checkCanIgnoreError(ret, loadPath)) {
-            ret = project->load(loadPath, "" /*stylePath*/, true /*forceMode*/, format);
+            ret = project->load(loadPath, "" /*stylePath*/, true /*forceMode*/, format, true /*progressiveLayout*/);
         }
 
         if (!ret) {